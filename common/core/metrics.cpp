@@ -0,0 +1,534 @@
+/**
+ * @file metrics.cpp
+ * @brief 运行指标实现文件
+ */
+
+#include "metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace CloudFlow {
+namespace Common {
+
+namespace {
+
+/**
+ * @brief 当前线程的分片下标（线程首次更新指标时轮流分配）
+ */
+size_t shardIndex() {
+    static std::atomic<size_t> next_shard(0);
+    thread_local size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+    return index;
+}
+
+void addDouble(std::atomic<double>& target, double delta) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+    }
+}
+
+std::string formatValue(double value) {
+    if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    if (std::isnan(value)) return "NaN";
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    return buffer;
+}
+
+std::string escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string formatLabels(const MetricLabels& labels, const std::string& extra_name = "",
+                         const std::string& extra_value = "") {
+    if (labels.empty() && extra_name.empty()) return "";
+
+    std::string text = "{";
+    bool first = true;
+    for (const auto& label : labels) {
+        if (!first) text += ",";
+        text += label.first + "=\"" + escapeLabelValue(label.second) + "\"";
+        first = false;
+    }
+    if (!extra_name.empty()) {
+        if (!first) text += ",";
+        text += extra_name + "=\"" + extra_value + "\"";
+    }
+    return text + "}";
+}
+
+} // namespace
+
+// Counter 实现
+Counter::Counter() {
+    for (auto& shard : shards_) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Counter::increment(uint64_t delta) {
+    shards_[shardIndex()].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Gauge 实现
+Gauge::Gauge() : value_(0) {}
+
+void Gauge::set(int64_t value) {
+    value_.store(value, std::memory_order_relaxed);
+}
+
+void Gauge::add(int64_t delta) {
+    value_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+int64_t Gauge::value() const {
+    return value_.load(std::memory_order_relaxed);
+}
+
+// Histogram 实现
+Histogram::Histogram(std::vector<double> upper_bounds) : upper_bounds_(std::move(upper_bounds)) {
+    std::sort(upper_bounds_.begin(), upper_bounds_.end());
+    upper_bounds_.erase(std::unique(upper_bounds_.begin(), upper_bounds_.end()), upper_bounds_.end());
+
+    for (auto& shard : shards_) {
+        shard.counts.reset(new std::atomic<uint64_t>[upper_bounds_.size() + 1]);
+        for (size_t i = 0; i <= upper_bounds_.size(); ++i) {
+            shard.counts[i].store(0, std::memory_order_relaxed);
+        }
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.sum.store(0.0, std::memory_order_relaxed);
+    }
+}
+
+Histogram::~Histogram() = default;
+
+void Histogram::observe(double value) {
+    size_t bucket = std::lower_bound(upper_bounds_.begin(), upper_bounds_.end(), value) - upper_bounds_.begin();
+    Shard& shard = shards_[shardIndex()];
+    shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    addDouble(shard.sum, value);
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.upper_bounds = upper_bounds_;
+    snapshot.bucket_counts.assign(upper_bounds_.size() + 1, 0);
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i <= upper_bounds_.size(); ++i) {
+            snapshot.bucket_counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+        }
+        snapshot.count += shard.count.load(std::memory_order_relaxed);
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+std::vector<double> Histogram::latencyBuckets() {
+    return {0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+            0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+}
+
+// MetricsRegistry 实现类
+class MetricsRegistry::Impl {
+public:
+    struct Entry {
+        std::string help;
+        MetricType type;
+        std::shared_ptr<Counter> counter;
+        std::shared_ptr<Gauge> gauge;
+        std::shared_ptr<Histogram> histogram;
+    };
+
+    using Key = std::pair<std::string, MetricLabels>;
+
+    Entry* find(const std::string& name, const MetricLabels& labels, MetricType type) {
+        auto it = metrics_.find(Key(name, labels));
+        if (it == metrics_.end() || it->second.type != type) return nullptr;
+        return &it->second;
+    }
+
+    Entry& insert(const std::string& name, const std::string& help, const MetricLabels& labels, MetricType type) {
+        Entry& entry = metrics_[Key(name, labels)];
+        entry.help = help;
+        entry.type = type;
+        return entry;
+    }
+
+    mutable std::mutex mutex_;
+    std::map<Key, Entry> metrics_;
+};
+
+MetricsRegistry::MetricsRegistry() : impl_(std::make_unique<Impl>()) {}
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<Counter> MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                                  const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (auto* entry = impl_->find(name, labels, MetricType::Counter)) {
+        return entry->counter;
+    }
+    Impl::Entry& entry = impl_->insert(name, help, labels, MetricType::Counter);
+    entry.counter = std::make_shared<Counter>();
+    return entry.counter;
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                                              const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (auto* entry = impl_->find(name, labels, MetricType::Gauge)) {
+        return entry->gauge;
+    }
+    Impl::Entry& entry = impl_->insert(name, help, labels, MetricType::Gauge);
+    entry.gauge = std::make_shared<Gauge>();
+    return entry.gauge;
+}
+
+std::shared_ptr<Histogram> MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                                      const std::vector<double>& upper_bounds,
+                                                      const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+    if (auto* entry = impl_->find(name, labels, MetricType::Histogram)) {
+        return entry->histogram;
+    }
+    Impl::Entry& entry = impl_->insert(name, help, labels, MetricType::Histogram);
+    entry.histogram = std::make_shared<Histogram>(upper_bounds.empty() ? Histogram::latencyBuckets() : upper_bounds);
+    return entry.histogram;
+}
+
+std::vector<MetricSnapshot> MetricsRegistry::snapshot() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex_);
+
+    std::vector<MetricSnapshot> snapshots;
+    snapshots.reserve(impl_->metrics_.size());
+    for (const auto& metric : impl_->metrics_) {
+        const Impl::Entry& entry = metric.second;
+
+        MetricSnapshot snapshot;
+        snapshot.name = metric.first.first;
+        snapshot.labels = metric.first.second;
+        snapshot.help = entry.help;
+        snapshot.type = entry.type;
+        switch (entry.type) {
+            case MetricType::Counter:
+                snapshot.value = static_cast<double>(entry.counter->value());
+                break;
+            case MetricType::Gauge:
+                snapshot.value = static_cast<double>(entry.gauge->value());
+                break;
+            case MetricType::Histogram:
+                snapshot.histogram = entry.histogram->snapshot();
+                snapshot.value = static_cast<double>(snapshot.histogram.count);
+                break;
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+    return snapshots;
+}
+
+std::string MetricsRegistry::exportPrometheus() const {
+    static const char* const kTypeNames[] = {"counter", "gauge", "histogram"};
+
+    std::ostringstream out;
+    std::string current_family;
+    for (const auto& metric : snapshot()) {
+        // 同名指标（不同标签）只输出一次HELP和TYPE
+        if (metric.name != current_family) {
+            current_family = metric.name;
+            out << "# HELP " << metric.name << " " << metric.help << "\n";
+            out << "# TYPE " << metric.name << " " << kTypeNames[static_cast<int>(metric.type)] << "\n";
+        }
+
+        if (metric.type != MetricType::Histogram) {
+            out << metric.name << formatLabels(metric.labels) << " " << formatValue(metric.value) << "\n";
+            continue;
+        }
+
+        const HistogramSnapshot& histogram = metric.histogram;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < histogram.bucket_counts.size(); ++i) {
+            cumulative += histogram.bucket_counts[i];
+            double bound = (i < histogram.upper_bounds.size()) ? histogram.upper_bounds[i] : INFINITY;
+            out << metric.name << "_bucket" << formatLabels(metric.labels, "le", formatValue(bound))
+                << " " << cumulative << "\n";
+        }
+        out << metric.name << "_sum" << formatLabels(metric.labels) << " " << formatValue(histogram.sum) << "\n";
+        out << metric.name << "_count" << formatLabels(metric.labels) << " " << histogram.count << "\n";
+    }
+    return out.str();
+}
+
+// MetricsExporter 实现类
+class MetricsExporter::Impl {
+public:
+    Impl(MetricsRegistry& registry, const std::string& socket_path)
+        : registry_(registry),
+          socket_path_(socket_path),
+          listen_fd_(-1),
+          bound_(false) {
+        wake_pipe_[0] = wake_pipe_[1] = -1;
+    }
+
+    ~Impl() {
+        stop();
+    }
+
+    bool start() {
+        if (thread_.joinable()) return true;
+
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socket_path_.empty() || socket_path_.size() >= sizeof(address.sun_path)) {
+            last_error_ = "套接字路径无效: " + socket_path_;
+            return false;
+        }
+        std::memcpy(address.sun_path, socket_path_.c_str(), socket_path_.size());
+
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) {
+            last_error_ = std::string("创建套接字失败: ") + std::strerror(errno);
+            return false;
+        }
+
+        // 只删除上次运行遗留的套接字文件，仍有进程监听时不抢占
+        if (!removeStaleSocket(address)) {
+            closeAll();
+            return false;
+        }
+        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            last_error_ = std::string("绑定套接字失败: ") + std::strerror(errno);
+            closeAll();
+            return false;
+        }
+        bound_ = true;
+        if (listen(listen_fd_, 8) < 0) {
+            last_error_ = std::string("监听套接字失败: ") + std::strerror(errno);
+            closeAll();
+            return false;
+        }
+
+        if (pipe2(wake_pipe_, O_CLOEXEC) < 0) {
+            last_error_ = std::string("创建管道失败: ") + std::strerror(errno);
+            closeAll();
+            return false;
+        }
+
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void stop() {
+        if (thread_.joinable()) {
+            char byte = 0;
+            ssize_t written = write(wake_pipe_[1], &byte, 1);
+            (void)written;
+            thread_.join();
+        }
+        closeAll();
+    }
+
+    std::string getLastError() const {
+        return last_error_;
+    }
+
+private:
+    /**
+     * @brief 处理已存在的套接字文件
+     *
+     * 连接被拒绝说明是遗留文件，可以删除；连接成功说明另一个实例正在监听
+     */
+    bool removeStaleSocket(const sockaddr_un& address) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe < 0) {
+            last_error_ = std::string("创建套接字失败: ") + std::strerror(errno);
+            return false;
+        }
+        int result = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        int error = errno;
+        close(probe);
+
+        if (result == 0) {
+            last_error_ = "套接字已被其他进程使用: " + socket_path_;
+            return false;
+        }
+        if (error == ENOENT) return true;
+        if (error == ECONNREFUSED) {
+            if (unlink(socket_path_.c_str()) < 0 && errno != ENOENT) {
+                last_error_ = std::string("删除遗留套接字失败: ") + std::strerror(errno);
+                return false;
+            }
+            return true;
+        }
+        last_error_ = std::string("检查套接字失败: ") + std::strerror(error);
+        return false;
+    }
+
+    void run() {
+        pollfd fds[2];
+        fds[0].fd = listen_fd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = wake_pipe_[0];
+        fds[1].events = POLLIN;
+
+        while (true) {
+            fds[0].revents = fds[1].revents = 0;
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (fds[1].revents) break;
+            if (!(fds[0].revents & POLLIN)) continue;
+
+            int client = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (client < 0) continue;
+            serve(client);
+            close(client);
+        }
+    }
+
+    /**
+     * @brief 等待客户端就绪
+     *
+     * 同时监听唤醒管道：stop()写入的字节不被读走，返回后run()的下一次poll也会看到
+     * @return 客户端就绪返回true；超时、出错或正在停止返回false
+     */
+    bool waitClient(int client, short events, std::chrono::steady_clock::time_point deadline) {
+        pollfd fds[2];
+        fds[0].fd = client;
+        fds[0].events = events;
+        fds[1].fd = wake_pipe_[0];
+        fds[1].events = POLLIN;
+
+        while (true) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return false;
+
+            fds[0].revents = fds[1].revents = 0;
+            int ready = poll(fds, 2, static_cast<int>(remaining));
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (ready == 0 || fds[1].revents) return false;
+            return (fds[0].revents & events) != 0;
+        }
+    }
+
+    void serve(int client) {
+        // 单个连接最多占用服务线程2秒，不读取响应的客户端到期后直接断开
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+        // 读取请求头（最多等待1秒），内容不做解析
+        char request[1024];
+        auto read_deadline = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+        if (waitClient(client, POLLIN, read_deadline)) {
+            ssize_t received = recv(client, request, sizeof(request), 0);
+            (void)received;
+        }
+
+        std::string body = registry_.exportPrometheus();
+        std::string response = "HTTP/1.0 200 OK\r\n"
+                               "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                               "Connection: close\r\n\r\n" + body;
+
+        size_t offset = 0;
+        while (offset < response.size()) {
+            ssize_t sent = send(client, response.data() + offset, response.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                if ((errno == EAGAIN || errno == EWOULDBLOCK) && waitClient(client, POLLOUT, deadline)) continue;
+                break;
+            }
+            if (sent == 0) break;
+            offset += static_cast<size_t>(sent);
+        }
+    }
+
+    void closeAll() {
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        // 只删除本实例创建的套接字文件
+        if (bound_) {
+            unlink(socket_path_.c_str());
+            bound_ = false;
+        }
+        for (int& fd : wake_pipe_) {
+            if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    MetricsRegistry& registry_;
+    std::string socket_path_;
+    int listen_fd_;
+    bool bound_;
+    int wake_pipe_[2];
+    std::thread thread_;
+    std::string last_error_;
+};
+
+// MetricsExporter 实现
+MetricsExporter::MetricsExporter(MetricsRegistry& registry, const std::string& socket_path)
+    : impl_(std::make_unique<Impl>(registry, socket_path)) {}
+
+MetricsExporter::~MetricsExporter() = default;
+
+bool MetricsExporter::start() {
+    return impl_->start();
+}
+
+void MetricsExporter::stop() {
+    impl_->stop();
+}
+
+std::string MetricsExporter::getLastError() const {
+    return impl_->getLastError();
+}
+
+} // namespace Common
+} // namespace CloudFlow
@@ -0,0 +1,314 @@
+/**
+ * @file metrics.h
+ * @brief 运行指标头文件
+ *
+ * 提供计数器、仪表和延迟直方图。计数器与直方图按线程分片，
+ * 更新只做一次relaxed原子操作，读取时汇总各分片；
+ * 注册表支持快照读取，并可通过本地Unix套接字导出Prometheus文本格式
+ */
+
+#ifndef CLOUDFLOW_METRICS_H
+#define CLOUDFLOW_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Common {
+
+/**
+ * @brief 分片数量（同一分片只在线程数超过分片数时才会被共享）
+ */
+constexpr size_t kMetricShards = 16;
+
+/**
+ * @brief 指标标签（名称到值）
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+/**
+ * @enum MetricType
+ * @brief 指标类型
+ */
+enum class MetricType {
+    Counter,        ///< 单调递增计数器
+    Gauge,          ///< 仪表（可增可减的当前值）
+    Histogram       ///< 直方图
+};
+
+/**
+ * @class Counter
+ * @brief 单调递增计数器
+ */
+class Counter {
+public:
+    Counter();
+
+    // 禁用拷贝和赋值
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    /**
+     * @brief 增加计数
+     * @param delta 增量
+     */
+    void increment(uint64_t delta = 1);
+
+    /**
+     * @brief 获取当前值（汇总所有分片）
+     * @return 计数值
+     */
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value;
+    };
+    Shard shards_[kMetricShards];
+};
+
+/**
+ * @class Gauge
+ * @brief 仪表
+ */
+class Gauge {
+public:
+    Gauge();
+
+    // 禁用拷贝和赋值
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    /**
+     * @brief 设置当前值
+     * @param value 当前值
+     */
+    void set(int64_t value);
+
+    /**
+     * @brief 增加（或减少）当前值
+     * @param delta 增量
+     */
+    void add(int64_t delta);
+
+    /**
+     * @brief 获取当前值
+     * @return 当前值
+     */
+    int64_t value() const;
+
+private:
+    std::atomic<int64_t> value_;
+};
+
+/**
+ * @struct HistogramSnapshot
+ * @brief 直方图快照
+ */
+struct HistogramSnapshot {
+    std::vector<double> upper_bounds;     ///< 桶上界（不含+Inf）
+    std::vector<uint64_t> bucket_counts;  ///< 各桶计数（非累计，最后一项为+Inf桶）
+    uint64_t count;                       ///< 样本总数
+    double sum;                           ///< 样本总和
+
+    HistogramSnapshot() : count(0), sum(0.0) {}
+};
+
+/**
+ * @class Histogram
+ * @brief 直方图（用于延迟等分布统计）
+ */
+class Histogram {
+public:
+    /**
+     * @brief 构造函数
+     * @param upper_bounds 桶上界（升序）
+     */
+    explicit Histogram(std::vector<double> upper_bounds);
+    ~Histogram();
+
+    // 禁用拷贝和赋值
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * @brief 记录一个样本
+     * @param value 样本值
+     */
+    void observe(double value);
+
+    /**
+     * @brief 记录一段持续时间（以秒为单位）
+     * @param duration 持续时间
+     */
+    template <typename Rep, typename Period>
+    void observeDuration(std::chrono::duration<Rep, Period> duration) {
+        observe(std::chrono::duration<double>(duration).count());
+    }
+
+    /**
+     * @brief 获取快照（汇总所有分片）
+     * @return 直方图快照
+     */
+    HistogramSnapshot snapshot() const;
+
+    /**
+     * @brief 默认的延迟桶上界（秒，50微秒到1秒）
+     * @return 桶上界
+     */
+    static std::vector<double> latencyBuckets();
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+        std::atomic<uint64_t> count;
+        std::atomic<double> sum;
+    };
+
+    std::vector<double> upper_bounds_;
+    Shard shards_[kMetricShards];
+};
+
+/**
+ * @struct MetricSnapshot
+ * @brief 单个指标的快照
+ */
+struct MetricSnapshot {
+    std::string name;               ///< 指标名称
+    std::string help;               ///< 说明
+    MetricLabels labels;            ///< 标签
+    MetricType type;                ///< 指标类型
+    double value;                   ///< 计数器或仪表的值
+    HistogramSnapshot histogram;    ///< 直方图数据（仅直方图有效）
+
+    MetricSnapshot() : type(MetricType::Counter), value(0.0) {}
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief 指标注册表
+ *
+ * 以名称和标签唯一标识指标，重复注册返回同一个实例。
+ * 注册需要加锁，应在初始化时完成；指标对象的更新不经过注册表
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    // 禁用拷贝和赋值
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief 获取进程级默认注册表
+     * @return 默认注册表
+     */
+    static MetricsRegistry& global();
+
+    /**
+     * @brief 注册（或获取）计数器
+     * @param name 指标名称
+     * @param help 说明
+     * @param labels 标签
+     * @return 计数器
+     */
+    std::shared_ptr<Counter> counter(const std::string& name, const std::string& help,
+                                     const MetricLabels& labels = {});
+
+    /**
+     * @brief 注册（或获取）仪表
+     * @param name 指标名称
+     * @param help 说明
+     * @param labels 标签
+     * @return 仪表
+     */
+    std::shared_ptr<Gauge> gauge(const std::string& name, const std::string& help,
+                                 const MetricLabels& labels = {});
+
+    /**
+     * @brief 注册（或获取）直方图
+     * @param name 指标名称
+     * @param help 说明
+     * @param upper_bounds 桶上界，为空时使用默认延迟桶
+     * @param labels 标签
+     * @return 直方图
+     */
+    std::shared_ptr<Histogram> histogram(const std::string& name, const std::string& help,
+                                         const std::vector<double>& upper_bounds = {},
+                                         const MetricLabels& labels = {});
+
+    /**
+     * @brief 获取所有指标的快照（按名称和标签排序）
+     * @return 指标快照列表
+     */
+    std::vector<MetricSnapshot> snapshot() const;
+
+    /**
+     * @brief 以Prometheus文本格式导出所有指标
+     * @return 文本格式的指标
+     */
+    std::string exportPrometheus() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @class MetricsExporter
+ * @brief 指标导出服务
+ *
+ * 在本地Unix套接字上监听，每个连接返回一次HTTP响应，
+ * 内容为注册表的Prometheus文本格式（可用curl --unix-socket读取）
+ */
+class MetricsExporter {
+public:
+    /**
+     * @brief 构造函数
+     * @param registry 指标注册表
+     * @param socket_path Unix套接字路径
+     */
+    MetricsExporter(MetricsRegistry& registry, const std::string& socket_path);
+
+    /**
+     * @brief 析构函数，停止服务线程并删除套接字文件
+     */
+    ~MetricsExporter();
+
+    // 禁用拷贝和赋值
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief 开始监听
+     * @return 启动是否成功
+     */
+    bool start();
+
+    /**
+     * @brief 停止监听
+     */
+    void stop();
+
+    /**
+     * @brief 获取错误信息
+     * @return 错误描述
+     */
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Common
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_METRICS_H
@@ -0,0 +1,359 @@
+/**
+ * @file taskbar_benchmark.cpp
+ * @brief 任务栏无界面基准测试
+ *
+ * 使用计数渲染器驱动TaskbarManager，统计每种API操作（窗口添加和移除、
+ * 焦点切换、托盘更新、时钟进位、鼠标移动）引起的渲染器调用次数和耗时，
+ * 覆盖10-500个窗口，结果以JSON输出，用于验证局部刷新优化的效果。
+ *
+ * 用法: taskbar_benchmark [迭代次数] [输出文件]
+ * 未指定输出文件时写到标准输出
+ */
+
+#include "core/taskbar.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <json/json.h>
+
+using namespace CloudFlow::Desktop;
+
+namespace {
+
+constexpr size_t kDefaultIterations = 200;
+constexpr size_t kWindowCounts[] = {10, 50, 100, 250, 500};
+
+// 与任务栏布局一致：窗口列表从x=210开始，每项宽200
+constexpr int kWindowListLeft = 210;
+constexpr int kWindowListItemWidth = 200;
+
+constexpr const char* kMethodNames[] = {
+    "renderBackground", "renderStartMenuButton", "renderQuickLaunchItem", "renderWindowListItem",
+    "renderSystemTrayItem", "renderTrayTooltip", "hideTrayTooltip", "renderWindowGroupItem",
+    "renderWindowPreview", "hideWindowPreview", "renderStartMenu", "hideStartMenu",
+    "renderClock", "renderClockText", "renderDisplayList", "setTaskbarOffset",
+    "renderWindowListOverflow", "renderWindowOverlay", "showJumpList", "renderNotifications",
+    "hideNotifications", "renderCalendar", "hideCalendar", "renderKeyboardFocus", "getTaskbarSize"
+};
+
+enum Method : size_t {
+    RenderBackground, RenderStartMenuButton, RenderQuickLaunchItem, RenderWindowListItem,
+    RenderSystemTrayItem, RenderTrayTooltip, HideTrayTooltip, RenderWindowGroupItem,
+    RenderWindowPreview, HideWindowPreview, RenderStartMenu, HideStartMenu,
+    RenderClock, RenderClockText, RenderDisplayList, SetTaskbarOffset,
+    RenderWindowListOverflow, RenderWindowOverlay, ShowJumpList, RenderNotifications,
+    HideNotifications, RenderCalendar, HideCalendar, RenderKeyboardFocus, GetTaskbarSize,
+    MethodCount
+};
+
+static_assert(sizeof(kMethodNames) / sizeof(kMethodNames[0]) == MethodCount, "方法名与枚举不一致");
+
+using CallCounts = std::array<uint64_t, MethodCount>;
+
+/**
+ * @brief 只计数不绘制的渲染器
+ *
+ * 所有钩子都重写为计数，不依赖默认实现的转发（如renderWindowGroupItem
+ * 转发到renderWindowListItem），使统计反映任务栏实际发出的调用。
+ * 时钟线程可能在后台请求帧，计数使用原子变量
+ */
+class CountingRenderer : public ITaskbarRenderer {
+public:
+    CountingRenderer() {
+        for (auto& count : calls_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    CallCounts counts() const {
+        CallCounts result;
+        for (size_t i = 0; i < MethodCount; ++i) {
+            result[i] = calls_[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void renderBackground(const TaskbarAppearance&) override { bump(RenderBackground); }
+    void renderStartMenuButton(const TaskbarAppearance&, bool) override { bump(RenderStartMenuButton); }
+    void renderQuickLaunchItem(const QuickLaunchItem&, const TaskbarAppearance&) override {
+        bump(RenderQuickLaunchItem);
+    }
+    void renderWindowListItem(const std::string&, const std::string&, bool, bool,
+                              const TaskbarAppearance&) override {
+        bump(RenderWindowListItem);
+    }
+    void renderSystemTrayItem(const SystemTrayItem&, const TaskbarAppearance&) override {
+        bump(RenderSystemTrayItem);
+    }
+    void renderTrayTooltip(const SystemTrayItem&, const Sparkline&, const Sparkline&,
+                           const TaskbarAppearance&) override {
+        bump(RenderTrayTooltip);
+    }
+    void hideTrayTooltip(const TaskbarAppearance&) override { bump(HideTrayTooltip); }
+    void renderWindowGroupItem(const WindowGroup&, const std::string&, bool, bool,
+                               const TaskbarAppearance&) override {
+        bump(RenderWindowGroupItem);
+    }
+    void renderWindowPreview(const WindowPreview&, const TaskbarAppearance&) override {
+        bump(RenderWindowPreview);
+    }
+    void hideWindowPreview(const TaskbarAppearance&) override { bump(HideWindowPreview); }
+    void renderStartMenu(const std::vector<ApplicationEntry>&, const TaskbarAppearance&) override {
+        bump(RenderStartMenu);
+    }
+    void hideStartMenu(const TaskbarAppearance&) override { bump(HideStartMenu); }
+    void renderClock(const std::chrono::system_clock::time_point&, const ClockFormat&,
+                     const TaskbarAppearance&) override {
+        bump(RenderClock);
+    }
+    void renderClockText(const ClockText&, const ClockFormat&, const TaskbarAppearance&) override {
+        bump(RenderClockText);
+    }
+    bool renderDisplayList(TaskbarComponent, const DisplayList&, bool, const TaskbarAppearance&) override {
+        // 返回false让任务栏回放显示列表，统计逐项调用
+        bump(RenderDisplayList);
+        return false;
+    }
+    void setTaskbarOffset(int, const TaskbarAppearance&) override { bump(SetTaskbarOffset); }
+    void renderWindowListOverflow(const WindowListViewport&, const TaskbarAppearance&) override {
+        bump(RenderWindowListOverflow);
+    }
+    void renderWindowOverlay(const std::string&, const WindowOverlay&, const TaskbarAppearance&) override {
+        bump(RenderWindowOverlay);
+    }
+    void showJumpList(const std::string&, const RecentDocumentList&, const TaskbarAppearance&) override {
+        bump(ShowJumpList);
+    }
+    void renderNotifications(const std::vector<Notification>&, const TaskbarAppearance&) override {
+        bump(RenderNotifications);
+    }
+    void hideNotifications(const TaskbarAppearance&) override { bump(HideNotifications); }
+    void renderCalendar(const CalendarMonth&, int, const TaskbarAppearance&) override {
+        bump(RenderCalendar);
+    }
+    void hideCalendar(const TaskbarAppearance&) override { bump(HideCalendar); }
+    void renderKeyboardFocus(const std::string&, const TaskbarAppearance&) override { bump(RenderKeyboardFocus); }
+    std::pair<int, int> getTaskbarSize(const TaskbarAppearance& appearance) override {
+        bump(GetTaskbarSize);
+        return {1920, appearance.height};
+    }
+
+private:
+    void bump(Method method) {
+        calls_[method].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, MethodCount> calls_;
+};
+
+/**
+ * @brief 单个操作的统计结果
+ */
+struct OperationStats {
+    std::string name;
+    std::vector<double> samples_ns;
+    CallCounts calls{};
+
+    explicit OperationStats(std::string operation) : name(std::move(operation)) {}
+};
+
+/**
+ * @brief 一组窗口数量下的基准环境
+ *
+ * 与真实宿主相同，设置帧请求回调并在请求后调用processFrame()，
+ * 每次操作的耗时和调用数都包含它触发的那一帧
+ */
+class Bench {
+public:
+    explicit Bench(size_t window_count)
+        : renderer_(std::make_shared<CountingRenderer>()),
+          frame_requested_(false) {
+        manager_.setFrameRequestCallback([this]() { frame_requested_ = true; });
+        manager_.initialize(renderer_);
+        manager_.show();
+
+        // 默认托盘项由后台状态轮询更新，移除以免干扰计数，只保留一个基准托盘项
+        for (const auto& item : manager_.getSystemTrayItems()) {
+            manager_.removeSystemTrayItem(item.id);
+        }
+        SystemTrayItem tray;
+        tray.id = "bench";
+        tray.name = "bench";
+        manager_.addSystemTrayItem(tray);
+
+        for (size_t i = 0; i < window_count; ++i) {
+            window_ids_.push_back("window-" + std::to_string(i));
+            manager_.addWindowToList(window_ids_.back(), "Window " + std::to_string(i),
+                                     "app-" + std::to_string(i));
+        }
+        settle();
+    }
+
+    TaskbarManager& manager() { return manager_; }
+    const std::vector<std::string>& windowIds() const { return window_ids_; }
+
+    template <typename Fn>
+    void run(OperationStats& stats, Fn&& fn) {
+        CallCounts before = renderer_->counts();
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        settle();
+        auto end = std::chrono::steady_clock::now();
+        CallCounts after = renderer_->counts();
+
+        stats.samples_ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        for (size_t i = 0; i < MethodCount; ++i) {
+            stats.calls[i] += after[i] - before[i];
+        }
+    }
+
+private:
+    void settle() {
+        if (frame_requested_.exchange(false)) {
+            manager_.processFrame();
+        }
+    }
+
+    std::shared_ptr<CountingRenderer> renderer_;
+    TaskbarManager manager_;
+    std::atomic<bool> frame_requested_;
+    std::vector<std::string> window_ids_;
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+    if (samples.empty()) return 0.0;
+    // 最近秩法：第ceil(p*n)个样本（从1计数）
+    double rank = std::ceil(fraction * samples.size());
+    size_t index = static_cast<size_t>(std::max(1.0, std::min(rank, static_cast<double>(samples.size())))) - 1;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+Json::Value toJson(const OperationStats& stats) {
+    Json::Value result;
+    size_t iterations = stats.samples_ns.size();
+    double total_ns = 0.0;
+    for (double ns : stats.samples_ns) {
+        total_ns += ns;
+    }
+
+    uint64_t total_calls = 0;
+    Json::Value calls(Json::objectValue);
+    for (size_t i = 0; i < MethodCount; ++i) {
+        if (stats.calls[i] == 0) continue;
+        total_calls += stats.calls[i];
+        calls[kMethodNames[i]] = static_cast<double>(stats.calls[i]) / iterations;
+    }
+
+    result["iterations"] = static_cast<Json::UInt64>(iterations);
+    result["mean_ns"] = iterations ? total_ns / iterations : 0.0;
+    result["p50_ns"] = percentile(stats.samples_ns, 0.50);
+    result["p99_ns"] = percentile(stats.samples_ns, 0.99);
+    result["renderer_calls_per_op"] = iterations ? static_cast<double>(total_calls) / iterations : 0.0;
+    result["calls_per_op"] = calls;
+    return result;
+}
+
+Json::Value runWindowCount(size_t window_count, size_t iterations) {
+    Bench bench(window_count);
+    TaskbarManager& manager = bench.manager();
+    const auto& ids = bench.windowIds();
+
+    OperationStats add_stats{"window_add"};
+    OperationStats remove_stats{"window_remove"};
+    OperationStats focus_stats{"focus_change"};
+    OperationStats tray_stats{"tray_update"};
+    OperationStats clock_stats{"clock_tick"};
+    OperationStats move_stats{"mouse_move"};
+
+    // 添加和移除交替进行，窗口数量保持不变
+    const std::string extra_id = "window-extra";
+    for (size_t i = 0; i < iterations; ++i) {
+        bench.run(add_stats, [&]() { manager.addWindowToList(extra_id, "Extra", "app-extra"); });
+        bench.run(remove_stats, [&]() { manager.removeWindowFromList(extra_id); });
+    }
+
+    for (size_t i = 0; i < iterations; ++i) {
+        const std::string& id = ids[(i * 7 + 1) % ids.size()];
+        bench.run(focus_stats, [&]() { manager.setWindowActive(id, true); });
+    }
+
+    std::vector<SystemTrayItem> tray_states(2);
+    for (size_t i = 0; i < tray_states.size(); ++i) {
+        tray_states[i].id = "bench";
+        tray_states[i].name = "bench";
+        tray_states[i].tooltip = "state " + std::to_string(i);
+    }
+    for (size_t i = 0; i < iterations; ++i) {
+        const SystemTrayItem& item = tray_states[i % tray_states.size()];
+        bench.run(tray_stats, [&]() { manager.updateSystemTrayItem(item); });
+    }
+
+    for (size_t i = 0; i < iterations; ++i) {
+        bench.run(clock_stats, [&]() { manager.tickClock(); });
+    }
+
+    // 在前两个可见窗口列表项之间来回移动
+    for (size_t i = 0; i < iterations; ++i) {
+        int x = kWindowListLeft + kWindowListItemWidth / 2 + static_cast<int>(i % 2) * kWindowListItemWidth;
+        bench.run(move_stats, [&]() { manager.handleMouseMove(x, 20); });
+    }
+
+    Json::Value result;
+    result["windows"] = static_cast<Json::UInt64>(window_count);
+    Json::Value operations(Json::objectValue);
+    for (const OperationStats* stats : {&add_stats, &remove_stats, &focus_stats,
+                                        &tray_stats, &clock_stats, &move_stats}) {
+        operations[stats->name] = toJson(*stats);
+    }
+    result["operations"] = operations;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = kDefaultIterations;
+    if (argc > 1) {
+        long value = std::strtol(argv[1], nullptr, 10);
+        if (value <= 0) {
+            std::cerr << "无效的迭代次数: " << argv[1] << std::endl;
+            return 1;
+        }
+        iterations = static_cast<size_t>(value);
+    }
+
+    Json::Value root;
+    root["benchmark"] = "taskbar";
+    root["iterations"] = static_cast<Json::UInt64>(iterations);
+    Json::Value results(Json::arrayValue);
+    for (size_t window_count : kWindowCounts) {
+        results.append(runWindowCount(window_count, iterations));
+    }
+    root["results"] = results;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    std::string output = Json::writeString(builder, root);
+
+    if (argc > 2) {
+        std::ofstream file(argv[2]);
+        if (!file) {
+            std::cerr << "无法写入结果文件: " << argv[2] << std::endl;
+            return 1;
+        }
+        file << output << std::endl;
+    } else {
+        std::cout << output << std::endl;
+    }
+    return 0;
+}
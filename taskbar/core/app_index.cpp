@@ -0,0 +1,949 @@
+/**
+ * @file app_index.cpp
+ * @brief 开始菜单应用索引实现文件
+ */
+
+#include "app_index.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+// 应用目录及其子目录的inotify监视事件
+constexpr uint32_t kWatchMask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM;
+
+// 合并连续inotify事件的防抖间隔；持续有事件时最迟在首个事件之后4倍间隔处理
+constexpr std::chrono::milliseconds kWatchDebounce(200);
+constexpr int kMaxDebounceFactor = 4;
+
+constexpr char kIndexMagic[8] = {'C', 'F', 'A', 'P', 'P', 'I', 'D', 'X'};
+constexpr uint32_t kIndexVersion = 1;
+
+/**
+ * @brief 索引项字段
+ */
+enum Field {
+    FieldId,
+    FieldName,
+    FieldLocalizedName,
+    FieldKeywords,
+    FieldIcon,
+    FieldExec,
+    FieldPath,
+    FieldCount
+};
+
+/**
+ * @brief 索引文件头
+ *
+ * 文件布局：文件头 | 索引记录（按显示名称排序） | 按ID排序的记录下标 | 字符串表
+ */
+struct IndexHeader {
+    char magic[8];              ///< 魔数
+    uint32_t version;           ///< 格式版本
+    uint32_t entry_count;       ///< 索引项数量
+    uint64_t source_stamp;      ///< 应用目录状态摘要
+    uint32_t records_offset;    ///< 索引记录偏移
+    uint32_t id_order_offset;   ///< ID排序下标偏移
+    uint32_t strings_offset;    ///< 字符串表偏移
+    uint32_t strings_size;      ///< 字符串表长度
+    char locale[32];            ///< 构建时的语言环境
+};
+
+/**
+ * @brief 索引记录，字段为字符串表中的偏移和长度
+ */
+struct IndexRecord {
+    uint32_t offset[FieldCount];
+    uint32_t length[FieldCount];
+};
+
+/**
+ * @brief 构建索引时使用的应用记录
+ */
+struct ApplicationRecord {
+    std::string fields[FieldCount];
+
+    const std::string& displayName() const {
+        return fields[FieldLocalizedName].empty() ? fields[FieldName] : fields[FieldLocalizedName];
+    }
+};
+
+/**
+ * @brief 待解析的desktop文件
+ */
+struct DesktopFile {
+    std::string path;
+    std::string id;
+};
+
+const IndexHeader* headerOf(const uint8_t* data) {
+    return reinterpret_cast<const IndexHeader*>(data);
+}
+
+const IndexRecord* recordsOf(const uint8_t* data) {
+    return reinterpret_cast<const IndexRecord*>(data + headerOf(data)->records_offset);
+}
+
+const uint32_t* idOrderOf(const uint8_t* data) {
+    return reinterpret_cast<const uint32_t*>(data + headerOf(data)->id_order_offset);
+}
+
+std::string_view fieldOf(const uint8_t* data, const IndexRecord& record, Field field) {
+    const char* strings = reinterpret_cast<const char*>(data + headerOf(data)->strings_offset);
+    return std::string_view(strings + record.offset[field], record.length[field]);
+}
+
+bool validateIndex(const uint8_t* data, size_t size) {
+    if (size < sizeof(IndexHeader)) return false;
+
+    const IndexHeader* header = headerOf(data);
+    if (std::memcmp(header->magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        header->version != kIndexVersion) {
+        return false;
+    }
+
+    uint64_t count = header->entry_count;
+    if (header->records_offset % alignof(IndexRecord) != 0 ||
+        header->id_order_offset % alignof(uint32_t) != 0 ||
+        header->records_offset + count * sizeof(IndexRecord) > size ||
+        header->id_order_offset + count * sizeof(uint32_t) > size ||
+        static_cast<uint64_t>(header->strings_offset) + header->strings_size > size) {
+        return false;
+    }
+
+    const IndexRecord* records = recordsOf(data);
+    const uint32_t* id_order = idOrderOf(data);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (id_order[i] >= count) return false;
+        for (int field = 0; field < FieldCount; ++field) {
+            if (static_cast<uint64_t>(records[i].offset[field]) + records[i].length[field] > header->strings_size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string currentLocale() {
+    // 按gettext的优先顺序确定语言环境，去掉编码和修饰符部分
+    const char* candidates[] = {"LC_ALL", "LC_MESSAGES", "LANG"};
+    for (const char* name : candidates) {
+        const char* value = std::getenv(name);
+        if (value && *value) {
+            std::string locale(value);
+            locale = locale.substr(0, locale.find_first_of(".@"));
+            return (locale == "C" || locale == "POSIX") ? "" : locale.substr(0, 31);
+        }
+    }
+    return "";
+}
+
+std::vector<std::string> defaultDirectories() {
+    std::vector<std::string> directories;
+
+    const char* data_home = std::getenv("XDG_DATA_HOME");
+    const char* home = std::getenv("HOME");
+    if (data_home && *data_home) {
+        directories.push_back(std::string(data_home) + "/applications");
+    } else if (home && *home) {
+        directories.push_back(std::string(home) + "/.local/share/applications");
+    }
+
+    const char* data_dirs = std::getenv("XDG_DATA_DIRS");
+    std::string dirs = (data_dirs && *data_dirs) ? data_dirs : "/usr/local/share:/usr/share";
+    size_t start = 0;
+    while (start <= dirs.size()) {
+        size_t end = dirs.find(':', start);
+        if (end == std::string::npos) end = dirs.size();
+        if (end > start) {
+            directories.push_back(dirs.substr(start, end - start) + "/applications");
+        }
+        start = end + 1;
+    }
+    return directories;
+}
+
+/**
+ * @brief FNV-1a摘要
+ */
+class StampHasher {
+public:
+    StampHasher() : hash_(1469598103934665603ULL) {}
+
+    void mix(const void* bytes, size_t length) {
+        const uint8_t* p = static_cast<const uint8_t*>(bytes);
+        for (size_t i = 0; i < length; ++i) {
+            hash_ = (hash_ ^ p[i]) * 1099511628211ULL;
+        }
+    }
+
+    void mixStat(const struct stat& st) {
+        mix(&st.st_ino, sizeof(st.st_ino));
+        mix(&st.st_size, sizeof(st.st_size));
+        mix(&st.st_mtim.tv_sec, sizeof(st.st_mtim.tv_sec));
+        mix(&st.st_mtim.tv_nsec, sizeof(st.st_mtim.tv_nsec));
+    }
+
+    uint64_t value() const { return hash_; }
+
+private:
+    uint64_t hash_;
+};
+
+/**
+ * @brief 摘要目录及其子目录：各目录和desktop文件的名称、inode、大小和修改时间
+ *
+ * 目录的修改时间只反映其中条目的增删，原地编辑desktop文件和子目录中的变化
+ * 需要逐个文件记录（与collectDesktopFiles的递归扫描一致）
+ */
+void stampDirectory(const std::string& directory, StampHasher& hasher) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return;
+
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            names.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        std::string path = directory + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            hasher.mix(name.data(), name.size() + 1);
+            hasher.mixStat(st);
+            stampDirectory(path, hasher);
+        } else if (name.size() > 8 && name.compare(name.size() - 8, 8, ".desktop") == 0) {
+            hasher.mix(name.data(), name.size() + 1);
+            hasher.mixStat(st);
+        }
+    }
+}
+
+uint64_t sourceStamp(const std::vector<std::string>& directories, const std::string& locale) {
+    StampHasher hasher;
+    hasher.mix(locale.data(), locale.size() + 1);
+    for (const auto& directory : directories) {
+        hasher.mix(directory.data(), directory.size() + 1);
+        struct stat st;
+        if (stat(directory.c_str(), &st) == 0) {
+            hasher.mixStat(st);
+            stampDirectory(directory, hasher);
+        }
+    }
+    return hasher.value();
+}
+
+void collectDesktopFiles(const std::string& directory, const std::string& prefix, std::vector<DesktopFile>& files) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return;
+
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            names.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        std::string path = directory + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            // 子目录中的文件ID以'-'连接目录名（desktop-entry规范）
+            collectDesktopFiles(path, prefix + name + "-", files);
+        } else if (name.size() > 8 && name.compare(name.size() - 8, 8, ".desktop") == 0) {
+            files.push_back({path, prefix + name});
+        }
+    }
+}
+
+std::string unescapeValue(const std::string& value) {
+    std::string result;
+    result.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size()) {
+            switch (value[++i]) {
+                case 's': result += ' '; break;
+                case 'n': result += '\n'; break;
+                case 't': result += '\t'; break;
+                case 'r': result += '\r'; break;
+                default: result += value[i]; break;
+            }
+        } else {
+            result += value[i];
+        }
+    }
+    return result;
+}
+
+std::string stripFieldCodes(const std::string& exec) {
+    std::string result;
+    result.reserve(exec.size());
+    for (size_t i = 0; i < exec.size(); ++i) {
+        if (exec[i] == '%' && i + 1 < exec.size()) {
+            if (exec[++i] == '%') {
+                result += '%';
+            }
+            continue;
+        }
+        result += exec[i];
+    }
+
+    while (!result.empty() && result.back() == ' ') {
+        result.pop_back();
+    }
+    return result;
+}
+
+/**
+ * @brief 解析desktop文件
+ * @return 文件可作为开始菜单项显示时返回true
+ */
+bool parseDesktopFile(const DesktopFile& file, const std::string& locale, ApplicationRecord& record) {
+    std::ifstream stream(file.path);
+    if (!stream.is_open()) return false;
+
+    std::string language = locale.substr(0, locale.find('_'));
+    int name_rank = 0;
+    int keywords_rank = 0;
+    std::string keywords;
+    std::string localized_keywords;
+    bool in_entry = false;
+    bool is_application = false;
+    bool hidden = false;
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == '[') {
+            in_entry = (line.compare(0, 15, "[Desktop Entry]") == 0);
+            continue;
+        }
+        if (!in_entry) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+
+        std::string key = line.substr(0, eq);
+        std::string value = unescapeValue(line.substr(eq + 1));
+        key.erase(key.find_last_not_of(' ') + 1);
+        value.erase(0, value.find_first_not_of(' '));
+
+        // 拆分本地化键：Name[zh_CN]
+        std::string key_locale;
+        size_t bracket = key.find('[');
+        if (bracket != std::string::npos && key.back() == ']') {
+            key_locale = key.substr(bracket + 1, key.size() - bracket - 2);
+            key = key.substr(0, bracket);
+        }
+        int rank = key_locale.empty() ? 0 :
+                   (!locale.empty() && key_locale == locale) ? 2 :
+                   (!language.empty() && key_locale == language) ? 1 : -1;
+        if (rank < 0) continue;
+
+        if (key == "Type") {
+            is_application = (value == "Application");
+        } else if (key == "NoDisplay" || key == "Hidden") {
+            hidden = hidden || (value == "true");
+        } else if (key == "Name") {
+            if (rank == 0) {
+                record.fields[FieldName] = value;
+            } else if (rank > name_rank) {
+                record.fields[FieldLocalizedName] = value;
+                name_rank = rank;
+            }
+        } else if (key == "Keywords") {
+            if (rank == 0) {
+                keywords = value;
+            } else if (rank > keywords_rank) {
+                localized_keywords = value;
+                keywords_rank = rank;
+            }
+        } else if (key == "Icon" && rank == 0) {
+            record.fields[FieldIcon] = value;
+        } else if (key == "Exec" && rank == 0) {
+            record.fields[FieldExec] = stripFieldCodes(value);
+        }
+    }
+
+    record.fields[FieldId] = file.id;
+    record.fields[FieldPath] = file.path;
+    // 两组关键字之间补上分隔符，避免搜索跨越相邻关键字的边界匹配
+    if (!localized_keywords.empty() && !keywords.empty() && localized_keywords.back() != ';') {
+        localized_keywords += ';';
+    }
+    record.fields[FieldKeywords] = localized_keywords + keywords;
+    return is_application && !hidden && !record.fields[FieldName].empty();
+}
+
+} // namespace
+
+// ApplicationIndexSnapshot 实现
+ApplicationIndexSnapshot::ApplicationIndexSnapshot(const uint8_t* data, size_t size)
+    : data_(data), size_(size) {}
+
+ApplicationIndexSnapshot::~ApplicationIndexSnapshot() {
+    munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+size_t ApplicationIndexSnapshot::size() const {
+    return headerOf(data_)->entry_count;
+}
+
+ApplicationEntry ApplicationIndexSnapshot::entry(size_t index) const {
+    const IndexRecord& record = recordsOf(data_)[index];
+    ApplicationEntry entry;
+    entry.id = fieldOf(data_, record, FieldId);
+    entry.name = fieldOf(data_, record, FieldName);
+    entry.localized_name = fieldOf(data_, record, FieldLocalizedName);
+    entry.keywords = fieldOf(data_, record, FieldKeywords);
+    entry.icon = fieldOf(data_, record, FieldIcon);
+    entry.exec = fieldOf(data_, record, FieldExec);
+    entry.path = fieldOf(data_, record, FieldPath);
+    return entry;
+}
+
+int ApplicationIndexSnapshot::find(std::string_view id) const {
+    const IndexRecord* records = recordsOf(data_);
+    const uint32_t* id_order = idOrderOf(data_);
+    size_t count = size();
+
+    auto it = std::lower_bound(id_order, id_order + count, id,
+                               [this, records](uint32_t index, std::string_view key) {
+                                   return fieldOf(data_, records[index], FieldId) < key;
+                               });
+    if (it == id_order + count || fieldOf(data_, records[*it], FieldId) != id) {
+        return -1;
+    }
+    return static_cast<int>(*it);
+}
+
+// ApplicationIndex 实现类
+class ApplicationIndex::Impl {
+public:
+    Impl(const std::string& cache_path, const std::vector<std::string>& directories)
+        : cache_path_(cache_path),
+          directories_(directories.empty() ? defaultDirectories() : directories),
+          locale_(currentLocale()),
+          inotify_fd_(-1) {
+        stop_pipe_[0] = stop_pipe_[1] = -1;
+    }
+
+    ~Impl() {
+        stopWatching();
+        if (load_thread_.joinable()) {
+            load_thread_.join();
+        }
+    }
+
+    bool load() {
+        uint64_t stamp = 0;
+        bool mapped = false;
+        {
+            std::lock_guard<std::mutex> build_lock(build_mutex_);
+            auto snapshot = mapIndexFile(&stamp);
+            if (snapshot) {
+                // 先提供已有的映射（可能已过期），调用方不等待校验和重建
+                setSnapshot(snapshot);
+                mapped = true;
+            }
+        }
+
+        // 摘要需要遍历全部desktop文件，校验和重建都在后台线程中进行，
+        // 完成后通过变化回调通知（即使索引未过期，使用方也可据此在后台准备派生数据）
+        if (load_thread_.joinable()) {
+            load_thread_.join();
+        }
+        load_thread_ = std::thread([this, stamp, mapped]() {
+            {
+                std::lock_guard<std::mutex> build_lock(build_mutex_);
+                if (!mapped || stamp != sourceStamp(directories_, locale_)) {
+                    rebuildLocked();
+                }
+            }
+            if (snapshot()) notifyChange();
+        });
+        return true;
+    }
+
+    bool rebuild() {
+        std::lock_guard<std::mutex> build_lock(build_mutex_);
+        return rebuildLocked();
+    }
+
+    bool startWatching() {
+        if (watch_thread_.joinable()) return true;
+
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0 || pipe2(stop_pipe_, O_CLOEXEC) != 0) {
+            setError(std::string("无法创建inotify监视: ") + std::strerror(errno));
+            closeWatchFds();
+            return false;
+        }
+
+        for (size_t i = 0; i < directories_.size(); ++i) {
+            // 目录不存在时忽略，应用目录通常由包管理器创建
+            addWatch(i, directories_[i], "");
+        }
+
+        watch_thread_ = std::thread([this]() { watchLoop(); });
+        return true;
+    }
+
+    void stopWatching() {
+        if (!watch_thread_.joinable()) return;
+
+        char byte = 0;
+        (void)write(stop_pipe_[1], &byte, 1);
+        watch_thread_.join();
+        closeWatchFds();
+        watches_.clear();
+    }
+
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return snapshot_;
+    }
+
+    void setChangeCallback(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        change_callback_ = std::move(callback);
+    }
+
+    std::string getLastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_error_;
+    }
+
+private:
+    std::shared_ptr<const ApplicationIndexSnapshot> mapIndexFile(uint64_t* source_stamp = nullptr) {
+        int fd = open(cache_path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return nullptr;
+
+        struct stat st;
+        void* data = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (data == MAP_FAILED) return nullptr;
+
+        size_t size = static_cast<size_t>(st.st_size);
+        if (!validateIndex(static_cast<const uint8_t*>(data), size) ||
+            std::string(headerOf(static_cast<const uint8_t*>(data))->locale) != locale_) {
+            munmap(data, size);
+            return nullptr;
+        }
+        if (source_stamp) {
+            *source_stamp = headerOf(static_cast<const uint8_t*>(data))->source_stamp;
+        }
+        return std::make_shared<const ApplicationIndexSnapshot>(static_cast<const uint8_t*>(data), size);
+    }
+
+    std::vector<ApplicationRecord> scanDirectories() const {
+        std::vector<DesktopFile> files;
+        for (const auto& directory : directories_) {
+            collectDesktopFiles(directory, "", files);
+        }
+
+        // 并行解析：每个线程处理一段连续区间，结果写入各自的槽位
+        std::vector<ApplicationRecord> parsed(files.size());
+        std::vector<char> visible(files.size(), 0);
+        size_t thread_count = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(),
+                                                                   files.size() / 32 + 1));
+        size_t chunk = (files.size() + thread_count - 1) / thread_count;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < thread_count; ++t) {
+            size_t begin = t * chunk;
+            size_t end = std::min(files.size(), begin + chunk);
+            workers.emplace_back([&, begin, end]() {
+                for (size_t i = begin; i < end; ++i) {
+                    visible[i] = parseDesktopFile(files[i], locale_, parsed[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // 目录按优先级排列，同一ID以先出现者为准（隐藏项同样会遮蔽低优先级的同名项）
+        std::vector<ApplicationRecord> records;
+        std::unordered_set<std::string> seen;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (seen.insert(files[i].id).second && visible[i]) {
+                records.push_back(std::move(parsed[i]));
+            }
+        }
+        return records;
+    }
+
+    bool rebuildLocked() {
+        // 摘要在扫描之前计算，扫描期间的变化会使下次校验失败而不是被掩盖
+        uint64_t stamp = sourceStamp(directories_, locale_);
+        return writeAndMap(scanDirectories(), stamp);
+    }
+
+    bool writeAndMap(std::vector<ApplicationRecord> records, uint64_t source_stamp) {
+        std::sort(records.begin(), records.end(),
+                  [](const ApplicationRecord& a, const ApplicationRecord& b) {
+                      if (a.displayName() != b.displayName()) return a.displayName() < b.displayName();
+                      return a.fields[FieldId] < b.fields[FieldId];
+                  });
+
+        std::vector<IndexRecord> index_records(records.size());
+        std::string strings;
+        for (size_t i = 0; i < records.size(); ++i) {
+            for (int field = 0; field < FieldCount; ++field) {
+                index_records[i].offset[field] = static_cast<uint32_t>(strings.size());
+                index_records[i].length[field] = static_cast<uint32_t>(records[i].fields[field].size());
+                strings += records[i].fields[field];
+            }
+        }
+
+        std::vector<uint32_t> id_order(records.size());
+        for (size_t i = 0; i < id_order.size(); ++i) {
+            id_order[i] = static_cast<uint32_t>(i);
+        }
+        std::sort(id_order.begin(), id_order.end(), [&records](uint32_t a, uint32_t b) {
+            return records[a].fields[FieldId] < records[b].fields[FieldId];
+        });
+
+        IndexHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+        header.version = kIndexVersion;
+        header.entry_count = static_cast<uint32_t>(records.size());
+        header.source_stamp = source_stamp;
+        header.records_offset = sizeof(IndexHeader);
+        header.id_order_offset = header.records_offset + static_cast<uint32_t>(index_records.size() * sizeof(IndexRecord));
+        header.strings_offset = header.id_order_offset + static_cast<uint32_t>(id_order.size() * sizeof(uint32_t));
+        header.strings_size = static_cast<uint32_t>(strings.size());
+        std::strncpy(header.locale, locale_.c_str(), sizeof(header.locale) - 1);
+
+        // 写入临时文件后原子替换，读者始终看到完整的索引
+        createParentDirectories(cache_path_);
+        std::string temp_path = cache_path_ + ".tmp." + std::to_string(getpid());
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                setError("无法写入应用索引: " + temp_path);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(index_records.data()), index_records.size() * sizeof(IndexRecord));
+            file.write(reinterpret_cast<const char*>(id_order.data()), id_order.size() * sizeof(uint32_t));
+            file.write(strings.data(), strings.size());
+            if (!file.good()) {
+                setError("写入应用索引失败: " + temp_path);
+                std::remove(temp_path.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename(temp_path.c_str(), cache_path_.c_str()) != 0) {
+            setError("无法替换应用索引: " + cache_path_);
+            std::remove(temp_path.c_str());
+            return false;
+        }
+
+        auto mapped = mapIndexFile();
+        if (!mapped) {
+            setError("无法映射应用索引: " + cache_path_);
+            return false;
+        }
+        setSnapshot(mapped);
+        return true;
+    }
+
+    void applyChanges(const std::set<std::string>& changed_ids) {
+        {
+            std::lock_guard<std::mutex> build_lock(build_mutex_);
+            auto current = snapshot();
+            if (!current) return;
+            uint64_t stamp = sourceStamp(directories_, locale_);
+
+            // 从当前映射还原其余项，只重新解析发生变化的文件
+            std::vector<ApplicationRecord> records;
+            records.reserve(current->size() + changed_ids.size());
+            for (size_t i = 0; i < current->size(); ++i) {
+                ApplicationEntry entry = current->entry(i);
+                if (changed_ids.count(std::string(entry.id))) continue;
+
+                ApplicationRecord record;
+                record.fields[FieldId] = std::string(entry.id);
+                record.fields[FieldName] = std::string(entry.name);
+                record.fields[FieldLocalizedName] = std::string(entry.localized_name);
+                record.fields[FieldKeywords] = std::string(entry.keywords);
+                record.fields[FieldIcon] = std::string(entry.icon);
+                record.fields[FieldExec] = std::string(entry.exec);
+                record.fields[FieldPath] = std::string(entry.path);
+                records.push_back(std::move(record));
+            }
+
+            for (const auto& id : changed_ids) {
+                DesktopFile file{resolveDesktopFile(id), id};
+                if (file.path.empty()) continue;
+
+                ApplicationRecord record;
+                if (parseDesktopFile(file, locale_, record)) {
+                    records.push_back(std::move(record));
+                }
+            }
+
+            if (!writeAndMap(std::move(records), stamp)) return;
+        }
+        notifyChange();
+    }
+
+    void watchLoop() {
+        std::set<std::string> pending;
+        bool full_rebuild = false;
+        std::chrono::steady_clock::time_point first_event;
+        std::chrono::steady_clock::time_point deadline;
+        alignas(struct inotify_event) char buffer[4096];
+
+        while (true) {
+            struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {stop_pipe_[0], POLLIN, 0}};
+            // 有未处理的变化时等到防抖截止时间，合并连续事件（如包管理器批量安装）
+            bool has_pending = full_rebuild || !pending.empty();
+            int timeout = -1;
+            if (has_pending) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                timeout = static_cast<int>(std::max<int64_t>(0, remaining));
+            }
+            int ready = poll(fds, 2, timeout);
+            if (ready < 0 && errno != EINTR) return;
+            if (fds[1].revents & POLLIN) return;
+
+            if (ready > 0) {
+                readEvents(buffer, sizeof(buffer), pending, full_rebuild);
+
+                // 每个事件推后截止时间，但最迟在首个事件之后kMaxDebounceFactor倍间隔处理
+                auto now = std::chrono::steady_clock::now();
+                if (!has_pending) first_event = now;
+                deadline = std::min(now + kWatchDebounce, first_event + kWatchDebounce * kMaxDebounceFactor);
+            }
+
+            if ((full_rebuild || !pending.empty()) && std::chrono::steady_clock::now() >= deadline) {
+                if (full_rebuild) {
+                    if (rebuild()) notifyChange();
+                } else {
+                    applyChanges(pending);
+                }
+                pending.clear();
+                full_rebuild = false;
+            }
+        }
+    }
+
+    /**
+     * @brief 读取并归类所有可读的inotify事件
+     * @param pending 输出发生变化的文件ID
+     * @param full_rebuild 输出是否需要整体重建
+     */
+    void readEvents(char* buffer, size_t buffer_size, std::set<std::string>& pending, bool& full_rebuild) {
+        ssize_t length;
+        while ((length = read(inotify_fd_, buffer, buffer_size)) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(p);
+                auto watch = watches_.find(event->wd);
+                if (event->mask & IN_Q_OVERFLOW) {
+                    full_rebuild = true;
+                } else if (event->mask & IN_IGNORED) {
+                    // 子目录被删除或移走，内核已移除监视
+                    if (watch != watches_.end()) watches_.erase(watch);
+                } else if (event->len > 0 && watch != watches_.end()) {
+                    std::string name(event->name);
+                    WatchedDirectory parent = watch->second;
+                    if (event->mask & IN_ISDIR) {
+                        // 子目录增删会成批改变其中的文件ID，监视新目录并整体重建
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                            addWatch(parent.root, parent.path + "/" + name, parent.prefix + name + "-");
+                        }
+                        full_rebuild = true;
+                    } else if (name.size() > 8 && name.compare(name.size() - 8, 8, ".desktop") == 0) {
+                        pending.insert(parent.prefix + name);
+                    }
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+    /**
+     * @brief 监视目录及其全部子目录（与collectDesktopFiles的递归扫描一致）
+     * @param root 所属应用目录在directories_中的下标
+     * @param path 目录路径
+     * @param prefix 目录中文件ID的前缀
+     */
+    void addWatch(size_t root, const std::string& path, const std::string& prefix) {
+        int wd = inotify_add_watch(inotify_fd_, path.c_str(), kWatchMask | IN_ONLYDIR);
+        if (wd < 0) return;
+        watches_[wd] = WatchedDirectory{root, path, prefix};
+
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return;
+        std::vector<std::string> subdirectories;
+        while (struct dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] == '.') continue;
+            std::string child = path + "/" + entry->d_name;
+            struct stat st;
+            if (stat(child.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+                subdirectories.push_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+
+        for (const auto& name : subdirectories) {
+            addWatch(root, path + "/" + name, prefix + name + "-");
+        }
+    }
+
+    /**
+     * @brief 按目录优先级查找文件ID对应的desktop文件
+     * @return 文件路径，文件已不存在时返回空字符串
+     */
+    std::string resolveDesktopFile(const std::string& id) const {
+        for (size_t root = 0; root < directories_.size(); ++root) {
+            for (const auto& entry : watches_) {
+                const WatchedDirectory& watch = entry.second;
+                if (watch.root != root || id.size() <= watch.prefix.size() ||
+                    id.compare(0, watch.prefix.size(), watch.prefix) != 0) {
+                    continue;
+                }
+                std::string path = watch.path + "/" + id.substr(watch.prefix.size());
+                if (access(path.c_str(), F_OK) == 0) return path;
+            }
+        }
+        return "";
+    }
+
+    void setSnapshot(std::shared_ptr<const ApplicationIndexSnapshot> snapshot) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_ = std::move(snapshot);
+    }
+
+    void notifyChange() {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = change_callback_;
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    void setError(const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_error_ = error;
+    }
+
+    void closeWatchFds() {
+        for (int* fd : {&inotify_fd_, &stop_pipe_[0], &stop_pipe_[1]}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    static void createParentDirectories(const std::string& path) {
+        for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+            mkdir(path.substr(0, pos).c_str(), 0755);
+        }
+    }
+
+    const std::string cache_path_;
+    const std::vector<std::string> directories_;
+    const std::string locale_;
+
+    mutable std::mutex mutex_;
+    std::mutex build_mutex_;
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot_;
+    std::function<void()> change_callback_;
+    std::string last_error_;
+    std::thread load_thread_;
+
+    /**
+     * @brief 被监视的目录（只在监视线程中访问）
+     */
+    struct WatchedDirectory {
+        size_t root;            ///< 所属应用目录在directories_中的下标
+        std::string path;       ///< 目录路径
+        std::string prefix;     ///< 目录中文件ID的前缀
+    };
+
+    int inotify_fd_;
+    int stop_pipe_[2];
+    std::unordered_map<int, WatchedDirectory> watches_;
+    std::thread watch_thread_;
+};
+
+// ApplicationIndex 实现
+ApplicationIndex::ApplicationIndex(const std::string& cache_path, const std::vector<std::string>& directories)
+    : impl_(std::make_unique<Impl>(cache_path, directories)) {}
+
+ApplicationIndex::~ApplicationIndex() = default;
+
+bool ApplicationIndex::load() {
+    return impl_->load();
+}
+
+bool ApplicationIndex::rebuild() {
+    return impl_->rebuild();
+}
+
+bool ApplicationIndex::startWatching() {
+    return impl_->startWatching();
+}
+
+void ApplicationIndex::stopWatching() {
+    impl_->stopWatching();
+}
+
+std::shared_ptr<const ApplicationIndexSnapshot> ApplicationIndex::snapshot() const {
+    return impl_->snapshot();
+}
+
+void ApplicationIndex::setChangeCallback(std::function<void()> callback) {
+    impl_->setChangeCallback(std::move(callback));
+}
+
+std::string ApplicationIndex::getLastError() const {
+    return impl_->getLastError();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
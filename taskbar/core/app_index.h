@@ -0,0 +1,174 @@
+/**
+ * @file app_index.h
+ * @brief 开始菜单应用索引头文件
+ *
+ * 将已安装应用（.desktop文件）的名称、本地化名称、关键字和图标
+ * 编入紧凑的二进制索引文件，通过内存映射读取；
+ * 首次运行时并行构建，之后通过inotify增量刷新
+ */
+
+#ifndef CLOUDFLOW_APP_INDEX_H
+#define CLOUDFLOW_APP_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct ApplicationEntry
+ * @brief 应用索引项（指向映射内存的只读视图）
+ *
+ * 仅在所属的ApplicationIndexSnapshot存活期间有效
+ */
+struct ApplicationEntry {
+    std::string_view id;              ///< desktop文件ID
+    std::string_view name;            ///< 名称
+    std::string_view localized_name;  ///< 本地化名称
+    std::string_view keywords;        ///< 关键字（分号分隔）
+    std::string_view icon;            ///< 图标名称或路径
+    std::string_view exec;            ///< 启动命令（已去除域代码）
+    std::string_view path;            ///< 来源desktop文件路径
+
+    /**
+     * @brief 获取显示名称（优先本地化名称）
+     * @return 显示名称
+     */
+    std::string_view displayName() const {
+        return localized_name.empty() ? name : localized_name;
+    }
+};
+
+/**
+ * @class ApplicationIndexSnapshot
+ * @brief 应用索引快照
+ *
+ * 持有一次内存映射，读取索引项不涉及任何文件系统访问。
+ * 索引刷新后旧快照仍然有效，直到最后一个持有者释放
+ */
+class ApplicationIndexSnapshot {
+public:
+    /**
+     * @brief 构造函数
+     * @param data 映射内存起始地址
+     * @param size 映射长度
+     */
+    ApplicationIndexSnapshot(const uint8_t* data, size_t size);
+
+    /**
+     * @brief 析构函数，解除内存映射
+     */
+    ~ApplicationIndexSnapshot();
+
+    // 禁用拷贝和赋值
+    ApplicationIndexSnapshot(const ApplicationIndexSnapshot&) = delete;
+    ApplicationIndexSnapshot& operator=(const ApplicationIndexSnapshot&) = delete;
+
+    /**
+     * @brief 获取索引项数量
+     * @return 索引项数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 获取索引项（按显示名称排序）
+     * @param index 下标
+     * @return 索引项
+     */
+    ApplicationEntry entry(size_t index) const;
+
+    /**
+     * @brief 按desktop文件ID查找索引项（二分查找）
+     * @param id desktop文件ID
+     * @return 下标，不存在返回-1
+     */
+    int find(std::string_view id) const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
+
+/**
+ * @class ApplicationIndex
+ * @brief 应用索引
+ */
+class ApplicationIndex {
+public:
+    /**
+     * @brief 构造函数
+     * @param cache_path 索引文件路径
+     * @param directories 应用目录（按优先级从高到低），为空时使用XDG数据目录
+     */
+    explicit ApplicationIndex(const std::string& cache_path,
+                              const std::vector<std::string>& directories = {});
+
+    /**
+     * @brief 析构函数，停止监视线程
+     */
+    ~ApplicationIndex();
+
+    // 禁用拷贝和赋值
+    ApplicationIndex(const ApplicationIndex&) = delete;
+    ApplicationIndex& operator=(const ApplicationIndex&) = delete;
+
+    /**
+     * @brief 加载索引
+     *
+     * 立即提供已有的索引文件映射（可能已过期，文件缺失时快照为空），
+     * 在后台线程中校验摘要，索引文件缺失、损坏或过期时并行重建，完成后调用变化回调
+     * （索引未过期时也会调用一次）
+     * @return 是否已开始加载（重建失败时通过getLastError获取错误）
+     */
+    bool load();
+
+    /**
+     * @brief 强制重建索引
+     * @return 重建是否成功
+     */
+    bool rebuild();
+
+    /**
+     * @brief 开始通过inotify监视应用目录并增量刷新
+     * @return 启动是否成功
+     */
+    bool startWatching();
+
+    /**
+     * @brief 停止监视
+     */
+    void stopWatching();
+
+    /**
+     * @brief 获取当前索引快照
+     * @return 索引快照，未加载返回空指针
+     */
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot() const;
+
+    /**
+     * @brief 设置索引变化回调（在加载或监视线程中调用）
+     * @param callback 回调函数
+     */
+    void setChangeCallback(std::function<void()> callback);
+
+    /**
+     * @brief 获取错误信息
+     * @return 错误描述
+     */
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_APP_INDEX_H
@@ -0,0 +1,305 @@
+/**
+ * @file app_search.cpp
+ * @brief 开始菜单应用搜索实现文件
+ */
+
+#include "app_search.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+/**
+ * @brief 可搜索形式及其权重（百分比）
+ */
+enum Form {
+    FormName,
+    FormLocalizedName,
+    FormPinyin,
+    FormInitials,
+    FormKeywords,
+    FormId,
+    FormCount
+};
+
+const int kFormWeights[FormCount] = {100, 100, 90, 85, 60, 50};
+
+/**
+ * @brief 单个应用的可搜索形式在文本区中的位置
+ */
+struct EntryForms {
+    uint32_t offset[FormCount];
+    uint16_t length[FormCount];
+};
+
+/**
+ * @brief 字符在位图中的位：a-z占0-25，0-9占26-35，非ASCII字符按码点散列到37-63
+ */
+int charBit(char32_t code_point) {
+    if (code_point >= 'a' && code_point <= 'z') return static_cast<int>(code_point - 'a');
+    if (code_point >= '0' && code_point <= '9') return 26 + static_cast<int>(code_point - '0');
+    if (code_point >= 0x80) return 37 + static_cast<int>(code_point % 27);
+    return -1;
+}
+
+uint64_t textBitmap(std::string_view text) {
+    uint64_t bitmap = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        int bit = charBit(decodeUtf8(text, pos));
+        if (bit >= 0) bitmap |= (1ULL << bit);
+    }
+    return bitmap;
+}
+
+void appendLower(std::string& out, std::string_view text) {
+    for (char c : text) {
+        out += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+}
+
+bool isBoundary(char c) {
+    return c == ' ' || c == '-' || c == '_' || c == '.' || c == ';' || c == '/';
+}
+
+/**
+ * @brief 向量化位图预过滤：筛选包含查询全部字符位的应用
+ */
+void prefilter(const std::vector<uint64_t>& bitmaps, uint64_t query, std::vector<uint32_t>& candidates) {
+    const uint64_t* data = bitmaps.data();
+    size_t count = bitmaps.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i q = _mm256_set1_epi64x(static_cast<long long>(query));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i bm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        // missing = query & ~bitmap，为0表示查询字符全部出现
+        __m256i missing = _mm256_andnot_si256(bm, q);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(missing, zero)));
+        while (mask) {
+            int lane = __builtin_ctz(mask);
+            candidates.push_back(static_cast<uint32_t>(i + lane));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i q = _mm_set1_epi64x(static_cast<long long>(query));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i bm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i missing = _mm_andnot_si128(bm, q);
+        // SSE2没有64位比较，按32位比较后要求每个64位通道的8个字节全部相等
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(missing, zero));
+        if ((mask & 0x00FF) == 0x00FF) candidates.push_back(static_cast<uint32_t>(i));
+        if ((mask & 0xFF00) == 0xFF00) candidates.push_back(static_cast<uint32_t>(i + 1));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint64x2_t q = vdupq_n_u64(query);
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t bm = vld1q_u64(data + i);
+        uint64x2_t hit = vceqzq_u64(vbicq_u64(q, bm));
+        if (vgetq_lane_u64(hit, 0)) candidates.push_back(static_cast<uint32_t>(i));
+        if (vgetq_lane_u64(hit, 1)) candidates.push_back(static_cast<uint32_t>(i + 1));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if ((query & ~data[i]) == 0) {
+            candidates.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+/**
+ * @brief 模糊子序列匹配打分
+ *
+ * 依次尝试查询首字符在文本中的每个出现位置，贪心匹配其余字符，
+ * 连续匹配、单词边界和前缀匹配加分，跳过的字符扣分
+ * @param text 小写文本
+ * @param query 小写查询
+ * @param char_lengths 查询中每个字符的UTF-8字节数
+ * @return 匹配分数，不匹配返回-1
+ */
+int fuzzyScore(std::string_view text, std::string_view query, const std::vector<uint8_t>& char_lengths) {
+    if (text.size() < query.size()) return -1;
+
+    const size_t first_length = char_lengths[0];
+    int best = -1;
+    int attempts = 0;
+    for (size_t start = text.find(query.substr(0, first_length));
+         start != std::string_view::npos && attempts < 8;
+         start = text.find(query.substr(0, first_length), start + 1), ++attempts) {
+        int score = 0;
+        size_t text_pos = start;
+        size_t query_pos = 0;
+        size_t previous_end = std::string_view::npos;
+        bool matched = true;
+
+        for (uint8_t length : char_lengths) {
+            std::string_view needle = query.substr(query_pos, length);
+            size_t found = (previous_end == std::string_view::npos) ? start : text.find(needle, text_pos);
+            if (found == std::string_view::npos) {
+                matched = false;
+                break;
+            }
+
+            score += 16;
+            if (found == 0 || isBoundary(text[found - 1])) score += 20;
+            if (previous_end != std::string_view::npos) {
+                if (found == previous_end) {
+                    score += 24;
+                } else {
+                    score -= static_cast<int>(std::min<size_t>(found - previous_end, 10)) * 2;
+                }
+            }
+
+            previous_end = found + length;
+            text_pos = previous_end;
+            query_pos += length;
+        }
+        if (!matched) break;
+
+        if (start == 0) score += 40;
+        score -= static_cast<int>(std::min<size_t>(start, 15));
+        if (previous_end - start == query.size() && text.size() == query.size()) score += 100;
+        best = std::max(best, score);
+    }
+    return best;
+}
+
+} // namespace
+
+class ApplicationSearch::Impl {
+public:
+    explicit Impl(std::shared_ptr<const PinyinTable> pinyin)
+        : pinyin_(pinyin ? pinyin : std::make_shared<const PinyinTable>()) {}
+
+    void build(std::shared_ptr<const ApplicationIndexSnapshot> snapshot) {
+        snapshot_ = std::move(snapshot);
+        text_.clear();
+        forms_.clear();
+        bitmaps_.clear();
+        if (!snapshot_) return;
+
+        size_t count = snapshot_->size();
+        forms_.resize(count);
+        bitmaps_.resize(count);
+
+        std::string full;
+        std::string initials;
+        for (size_t i = 0; i < count; ++i) {
+            ApplicationEntry entry = snapshot_->entry(i);
+            full.clear();
+            initials.clear();
+            pinyin_->transliterate(entry.displayName(), full, initials);
+
+            std::string_view id = entry.id;
+            if (id.size() > 8 && id.substr(id.size() - 8) == ".desktop") {
+                id.remove_suffix(8);
+            }
+
+            std::string_view sources[FormCount] = {entry.name, entry.localized_name, full, initials, entry.keywords, id};
+            uint64_t bitmap = 0;
+            for (int form = 0; form < FormCount; ++form) {
+                size_t length = std::min<size_t>(sources[form].size(), UINT16_MAX);
+                forms_[i].offset[form] = static_cast<uint32_t>(text_.size());
+                forms_[i].length[form] = static_cast<uint16_t>(length);
+                appendLower(text_, sources[form].substr(0, length));
+                bitmap |= textBitmap(std::string_view(text_).substr(forms_[i].offset[form], length));
+            }
+            bitmaps_[i] = bitmap;
+        }
+    }
+
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot() const {
+        return snapshot_;
+    }
+
+    std::vector<SearchResult> search(const std::string& query, size_t top_k) const {
+        std::vector<SearchResult> results;
+        if (top_k == 0 || bitmaps_.empty()) return results;
+
+        // 规范化查询：转小写、去掉空白，并记录每个字符的字节数
+        std::string normalized;
+        std::vector<uint8_t> char_lengths;
+        size_t pos = 0;
+        while (pos < query.size()) {
+            size_t begin = pos;
+            char32_t code_point = decodeUtf8(query, pos);
+            if (code_point == ' ' || code_point == '\t') continue;
+            appendLower(normalized, std::string_view(query).substr(begin, pos - begin));
+            char_lengths.push_back(static_cast<uint8_t>(pos - begin));
+        }
+        if (normalized.empty()) return results;
+
+        std::vector<uint32_t> candidates;
+        candidates.reserve(bitmaps_.size());
+        prefilter(bitmaps_, textBitmap(normalized), candidates);
+
+        std::string_view text(text_);
+        for (uint32_t index : candidates) {
+            int best = -1;
+            for (int form = 0; form < FormCount; ++form) {
+                std::string_view form_text = text.substr(forms_[index].offset[form], forms_[index].length[form]);
+                int score = fuzzyScore(form_text, normalized, char_lengths);
+                if (score > 0) {
+                    best = std::max(best, score * kFormWeights[form] / 100);
+                }
+            }
+            if (best > 0) {
+                results.push_back({index, best});
+            }
+        }
+
+        auto better = [](const SearchResult& a, const SearchResult& b) {
+            return a.score != b.score ? a.score > b.score : a.index < b.index;
+        };
+        if (results.size() > top_k) {
+            std::partial_sort(results.begin(), results.begin() + top_k, results.end(), better);
+            results.resize(top_k);
+        } else {
+            std::sort(results.begin(), results.end(), better);
+        }
+        return results;
+    }
+
+private:
+    std::shared_ptr<const PinyinTable> pinyin_;
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot_;
+    std::string text_;
+    std::vector<EntryForms> forms_;
+    std::vector<uint64_t> bitmaps_;
+};
+
+// ApplicationSearch 实现
+ApplicationSearch::ApplicationSearch(std::shared_ptr<const PinyinTable> pinyin)
+    : impl_(std::make_unique<Impl>(std::move(pinyin))) {}
+
+ApplicationSearch::~ApplicationSearch() = default;
+
+void ApplicationSearch::build(std::shared_ptr<const ApplicationIndexSnapshot> snapshot) {
+    impl_->build(std::move(snapshot));
+}
+
+std::shared_ptr<const ApplicationIndexSnapshot> ApplicationSearch::snapshot() const {
+    return impl_->snapshot();
+}
+
+std::vector<SearchResult> ApplicationSearch::search(const std::string& query, size_t top_k) const {
+    return impl_->search(query, top_k);
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
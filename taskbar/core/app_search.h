@@ -0,0 +1,85 @@
+/**
+ * @file app_search.h
+ * @brief 开始菜单应用搜索头文件
+ *
+ * 在应用索引之上提供模糊搜索，支持拼音全拼和首字母匹配；
+ * 先以字符位图向量化过滤候选项，再对候选项打分并取前K个结果
+ */
+
+#ifndef CLOUDFLOW_APP_SEARCH_H
+#define CLOUDFLOW_APP_SEARCH_H
+
+#include "app_index.h"
+#include "pinyin.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct SearchResult
+ * @brief 搜索结果
+ */
+struct SearchResult {
+    uint32_t index;               ///< 应用索引快照中的下标
+    int score;                    ///< 匹配分数（越高越相关）
+};
+
+/**
+ * @class ApplicationSearch
+ * @brief 应用搜索引擎
+ *
+ * build()为每个应用预先计算名称、本地化名称、拼音全拼、拼音首字母、
+ * 关键字和ID的小写形式以及字符位图，search()只做位图过滤和候选项打分。
+ * build()与search()不能并发调用：可在后台线程中构建，完成后交给面板线程只读搜索
+ */
+class ApplicationSearch {
+public:
+    /**
+     * @brief 构造函数
+     * @param pinyin 拼音表，为空时使用内置字表
+     */
+    explicit ApplicationSearch(std::shared_ptr<const PinyinTable> pinyin = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~ApplicationSearch();
+
+    // 禁用拷贝和赋值
+    ApplicationSearch(const ApplicationSearch&) = delete;
+    ApplicationSearch& operator=(const ApplicationSearch&) = delete;
+
+    /**
+     * @brief 为索引快照构建搜索数据
+     * @param snapshot 应用索引快照
+     */
+    void build(std::shared_ptr<const ApplicationIndexSnapshot> snapshot);
+
+    /**
+     * @brief 获取当前搜索数据对应的索引快照
+     * @return 索引快照
+     */
+    std::shared_ptr<const ApplicationIndexSnapshot> snapshot() const;
+
+    /**
+     * @brief 搜索应用
+     * @param query 查询文本（UTF-8）
+     * @param top_k 最大结果数量
+     * @return 按分数降序排列的结果
+     */
+    std::vector<SearchResult> search(const std::string& query, size_t top_k) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_APP_SEARCH_H
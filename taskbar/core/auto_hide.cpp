@@ -0,0 +1,127 @@
+/**
+ * @file auto_hide.cpp
+ * @brief 任务栏自动隐藏状态机实现文件
+ */
+
+#include "auto_hide.h"
+#include <algorithm>
+#include <cmath>
+
+namespace CloudFlow {
+namespace Desktop {
+
+AutoHideController::AutoHideController()
+    : zone_(Zone::Unknown),
+      target_shown_(true),
+      pending_(false),
+      visible_fraction_(1.0),
+      animating_(false) {}
+
+void AutoHideController::configure(const AutoHideConfig& config) {
+    config_ = config;
+    zone_ = Zone::Unknown;
+}
+
+void AutoHideController::reset(bool shown) {
+    target_shown_ = shown;
+    pending_ = false;
+    animating_ = false;
+    visible_fraction_ = shown ? 1.0 : 0.0;
+    zone_ = Zone::Unknown;
+}
+
+AutoHideController::Zone AutoHideController::classify(int x, int y) const {
+    int distance = 0;
+    switch (config_.position) {
+        case TaskbarPosition::Bottom:
+            distance = config_.screen_height - 1 - y;
+            break;
+        case TaskbarPosition::Top:
+            distance = y;
+            break;
+        case TaskbarPosition::Left:
+            distance = x;
+            break;
+        case TaskbarPosition::Right:
+            distance = config_.screen_width - 1 - x;
+            break;
+    }
+
+    if (distance < config_.edge_size) return Zone::Edge;
+    if (distance < config_.thickness + config_.hysteresis) return Zone::Keep;
+    return Zone::Outside;
+}
+
+bool AutoHideController::onPointerMove(int x, int y, Clock::time_point now) {
+    Zone zone = classify(x, y);
+    if (zone == zone_) return false;
+    zone_ = zone;
+
+    bool shown = target_shown_;
+    bool wants_change = false;
+    switch (zone) {
+        case Zone::Edge:
+            wants_change = !shown;
+            break;
+        case Zone::Keep:
+            // 滞回区间：保持当前状态，取消尚未到期的切换
+            break;
+        case Zone::Outside:
+            wants_change = shown;
+            break;
+        case Zone::Unknown:
+            break;
+    }
+
+    if (!wants_change) {
+        pending_ = false;
+        return false;
+    }
+
+    pending_ = true;
+    pending_deadline_ = now + (shown ? config_.hide_delay : config_.show_delay);
+    return true;
+}
+
+bool AutoHideController::advance(Clock::time_point now) {
+    if (pending_ && now >= pending_deadline_) {
+        pending_ = false;
+        target_shown_ = !target_shown_;
+        animating_ = true;
+        last_advance_ = now;
+    }
+
+    if (animating_) {
+        double step = (config_.slide_duration.count() > 0)
+            ? std::chrono::duration<double>(now - last_advance_).count() /
+              std::chrono::duration<double>(config_.slide_duration).count()
+            : 1.0;
+        last_advance_ = now;
+
+        double target = target_shown_ ? 1.0 : 0.0;
+        visible_fraction_ = target_shown_ ? std::min(target, visible_fraction_ + step)
+                                          : std::max(target, visible_fraction_ - step);
+        animating_ = (visible_fraction_ != target);
+    }
+
+    return pending_ || animating_;
+}
+
+void AutoHideController::settle() {
+    if (pending_) {
+        pending_ = false;
+        target_shown_ = !target_shown_;
+    }
+    animating_ = false;
+    visible_fraction_ = target_shown_ ? 1.0 : 0.0;
+}
+
+int AutoHideController::offset() const {
+    // 三次缓出曲线
+    double remaining = 1.0 - visible_fraction_;
+    double eased = 1.0 - remaining * remaining * remaining;
+    return static_cast<int>(std::lround((1.0 - eased) * config_.thickness));
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
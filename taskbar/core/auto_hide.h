@@ -0,0 +1,122 @@
+/**
+ * @file auto_hide.h
+ * @brief 任务栏自动隐藏状态机头文件
+ *
+ * 以显示/隐藏延迟和滞回区间判断任务栏是否应当显示，
+ * 并按帧推进滑入滑出动画；未跨越阈值的指针移动只做一次区间比较
+ */
+
+#ifndef CLOUDFLOW_AUTO_HIDE_H
+#define CLOUDFLOW_AUTO_HIDE_H
+
+#include "taskbar.h"
+#include <chrono>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct AutoHideConfig
+ * @brief 自动隐藏参数
+ */
+struct AutoHideConfig {
+    int screen_width;                           ///< 屏幕宽度
+    int screen_height;                          ///< 屏幕高度
+    TaskbarPosition position;                   ///< 任务栏位置
+    int thickness;                              ///< 任务栏厚度（垂直于所在屏幕边缘）
+    int edge_size;                              ///< 触发显示的屏幕边缘宽度
+    int hysteresis;                             ///< 任务栏外侧保持显示的滞回宽度
+    std::chrono::milliseconds show_delay;       ///< 显示延迟
+    std::chrono::milliseconds hide_delay;       ///< 隐藏延迟
+    std::chrono::milliseconds slide_duration;   ///< 滑动动画时长
+
+    AutoHideConfig() : screen_width(1920), screen_height(1080),
+                       position(TaskbarPosition::Bottom), thickness(48),
+                       edge_size(2), hysteresis(24),
+                       show_delay(150), hide_delay(500), slide_duration(150) {}
+};
+
+/**
+ * @class AutoHideController
+ * @brief 自动隐藏状态机
+ *
+ * 指针按到屏幕边缘的距离分为边缘区、保持区（任务栏加滞回宽度）和外部区，
+ * 只有所在区间变化时才启动或取消延迟计时器：隐藏时进入边缘区才会显示，
+ * 显示时离开保持区才会隐藏。非线程安全，应在面板线程中使用
+ */
+class AutoHideController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AutoHideController();
+
+    /**
+     * @brief 设置参数（屏幕尺寸、任务栏位置或厚度变化时调用）
+     * @param config 自动隐藏参数
+     */
+    void configure(const AutoHideConfig& config);
+
+    /**
+     * @brief 获取参数
+     * @return 自动隐藏参数
+     */
+    const AutoHideConfig& config() const { return config_; }
+
+    /**
+     * @brief 立即切换到完全显示或完全隐藏，取消计时器和动画
+     * @param shown 是否显示
+     */
+    void reset(bool shown);
+
+    /**
+     * @brief 处理指针移动
+     * @param x 指针X坐标
+     * @param y 指针Y坐标
+     * @param now 当前时间
+     * @return 是否需要调度帧以推进计时器或动画
+     */
+    bool onPointerMove(int x, int y, Clock::time_point now);
+
+    /**
+     * @brief 推进计时器和动画
+     * @param now 当前时间
+     * @return 是否仍需后续帧
+     */
+    bool advance(Clock::time_point now);
+
+    /**
+     * @brief 立即完成所有待定的切换（没有帧调度时使用）
+     */
+    void settle();
+
+    /**
+     * @brief 获取任务栏滑出屏幕的像素数（0为完全显示）
+     * @return 偏移量
+     */
+    int offset() const;
+
+    /**
+     * @brief 获取任务栏是否完全隐藏
+     * @return 是否完全隐藏
+     */
+    bool isHidden() const { return visible_fraction_ <= 0.0; }
+
+private:
+    enum class Zone { Unknown, Edge, Keep, Outside };
+
+    Zone classify(int x, int y) const;
+
+    AutoHideConfig config_;
+    Zone zone_;
+    bool target_shown_;                 ///< 动画目标状态
+    bool pending_;                      ///< 是否有待定的切换
+    Clock::time_point pending_deadline_;
+    double visible_fraction_;           ///< 显示比例（0-1）
+    Clock::time_point last_advance_;
+    bool animating_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_AUTO_HIDE_H
@@ -0,0 +1,122 @@
+/**
+ * @file clock_text.cpp
+ * @brief 时钟文本缓存实现文件
+ */
+
+#include "clock_text.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+void replaceAll(std::string& text, const std::string& from, const std::string& to) {
+    for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+        text.replace(pos, from.size(), to);
+    }
+}
+
+/**
+ * @brief 判断strftime格式是否包含秒级字段
+ */
+bool hasSecondsField(const std::string& format) {
+    for (size_t i = 0; i + 1 < format.size(); ++i) {
+        if (format[i] != '%') continue;
+
+        char conversion = format[++i];
+        if ((conversion == 'E' || conversion == 'O') && i + 1 < format.size()) {
+            conversion = format[++i];
+        }
+        if (std::strchr("STrXsc", conversion)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 格式化到缓冲区
+ * @return 文本是否发生变化
+ */
+bool formatInto(char (&buffer)[64], const std::string& format, const std::tm& local) {
+    char formatted[sizeof(buffer)];
+    if (format.empty() || std::strftime(formatted, sizeof(formatted), format.c_str(), &local) == 0) {
+        formatted[0] = '\0';
+    }
+    if (std::strcmp(formatted, buffer) == 0) return false;
+    std::memcpy(buffer, formatted, sizeof(formatted));
+    return true;
+}
+
+} // namespace
+
+ClockTextCache::ClockTextCache(const ClockFormat& format) {
+    setFormat(format);
+}
+
+void ClockTextCache::setFormat(const ClockFormat& format) {
+    time_format_ = format.time_format;
+    if (!format.show_seconds) {
+        replaceAll(time_format_, ":%S", "");
+        replaceAll(time_format_, "%T", "%H:%M");
+        replaceAll(time_format_, "%r", "%I:%M %p");
+    }
+    time_period_ = hasSecondsField(time_format_) ? 1 : 60;
+    date_format_ = format.show_date ? format.date_format : std::string();
+    invalidate();
+}
+
+void ClockTextCache::invalidate() {
+    time_start_ = time_end_ = 0;
+    day_start_ = day_end_ = 0;
+    text_.time[0] = '\0';
+    text_.date[0] = '\0';
+}
+
+bool ClockTextCache::update(std::chrono::system_clock::time_point now) {
+    text_.time_point = now;
+
+    std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    bool time_stale = seconds < time_start_ || seconds >= time_end_;
+    bool date_stale = seconds < day_start_ || seconds >= day_end_;
+    if (!time_stale && !date_stale) return false;
+
+    // 只有进位（或时钟回拨）时才需要本地时间转换
+    std::tm local;
+    localtime_r(&seconds, &local);
+
+    bool changed = false;
+    if (time_stale) {
+        time_start_ = seconds - (time_period_ == 60 ? std::min(local.tm_sec, 59) : 0);
+        time_end_ = time_start_ + time_period_;
+        changed |= formatInto(text_.time, time_format_, local);
+    }
+    if (date_stale) {
+        if (date_format_.empty()) {
+            day_start_ = std::numeric_limits<std::time_t>::min();
+            day_end_ = std::numeric_limits<std::time_t>::max();
+        } else {
+            // 以本地零点为界（mktime处理夏令时切换）
+            std::tm midnight = local;
+            midnight.tm_hour = midnight.tm_min = midnight.tm_sec = 0;
+            midnight.tm_isdst = -1;
+            day_start_ = std::mktime(&midnight);
+            midnight.tm_mday += 1;
+            midnight.tm_hour = midnight.tm_min = midnight.tm_sec = 0;
+            midnight.tm_isdst = -1;
+            day_end_ = std::mktime(&midnight);
+        }
+        changed |= formatInto(text_.date, date_format_, local);
+    }
+    return changed;
+}
+
+std::chrono::system_clock::time_point ClockTextCache::nextBoundary() const {
+    return std::chrono::system_clock::from_time_t(std::min(time_end_, day_end_));
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,78 @@
+/**
+ * @file clock_text.h
+ * @brief 时钟文本缓存头文件
+ *
+ * 缓存格式化后的时间和日期文本，只在秒（或分钟）与日期进位时
+ * 重新调用localtime_r和strftime，其余时刻的更新不分配内存
+ */
+
+#ifndef CLOUDFLOW_CLOCK_TEXT_H
+#define CLOUDFLOW_CLOCK_TEXT_H
+
+#include "taskbar.h"
+#include <chrono>
+#include <ctime>
+#include <string>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @class ClockTextCache
+ * @brief 时钟文本缓存
+ *
+ * 非线程安全，调用方负责同步
+ */
+class ClockTextCache {
+public:
+    /**
+     * @brief 构造函数
+     * @param format 时钟格式
+     */
+    explicit ClockTextCache(const ClockFormat& format = ClockFormat());
+
+    /**
+     * @brief 设置时钟格式（使所有缓存文本失效）
+     * @param format 时钟格式
+     */
+    void setFormat(const ClockFormat& format);
+
+    /**
+     * @brief 使缓存文本失效（如时区变化后）
+     */
+    void invalidate();
+
+    /**
+     * @brief 更新到指定时间
+     * @param now 当前时间
+     * @return 显示文本是否发生变化
+     */
+    bool update(std::chrono::system_clock::time_point now);
+
+    /**
+     * @brief 获取缓存文本
+     * @return 时钟文本
+     */
+    const ClockText& text() const { return text_; }
+
+    /**
+     * @brief 获取下一次显示文本可能变化的时间
+     * @return 时间文本或日期文本的下一个进位时刻
+     */
+    std::chrono::system_clock::time_point nextBoundary() const;
+
+private:
+    std::string time_format_;     ///< 实际使用的时间格式（不显示秒时去掉秒字段）
+    std::string date_format_;     ///< 日期格式（不显示日期时为空）
+    std::time_t time_period_;     ///< 时间文本的更新周期（1秒或60秒）
+    std::time_t time_start_;      ///< 当前时间文本的起始时刻
+    std::time_t time_end_;        ///< 当前时间文本的结束时刻
+    std::time_t day_start_;       ///< 当前日期文本的起始时刻（本地零点）
+    std::time_t day_end_;         ///< 当前日期文本的结束时刻（次日本地零点）
+    ClockText text_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_CLOCK_TEXT_H
@@ -0,0 +1,442 @@
+/**
+ * @file config_persister.cpp
+ * @brief 任务栏配置持久化实现文件
+ */
+
+#include "config_persister.h"
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <json/json.h>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+// 任务栏高度的有效范围（像素）
+constexpr int kMinTaskbarHeight = 16;
+constexpr int kMaxTaskbarHeight = 512;
+
+// 持续有保存请求时，最长推迟为防抖间隔的倍数
+constexpr int kMaxDebounceFactor = 4;
+
+Json::Value toJson(const TaskbarConfig& config) {
+    Json::Value root;
+
+    // 外观设置
+    Json::Value appearance_obj;
+    appearance_obj["position"] = static_cast<int>(config.appearance.position);
+    appearance_obj["style"] = static_cast<int>(config.appearance.style);
+    appearance_obj["height"] = config.appearance.height;
+    appearance_obj["auto_hide"] = config.appearance.auto_hide;
+    appearance_obj["always_on_top"] = config.appearance.always_on_top;
+    appearance_obj["show_clock"] = config.appearance.show_clock;
+    appearance_obj["show_system_tray"] = config.appearance.show_system_tray;
+    appearance_obj["group_windows"] = config.appearance.group_windows;
+    root["appearance"] = appearance_obj;
+
+    // 快速启动项
+    Json::Value quick_launch_array(Json::arrayValue);
+    for (const auto& item : config.quick_launch_items) {
+        Json::Value item_obj;
+        item_obj["id"] = item.id;
+        item_obj["name"] = item.name;
+        item_obj["icon_path"] = item.icon_path;
+        item_obj["executable_path"] = item.executable_path;
+        item_obj["launch_count"] = item.launch_count;
+        quick_launch_array.append(item_obj);
+    }
+    root["quick_launch_items"] = quick_launch_array;
+
+    // 启动频度（[ID, 对数分数键]）
+    Json::Value frecency_array(Json::arrayValue);
+    for (const auto& entry : config.frecency) {
+        Json::Value entry_obj(Json::arrayValue);
+        entry_obj.append(entry.id);
+        entry_obj.append(entry.score_key);
+        frecency_array.append(entry_obj);
+    }
+    root["frecency"] = frecency_array;
+
+    // 时钟格式
+    Json::Value clock_format_obj;
+    clock_format_obj["show_date"] = config.clock_format.show_date;
+    clock_format_obj["show_seconds"] = config.clock_format.show_seconds;
+    clock_format_obj["time_format"] = config.clock_format.time_format;
+    clock_format_obj["date_format"] = config.clock_format.date_format;
+    root["clock_format"] = clock_format_obj;
+
+    return root;
+}
+
+/**
+ * @brief 读取可选字段，字段缺失时保留默认值，类型不符时失败
+ */
+bool readBool(const Json::Value& obj, const char* key, bool& out) {
+    if (!obj.isMember(key)) return true;
+    if (!obj[key].isBool()) return false;
+    out = obj[key].asBool();
+    return true;
+}
+
+bool readInt(const Json::Value& obj, const char* key, int min, int max, int& out) {
+    if (!obj.isMember(key)) return true;
+    if (!obj[key].isInt()) return false;
+    int value = obj[key].asInt();
+    if (value < min || value > max) return false;
+    out = value;
+    return true;
+}
+
+bool readString(const Json::Value& obj, const char* key, std::string& out) {
+    if (!obj.isMember(key)) return true;
+    if (!obj[key].isString()) return false;
+    out = obj[key].asString();
+    return true;
+}
+
+bool fromJson(const Json::Value& root, TaskbarConfig& config, std::string& error) {
+    if (!root.isObject()) {
+        error = "配置根节点不是对象";
+        return false;
+    }
+
+    // 外观设置
+    const Json::Value& appearance_obj = root["appearance"];
+    if (!appearance_obj.isNull()) {
+        int position = static_cast<int>(config.appearance.position);
+        int style = static_cast<int>(config.appearance.style);
+        if (!appearance_obj.isObject() ||
+            !readInt(appearance_obj, "position", 0, static_cast<int>(TaskbarPosition::Right), position) ||
+            !readInt(appearance_obj, "style", 0, static_cast<int>(TaskbarStyle::Compact), style) ||
+            !readInt(appearance_obj, "height", kMinTaskbarHeight, kMaxTaskbarHeight, config.appearance.height) ||
+            !readBool(appearance_obj, "auto_hide", config.appearance.auto_hide) ||
+            !readBool(appearance_obj, "always_on_top", config.appearance.always_on_top) ||
+            !readBool(appearance_obj, "show_clock", config.appearance.show_clock) ||
+            !readBool(appearance_obj, "show_system_tray", config.appearance.show_system_tray) ||
+            !readBool(appearance_obj, "group_windows", config.appearance.group_windows)) {
+            error = "外观设置无效";
+            return false;
+        }
+        config.appearance.position = static_cast<TaskbarPosition>(position);
+        config.appearance.style = static_cast<TaskbarStyle>(style);
+    }
+
+    // 快速启动项（ID不能为空或重复）
+    const Json::Value& quick_launch_array = root["quick_launch_items"];
+    if (!quick_launch_array.isNull()) {
+        if (!quick_launch_array.isArray()) {
+            error = "快速启动项不是数组";
+            return false;
+        }
+        std::set<std::string> ids;
+        for (const auto& item_obj : quick_launch_array) {
+            QuickLaunchItem item;
+            if (!item_obj.isObject() ||
+                !readString(item_obj, "id", item.id) ||
+                !readString(item_obj, "name", item.name) ||
+                !readString(item_obj, "icon_path", item.icon_path) ||
+                !readString(item_obj, "executable_path", item.executable_path) ||
+                !readInt(item_obj, "launch_count", 0, INT32_MAX, item.launch_count) ||
+                item.id.empty() || !ids.insert(item.id).second) {
+                error = "快速启动项无效";
+                return false;
+            }
+            config.quick_launch_items.push_back(item);
+        }
+    }
+
+    // 启动频度
+    const Json::Value& frecency_array = root["frecency"];
+    if (!frecency_array.isNull()) {
+        if (!frecency_array.isArray()) {
+            error = "启动频度不是数组";
+            return false;
+        }
+        for (const auto& entry_obj : frecency_array) {
+            if (!entry_obj.isArray() || entry_obj.size() != 2 ||
+                !entry_obj[0].isString() || !entry_obj[1].isNumeric() ||
+                !std::isfinite(entry_obj[1].asDouble())) {
+                error = "启动频度记录无效";
+                return false;
+            }
+            FrecencyEntry entry;
+            entry.id = entry_obj[0].asString();
+            entry.score_key = entry_obj[1].asDouble();
+            config.frecency.push_back(entry);
+        }
+    }
+
+    // 时钟格式（时间格式不能为空）
+    const Json::Value& clock_format_obj = root["clock_format"];
+    if (!clock_format_obj.isNull()) {
+        if (!clock_format_obj.isObject() ||
+            !readBool(clock_format_obj, "show_date", config.clock_format.show_date) ||
+            !readBool(clock_format_obj, "show_seconds", config.clock_format.show_seconds) ||
+            !readString(clock_format_obj, "time_format", config.clock_format.time_format) ||
+            !readString(clock_format_obj, "date_format", config.clock_format.date_format) ||
+            config.clock_format.time_format.empty()) {
+            error = "时钟格式无效";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+/**
+ * @brief 同步文件所在目录，使rename本身也落盘
+ */
+void syncDirectory(const std::string& path) {
+    size_t slash = path.rfind('/');
+    std::string directory = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+} // namespace
+
+// ConfigPersister 实现类
+class ConfigPersister::Impl {
+public:
+    explicit Impl(std::chrono::milliseconds debounce)
+        : debounce_(debounce),
+          running_(false),
+          writing_(false),
+          flush_requested_(false),
+          last_write_ok_(true),
+          write_count_(0),
+          coalesced_count_(0) {}
+
+    ~Impl() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    void schedule(const std::string& config_path, TaskbarConfig config) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = std::chrono::steady_clock::now();
+            if (pending_.empty()) {
+                first_request_ = now;
+            }
+            // 每个路径保留一份待写入的快照，同一路径的新请求覆盖旧请求
+            auto result = pending_.insert_or_assign(config_path, std::move(config));
+            if (!result.second) {
+                coalesced_count_++;
+            }
+            deadline_ = std::min(now + debounce_, first_request_ + debounce_ * kMaxDebounceFactor);
+
+            if (!running_) {
+                running_ = true;
+                thread_ = std::thread([this]() { run(); });
+            }
+        }
+        cv_.notify_all();
+    }
+
+    bool flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_) return last_write_ok_;
+
+        flush_requested_ = !pending_.empty();
+        cv_.notify_all();
+        done_cv_.wait(lock, [this]() { return pending_.empty() && !writing_; });
+        return last_write_ok_;
+    }
+
+    uint64_t getWriteCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return write_count_;
+    }
+
+    uint64_t getCoalescedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return coalesced_count_;
+    }
+
+    std::string getLastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_error_;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return !pending_.empty() || !running_; });
+            if (pending_.empty()) break;
+
+            // 等到防抖截止时间，期间的新请求会推后截止时间
+            while (running_ && !flush_requested_ && std::chrono::steady_clock::now() < deadline_) {
+                cv_.wait_until(lock, deadline_);
+            }
+
+            // 取出快照后释放锁，写入期间新的请求不会被阻塞
+            std::map<std::string, TaskbarConfig> configs;
+            configs.swap(pending_);
+            flush_requested_ = false;
+            writing_ = true;
+            lock.unlock();
+
+            bool ok = true;
+            std::string error;
+            for (const auto& entry : configs) {
+                std::string write_error;
+                if (!ConfigPersister::write(entry.first, entry.second, write_error)) {
+                    ok = false;
+                    error = write_error;
+                }
+            }
+
+            lock.lock();
+            writing_ = false;
+            write_count_ += configs.size();
+            last_write_ok_ = ok;
+            if (!ok) {
+                last_error_ = error;
+            }
+            done_cv_.notify_all();
+        }
+    }
+
+    const std::chrono::milliseconds debounce_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    std::thread thread_;
+    bool running_;
+
+    bool writing_;
+    bool flush_requested_;
+    std::map<std::string, TaskbarConfig> pending_;
+    std::chrono::steady_clock::time_point first_request_;
+    std::chrono::steady_clock::time_point deadline_;
+
+    bool last_write_ok_;
+    uint64_t write_count_;
+    uint64_t coalesced_count_;
+    std::string last_error_;
+};
+
+// ConfigPersister 实现
+ConfigPersister::ConfigPersister(std::chrono::milliseconds debounce)
+    : impl_(std::make_unique<Impl>(debounce)) {}
+
+ConfigPersister::~ConfigPersister() = default;
+
+void ConfigPersister::schedule(const std::string& config_path, TaskbarConfig config) {
+    impl_->schedule(config_path, std::move(config));
+}
+
+bool ConfigPersister::flush() {
+    return impl_->flush();
+}
+
+uint64_t ConfigPersister::getWriteCount() const {
+    return impl_->getWriteCount();
+}
+
+uint64_t ConfigPersister::getCoalescedCount() const {
+    return impl_->getCoalescedCount();
+}
+
+std::string ConfigPersister::getLastError() const {
+    return impl_->getLastError();
+}
+
+bool ConfigPersister::write(const std::string& config_path, const TaskbarConfig& config, std::string& error) {
+    std::string data;
+    try {
+        Json::StreamWriterBuilder builder;
+        data = Json::writeString(builder, toJson(config));
+    } catch (const std::exception& e) {
+        error = std::string("保存配置失败: ") + e.what();
+        return false;
+    }
+
+    return writeFile(config_path, data, error);
+}
+
+bool ConfigPersister::writeFile(const std::string& path, const std::string& data, std::string& error) {
+    // 先完整写入同目录下的临时文件，再原子替换；临时文件名唯一，
+    // 同一路径的并发写入不会互相截断对方的临时文件
+    std::string temp_path = path + ".XXXXXX";
+    int fd = mkostemp(&temp_path[0], O_CLOEXEC);
+    if (fd < 0) {
+        error = "无法创建临时文件: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    bool ok = fchmod(fd, 0644) == 0 && writeAll(fd, data) && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        error = "写入文件失败: " + path + " (" + std::strerror(errno) + ")";
+        unlink(temp_path.c_str());
+        return false;
+    }
+    syncDirectory(path);
+    return true;
+}
+
+bool ConfigPersister::read(const std::string& config_path, TaskbarConfig& config, std::string& error) {
+    std::ifstream file(config_path);
+    if (!file.is_open()) {
+        error = "无法打开配置文件: " + config_path;
+        return false;
+    }
+
+    Json::CharReaderBuilder builder;
+    Json::Value root;
+    std::string parse_error;
+    if (!Json::parseFromStream(builder, file, &root, &parse_error)) {
+        error = "解析配置文件失败: " + parse_error;
+        return false;
+    }
+
+    // 先解析到暂存区，全部有效后才交给调用方
+    TaskbarConfig staging;
+    if (!fromJson(root, staging, error)) {
+        error = "加载配置失败: " + error;
+        return false;
+    }
+    config = std::move(staging);
+    return true;
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,125 @@
+/**
+ * @file config_persister.h
+ * @brief 任务栏配置持久化头文件
+ *
+ * 面板线程只复制一份配置快照，JSON序列化和磁盘写入在后台线程中进行。
+ * 连续的保存请求在防抖间隔内合并为一次写入；写入先写临时文件并fsync，
+ * 再通过rename原子替换，中途崩溃不会留下半个配置文件
+ */
+
+#ifndef CLOUDFLOW_CONFIG_PERSISTER_H
+#define CLOUDFLOW_CONFIG_PERSISTER_H
+
+#include "taskbar.h"
+#include "frecency.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct TaskbarConfig
+ * @brief 任务栏配置（保存时的快照，加载时的暂存区）
+ */
+struct TaskbarConfig {
+    TaskbarAppearance appearance;                    ///< 外观设置
+    std::vector<QuickLaunchItem> quick_launch_items; ///< 快速启动项
+    std::vector<FrecencyEntry> frecency;             ///< 启动频度
+    ClockFormat clock_format;                        ///< 时钟格式
+};
+
+/**
+ * @class ConfigPersister
+ * @brief 后台配置写入器（线程安全）
+ */
+class ConfigPersister {
+public:
+    /**
+     * @brief 构造函数
+     * @param debounce 防抖间隔，最后一次保存请求之后经过该时间才写入；
+     *                 持续有请求时最迟在首个请求之后4倍间隔写入
+     */
+    explicit ConfigPersister(std::chrono::milliseconds debounce = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief 析构函数，写入尚未保存的配置并停止后台线程
+     */
+    ~ConfigPersister();
+
+    // 禁用拷贝和赋值
+    ConfigPersister(const ConfigPersister&) = delete;
+    ConfigPersister& operator=(const ConfigPersister&) = delete;
+
+    /**
+     * @brief 请求保存配置（不等待写入）
+     * @param config_path 配置文件路径
+     * @param config 配置快照，覆盖同一路径尚未写入的上一次请求（不同路径的请求各自写入）
+     */
+    void schedule(const std::string& config_path, TaskbarConfig config);
+
+    /**
+     * @brief 立即写入尚未保存的配置并等待完成
+     * @return 最近一次写入是否成功
+     */
+    bool flush();
+
+    /**
+     * @brief 获取实际写入次数
+     * @return 写入次数
+     */
+    uint64_t getWriteCount() const;
+
+    /**
+     * @brief 获取被后续请求合并掉的保存请求数量
+     * @return 合并次数
+     */
+    uint64_t getCoalescedCount() const;
+
+    /**
+     * @brief 获取最近一次写入的错误信息
+     * @return 错误描述
+     */
+    std::string getLastError() const;
+
+    /**
+     * @brief 同步写入配置文件（临时文件 + fsync + rename）
+     * @param config_path 配置文件路径
+     * @param config 配置
+     * @param error 失败时的错误描述
+     * @return 写入是否成功
+     */
+    static bool write(const std::string& config_path, const TaskbarConfig& config, std::string& error);
+
+    /**
+     * @brief 原子写入文件（同目录临时文件 + fsync + rename，并同步所在目录）
+     * @param path 文件路径
+     * @param data 文件内容
+     * @param error 失败时的错误描述
+     * @return 写入是否成功
+     */
+    static bool writeFile(const std::string& path, const std::string& data, std::string& error);
+
+    /**
+     * @brief 读取并校验配置文件
+     *
+     * 任一字段无效时整体失败，config保持不变
+     * @param config_path 配置文件路径
+     * @param config 读取结果
+     * @param error 失败时的错误描述
+     * @return 读取是否成功
+     */
+    static bool read(const std::string& config_path, TaskbarConfig& config, std::string& error);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_CONFIG_PERSISTER_H
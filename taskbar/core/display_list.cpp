@@ -0,0 +1,109 @@
+/**
+ * @file display_list.cpp
+ * @brief 任务栏显示列表实现文件
+ */
+
+#include "display_list.h"
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+constexpr uint8_t kActiveFlag = 0x1;
+constexpr uint8_t kMinimizedFlag = 0x2;
+
+} // namespace
+
+// DisplayList 实现
+void DisplayList::clear() {
+    commands_.clear();
+    quick_launch_items_.clear();
+    tray_items_.clear();
+    window_items_.clear();
+    window_groups_.clear();
+    window_group_titles_.clear();
+    viewports_.clear();
+}
+
+void DisplayList::replay(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) const {
+    for (const Command& command : commands_) {
+        bool is_active = (command.flags & kActiveFlag) != 0;
+        bool is_minimized = (command.flags & kMinimizedFlag) != 0;
+        switch (command.op) {
+            case Op::Background:
+                renderer.renderBackground(appearance);
+                break;
+            case Op::StartMenuButton:
+                renderer.renderStartMenuButton(appearance, is_active);
+                break;
+            case Op::QuickLaunchItem:
+                renderer.renderQuickLaunchItem(quick_launch_items_[command.index], appearance);
+                break;
+            case Op::WindowListItem: {
+                const auto& window = window_items_[command.index];
+                renderer.renderWindowListItem(window.first, window.second, is_active, is_minimized, appearance);
+                break;
+            }
+            case Op::WindowGroupItem:
+                renderer.renderWindowGroupItem(window_groups_[command.index], window_group_titles_[command.index],
+                                               is_active, is_minimized, appearance);
+                break;
+            case Op::SystemTrayItem:
+                renderer.renderSystemTrayItem(tray_items_[command.index], appearance);
+                break;
+            case Op::WindowListOverflow:
+                renderer.renderWindowListOverflow(viewports_[command.index], appearance);
+                break;
+        }
+    }
+}
+
+// DisplayListRecorder 实现
+void DisplayListRecorder::append(DisplayList::Op op, bool is_active, bool is_minimized, size_t index) {
+    DisplayList::Command command;
+    command.op = op;
+    command.flags = static_cast<uint8_t>((is_active ? kActiveFlag : 0) | (is_minimized ? kMinimizedFlag : 0));
+    command.index = static_cast<uint32_t>(index);
+    list_.commands_.push_back(command);
+}
+
+void DisplayListRecorder::renderBackground(const TaskbarAppearance&) {
+    append(DisplayList::Op::Background, false, false, 0);
+}
+
+void DisplayListRecorder::renderStartMenuButton(const TaskbarAppearance&, bool is_active) {
+    append(DisplayList::Op::StartMenuButton, is_active, false, 0);
+}
+
+void DisplayListRecorder::renderQuickLaunchItem(const QuickLaunchItem& item, const TaskbarAppearance&) {
+    append(DisplayList::Op::QuickLaunchItem, false, false, list_.quick_launch_items_.size());
+    list_.quick_launch_items_.push_back(item);
+}
+
+void DisplayListRecorder::renderWindowListItem(const std::string& window_id, const std::string& window_title,
+                                               bool is_active, bool is_minimized, const TaskbarAppearance&) {
+    append(DisplayList::Op::WindowListItem, is_active, is_minimized, list_.window_items_.size());
+    list_.window_items_.emplace_back(window_id, window_title);
+}
+
+void DisplayListRecorder::renderSystemTrayItem(const SystemTrayItem& item, const TaskbarAppearance&) {
+    append(DisplayList::Op::SystemTrayItem, false, false, list_.tray_items_.size());
+    list_.tray_items_.push_back(item);
+}
+
+void DisplayListRecorder::renderWindowGroupItem(const WindowGroup& group, const std::string& window_title,
+                                                bool is_active, bool is_minimized, const TaskbarAppearance&) {
+    // 分组与其标题共用同一下标
+    append(DisplayList::Op::WindowGroupItem, is_active, is_minimized, list_.window_groups_.size());
+    list_.window_groups_.push_back(group);
+    list_.window_group_titles_.push_back(window_title);
+}
+
+void DisplayListRecorder::renderWindowListOverflow(const WindowListViewport& viewport, const TaskbarAppearance&) {
+    append(DisplayList::Op::WindowListOverflow, false, false, list_.viewports_.size());
+    list_.viewports_.push_back(viewport);
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,201 @@
+/**
+ * @file display_list.h
+ * @brief 任务栏显示列表头文件
+ *
+ * 将组件的渲染器调用录制为紧凑的命令列表，组件输入的哈希未变化时
+ * 直接回放（或交给渲染器复用），只有输入变化的组件才重新录制
+ */
+
+#ifndef CLOUDFLOW_DISPLAY_LIST_H
+#define CLOUDFLOW_DISPLAY_LIST_H
+
+#include "taskbar.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @class DisplayList
+ * @brief 显示列表
+ *
+ * 命令只记录操作码和参数下标，参数按类型存放在各自的数组中
+ */
+class DisplayList {
+public:
+    /**
+     * @brief 命令操作码
+     */
+    enum class Op : uint8_t {
+        Background,         ///< renderBackground
+        StartMenuButton,    ///< renderStartMenuButton
+        QuickLaunchItem,    ///< renderQuickLaunchItem
+        WindowListItem,     ///< renderWindowListItem
+        WindowGroupItem,    ///< renderWindowGroupItem
+        SystemTrayItem,     ///< renderSystemTrayItem
+        WindowListOverflow  ///< renderWindowListOverflow
+    };
+
+    /**
+     * @brief 命令
+     */
+    struct Command {
+        Op op;              ///< 操作码
+        uint8_t flags;      ///< 标志（bit0为激活，bit1为最小化）
+        uint32_t index;     ///< 参数在对应数组中的下标
+    };
+
+    /**
+     * @brief 清空列表（保留已分配的容量）
+     */
+    void clear();
+
+    /**
+     * @brief 获取命令数量
+     * @return 命令数量
+     */
+    size_t size() const { return commands_.size(); }
+
+    /**
+     * @brief 获取命令列表
+     * @return 命令列表
+     */
+    const std::vector<Command>& commands() const { return commands_; }
+
+    /**
+     * @brief 向渲染器回放列表
+     * @param renderer 目标渲染器
+     * @param appearance 外观设置
+     */
+    void replay(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) const;
+
+    /**
+     * @brief 获取命令参数
+     */
+    const QuickLaunchItem& quickLaunchItem(const Command& command) const { return quick_launch_items_[command.index]; }
+    const SystemTrayItem& systemTrayItem(const Command& command) const { return tray_items_[command.index]; }
+    const std::pair<std::string, std::string>& windowItem(const Command& command) const { return window_items_[command.index]; }
+    const WindowGroup& windowGroup(const Command& command) const { return window_groups_[command.index]; }
+    const std::string& windowGroupTitle(const Command& command) const { return window_group_titles_[command.index]; }
+    const WindowListViewport& windowListViewport(const Command& command) const { return viewports_[command.index]; }
+
+private:
+    friend class DisplayListRecorder;
+
+    std::vector<Command> commands_;
+    std::vector<QuickLaunchItem> quick_launch_items_;
+    std::vector<SystemTrayItem> tray_items_;
+    std::vector<std::pair<std::string, std::string>> window_items_;  ///< (窗口ID, 窗口标题)
+    std::vector<WindowGroup> window_groups_;
+    std::vector<std::string> window_group_titles_;
+    std::vector<WindowListViewport> viewports_;
+};
+
+/**
+ * @class DisplayListRecorder
+ * @brief 录制渲染器调用的渲染器
+ *
+ * 只录制组件内容的调用；时钟、预览和开始菜单等不缓存的调用被忽略
+ */
+class DisplayListRecorder : public ITaskbarRenderer {
+public:
+    /**
+     * @brief 构造函数
+     * @param list 目标显示列表（录制前应先清空）
+     */
+    explicit DisplayListRecorder(DisplayList& list) : list_(list) {}
+
+    void renderBackground(const TaskbarAppearance& appearance) override;
+    void renderStartMenuButton(const TaskbarAppearance& appearance, bool is_active) override;
+    void renderQuickLaunchItem(const QuickLaunchItem& item, const TaskbarAppearance& appearance) override;
+    void renderWindowListItem(const std::string& window_id, const std::string& window_title,
+                              bool is_active, bool is_minimized, const TaskbarAppearance& appearance) override;
+    void renderSystemTrayItem(const SystemTrayItem& item, const TaskbarAppearance& appearance) override;
+    void renderWindowGroupItem(const WindowGroup& group, const std::string& window_title,
+                               bool is_active, bool is_minimized, const TaskbarAppearance& appearance) override;
+    void renderWindowListOverflow(const WindowListViewport& viewport, const TaskbarAppearance& appearance) override;
+    void renderClock(const std::chrono::system_clock::time_point& /*current_time*/,
+                     const ClockFormat& /*format*/, const TaskbarAppearance& /*appearance*/) override {}
+    std::pair<int, int> getTaskbarSize(const TaskbarAppearance& /*appearance*/) override { return {0, 0}; }
+
+private:
+    void append(DisplayList::Op op, bool is_active, bool is_minimized, size_t index);
+
+    DisplayList& list_;
+};
+
+/**
+ * @brief 组件数量（TaskbarComponent的枚举值个数）
+ */
+constexpr size_t kTaskbarComponentCount = static_cast<size_t>(TaskbarComponent::Background) + 1;
+
+/**
+ * @struct DisplayListCache
+ * @brief 单个输出的组件显示列表缓存
+ */
+struct DisplayListCache {
+    struct Entry {
+        uint64_t input_hash;    ///< 录制时的组件输入哈希
+        bool valid;             ///< 是否已录制
+        DisplayList list;       ///< 显示列表
+
+        Entry() : input_hash(0), valid(false) {}
+    };
+
+    Entry entries[kTaskbarComponentCount];
+
+    /**
+     * @brief 使所有组件失效
+     */
+    void invalidate() {
+        for (auto& entry : entries) {
+            entry.valid = false;
+        }
+    }
+};
+
+/**
+ * @class InputHasher
+ * @brief 组件输入哈希（64位FNV-1a）
+ */
+class InputHasher {
+public:
+    InputHasher() : hash_(14695981039346656037ULL) {}
+
+    InputHasher& add(const std::string& text) {
+        add(static_cast<uint64_t>(text.size()));
+        for (unsigned char c : text) {
+            mix(c);
+        }
+        return *this;
+    }
+
+    InputHasher& add(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            mix(static_cast<unsigned char>(value >> (i * 8)));
+        }
+        return *this;
+    }
+
+    InputHasher& add(bool value) {
+        mix(value ? 1 : 0);
+        return *this;
+    }
+
+    uint64_t value() const { return hash_; }
+
+private:
+    void mix(unsigned char byte) {
+        hash_ = (hash_ ^ byte) * 1099511628211ULL;
+    }
+
+    uint64_t hash_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_DISPLAY_LIST_H
@@ -0,0 +1,136 @@
+/**
+ * @file frecency.cpp
+ * @brief 启动频度（frecency）排序器实现文件
+ */
+
+#include "frecency.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <set>
+#include <unordered_map>
+
+namespace CloudFlow {
+namespace Desktop {
+
+class FrecencyRanker::Impl {
+public:
+    explicit Impl(double half_life_hours)
+        : half_life_hours_(half_life_hours > 0 ? half_life_hours : 1.0) {}
+
+    void recordLaunch(const std::string& id, std::chrono::system_clock::time_point time) {
+        double reference = referenceOf(time);
+
+        // 将已有分数衰减到当前时间桶后加1，再换算回对数键
+        double score = 1.0;
+        auto it = keys_.find(id);
+        if (it != keys_.end()) {
+            score += std::exp2(it->second - reference);
+        }
+        update(id, std::log2(score) + reference);
+    }
+
+    double getScore(const std::string& id, std::chrono::system_clock::time_point time) const {
+        auto it = keys_.find(id);
+        if (it == keys_.end()) return 0.0;
+        return std::exp2(it->second - referenceOf(time));
+    }
+
+    std::vector<std::string> getRanked(size_t limit) const {
+        size_t count = (limit == 0) ? ranked_.size() : std::min(limit, ranked_.size());
+        std::vector<std::string> ids;
+        ids.reserve(count);
+        for (auto it = ranked_.begin(); it != ranked_.end() && ids.size() < count; ++it) {
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+
+    void remove(const std::string& id) {
+        auto it = keys_.find(id);
+        if (it == keys_.end()) return;
+
+        ranked_.erase({it->second, id});
+        keys_.erase(it);
+    }
+
+    void clear() {
+        keys_.clear();
+        ranked_.clear();
+    }
+
+    std::vector<FrecencyEntry> exportEntries() const {
+        std::vector<FrecencyEntry> entries;
+        entries.reserve(ranked_.size());
+        for (const auto& ranked : ranked_) {
+            FrecencyEntry entry;
+            entry.id = ranked.second;
+            entry.score_key = ranked.first;
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    void importEntry(const FrecencyEntry& entry) {
+        update(entry.id, entry.score_key);
+    }
+
+private:
+    double referenceOf(std::chrono::system_clock::time_point time) const {
+        // 按小时分桶，同一小时内的启动使用相同的衰减基准
+        auto bucket = std::chrono::duration_cast<std::chrono::hours>(time.time_since_epoch()).count();
+        return static_cast<double>(bucket) / half_life_hours_;
+    }
+
+    void update(const std::string& id, double key) {
+        auto it = keys_.find(id);
+        if (it != keys_.end()) {
+            ranked_.erase({it->second, id});
+            it->second = key;
+        } else {
+            keys_.emplace(id, key);
+        }
+        ranked_.emplace(key, id);
+    }
+
+    const double half_life_hours_;
+    std::unordered_map<std::string, double> keys_;
+    std::set<std::pair<double, std::string>, std::greater<std::pair<double, std::string>>> ranked_;
+};
+
+// FrecencyRanker 实现
+FrecencyRanker::FrecencyRanker(double half_life_hours)
+    : impl_(std::make_unique<Impl>(half_life_hours)) {}
+
+FrecencyRanker::~FrecencyRanker() = default;
+
+void FrecencyRanker::recordLaunch(const std::string& id, std::chrono::system_clock::time_point time) {
+    impl_->recordLaunch(id, time);
+}
+
+double FrecencyRanker::getScore(const std::string& id, std::chrono::system_clock::time_point time) const {
+    return impl_->getScore(id, time);
+}
+
+std::vector<std::string> FrecencyRanker::getRanked(size_t limit) const {
+    return impl_->getRanked(limit);
+}
+
+void FrecencyRanker::remove(const std::string& id) {
+    impl_->remove(id);
+}
+
+void FrecencyRanker::clear() {
+    impl_->clear();
+}
+
+std::vector<FrecencyEntry> FrecencyRanker::exportEntries() const {
+    return impl_->exportEntries();
+}
+
+void FrecencyRanker::importEntry(const FrecencyEntry& entry) {
+    impl_->importEntry(entry);
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
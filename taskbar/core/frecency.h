@@ -0,0 +1,114 @@
+/**
+ * @file frecency.h
+ * @brief 启动频度（frecency）排序器头文件
+ *
+ * 按指数衰减的启动分数对快速启动项和开始菜单项排序，
+ * 每次启动增量更新，排序视图的维护代价为O(log n)
+ */
+
+#ifndef CLOUDFLOW_FRECENCY_H
+#define CLOUDFLOW_FRECENCY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct FrecencyEntry
+ * @brief 频度记录（用于持久化）
+ *
+ * score_key为以时间桶为基准的对数分数：log2(分数) + 时间桶 / 半衰期，
+ * 其大小顺序不随时间变化，因此无需随时间重新排序
+ */
+struct FrecencyEntry {
+    std::string id;               ///< 项目ID
+    double score_key;             ///< 对数分数键
+
+    FrecencyEntry() : score_key(0.0) {}
+};
+
+/**
+ * @class FrecencyRanker
+ * @brief 启动频度排序器
+ *
+ * 时间按小时分桶，每次启动在当前时间桶上为分数加1，
+ * 分数每经过一个半衰期减半
+ */
+class FrecencyRanker {
+public:
+    /**
+     * @brief 构造函数
+     * @param half_life_hours 半衰期（小时）
+     */
+    explicit FrecencyRanker(double half_life_hours = 7 * 24);
+
+    /**
+     * @brief 析构函数
+     */
+    ~FrecencyRanker();
+
+    // 禁用拷贝和赋值
+    FrecencyRanker(const FrecencyRanker&) = delete;
+    FrecencyRanker& operator=(const FrecencyRanker&) = delete;
+
+    /**
+     * @brief 记录一次启动
+     * @param id 项目ID
+     * @param time 启动时间
+     */
+    void recordLaunch(const std::string& id,
+                      std::chrono::system_clock::time_point time = std::chrono::system_clock::now());
+
+    /**
+     * @brief 获取项目在指定时刻的衰减分数
+     * @param id 项目ID
+     * @param time 计算时刻
+     * @return 衰减分数，未启动过返回0
+     */
+    double getScore(const std::string& id,
+                    std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) const;
+
+    /**
+     * @brief 获取按频度降序排列的项目ID
+     * @param limit 最大数量，0表示不限制
+     * @return 项目ID列表
+     */
+    std::vector<std::string> getRanked(size_t limit = 0) const;
+
+    /**
+     * @brief 移除项目记录
+     * @param id 项目ID
+     */
+    void remove(const std::string& id);
+
+    /**
+     * @brief 清空所有记录
+     */
+    void clear();
+
+    /**
+     * @brief 导出所有记录
+     * @return 频度记录列表
+     */
+    std::vector<FrecencyEntry> exportEntries() const;
+
+    /**
+     * @brief 导入一条记录（覆盖同ID记录）
+     * @param entry 频度记录
+     */
+    void importEntry(const FrecencyEntry& entry);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_FRECENCY_H
@@ -0,0 +1,343 @@
+/**
+ * @file launch_helper.cpp
+ * @brief 应用启动辅助进程实现文件
+ */
+
+#include "launch_helper.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+// 请求包：uint32参数个数 + 以NUL结尾的参数（第一个为可执行文件）
+constexpr size_t kMaxRequestSize = 16384;
+constexpr uint32_t kMaxArguments = 256;
+constexpr int kReplyTimeoutMs = 2000;
+
+/**
+ * @brief 应答包
+ */
+struct LaunchReply {
+    int32_t pid;
+    int32_t error;
+    uint64_t spawn_ns;
+};
+
+uint64_t monotonicNanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief 应用进程的spawn属性：恢复默认信号处置、清空信号掩码并放入独立进程组
+ */
+void initSpawnAttributes(posix_spawnattr_t* attr) {
+    sigset_t empty;
+    sigset_t defaults;
+    sigemptyset(&empty);
+    sigemptyset(&defaults);
+    sigaddset(&defaults, SIGCHLD);
+    sigaddset(&defaults, SIGPIPE);
+
+    posix_spawnattr_init(attr);
+    posix_spawnattr_setsigmask(attr, &empty);
+    posix_spawnattr_setsigdefault(attr, &defaults);
+    posix_spawnattr_setpgroup(attr, 0);
+    posix_spawnattr_setflags(attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETPGROUP);
+}
+
+/**
+ * @brief 辅助进程主循环
+ *
+ * fork自多线程进程，因此只使用系统调用和栈上缓冲区，不分配堆内存
+ */
+[[noreturn]] void helperMain(int fd) {
+    prctl(PR_SET_NAME, "cloudflow-launch", 0, 0, 0);
+
+    // 只保留与任务栏通信的套接字，其余继承的描述符全部关闭
+    if (fd != 3) {
+        dup3(fd, 3, O_CLOEXEC);
+        close(fd);
+        fd = 3;
+    }
+#ifdef SYS_close_range
+    if (syscall(SYS_close_range, 4U, ~0U, 0U) != 0)
+#endif
+    {
+        long max_fd = sysconf(_SC_OPEN_MAX);
+        for (long i = 4; i < max_fd && i < 65536; ++i) {
+            close(static_cast<int>(i));
+        }
+    }
+
+    // 忽略SIGCHLD使应用进程退出后被自动回收
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = SIG_IGN;
+    sigaction(SIGCHLD, &action, nullptr);
+    sigaction(SIGPIPE, &action, nullptr);
+
+    sigset_t empty;
+    sigemptyset(&empty);
+    sigprocmask(SIG_SETMASK, &empty, nullptr);
+
+    posix_spawnattr_t attr;
+    initSpawnAttributes(&attr);
+
+    char buffer[kMaxRequestSize + 1];
+    char* argv[kMaxArguments + 1];
+    while (true) {
+        ssize_t length = recv(fd, buffer, kMaxRequestSize, 0);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) _exit(0);   // 任务栏已关闭连接
+        buffer[length] = '\0';
+
+        LaunchReply reply = {-1, EINVAL, 0};
+        uint32_t argc = 0;
+        if (static_cast<size_t>(length) > sizeof(argc)) {
+            std::memcpy(&argc, buffer, sizeof(argc));
+        }
+
+        // 解析参数指针，均指向接收缓冲区
+        char* cursor = buffer + sizeof(argc);
+        char* end = buffer + length;
+        uint32_t parsed = 0;
+        while (parsed < argc && parsed < kMaxArguments && cursor < end) {
+            argv[parsed++] = cursor;
+            cursor += std::strlen(cursor) + 1;
+        }
+        argv[parsed] = nullptr;
+
+        if (argc > 0 && parsed == argc) {
+            pid_t pid = -1;
+            uint64_t start = monotonicNanoseconds();
+            int result = posix_spawnp(&pid, argv[0], nullptr, &attr, argv, environ);
+            reply.spawn_ns = monotonicNanoseconds() - start;
+            reply.pid = (result == 0) ? pid : -1;
+            reply.error = result;
+        }
+        send(fd, &reply, sizeof(reply), MSG_NOSIGNAL);
+    }
+}
+
+} // namespace
+
+class LaunchHelper::Impl {
+public:
+    Impl() : fd_(-1), pid_(-1) {}
+
+    ~Impl() {
+        stop();
+    }
+
+    bool start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return startLocked();
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopLocked(true);
+    }
+
+    bool isRunning() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return fd_ >= 0;
+    }
+
+    LaunchResult launch(const std::string& executable, const std::vector<std::string>& arguments) {
+        uint64_t start = monotonicNanoseconds();
+        LaunchResult result;
+        if (executable.empty()) {
+            result.error = EINVAL;
+            return result;
+        }
+
+        std::string request(sizeof(uint32_t), '\0');
+        uint32_t argc = static_cast<uint32_t>(arguments.size() + 1);
+        std::memcpy(&request[0], &argc, sizeof(argc));
+        request.append(executable).push_back('\0');
+        for (const auto& argument : arguments) {
+            request.append(argument).push_back('\0');
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // 辅助进程意外退出后不再重新fork（此时fork当前进程代价很高），直接退回本进程启动
+            if (fd_ >= 0 && request.size() <= kMaxRequestSize && argc <= kMaxArguments) {
+                LaunchReply reply;
+                bool sent = false;
+                if (roundTrip(request, reply, sent)) {
+                    result.via_helper = true;
+                    result.success = (reply.pid > 0);
+                    result.pid = reply.pid;
+                    result.error = reply.error;
+                    result.spawn_ns = reply.spawn_ns;
+                    result.total_ns = monotonicNanoseconds() - start;
+                    return result;
+                }
+                int error = errno;
+                last_error_ = std::string("启动辅助进程无响应: ") + std::strerror(error);
+                stopLocked(false);
+                
+                // 请求已送达时辅助进程可能已经启动了应用，不在本进程中重试，避免启动两次
+                if (sent) {
+                    result.via_helper = true;
+                    result.error = error;
+                    result.total_ns = monotonicNanoseconds() - start;
+                    return result;
+                }
+            }
+        }
+
+        // 退回到在当前进程中直接启动
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(executable.c_str()));
+        for (const auto& argument : arguments) {
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        posix_spawnattr_t attr;
+        initSpawnAttributes(&attr);
+        pid_t pid = -1;
+        uint64_t spawn_start = monotonicNanoseconds();
+        int error = posix_spawnp(&pid, executable.c_str(), nullptr, &attr, argv.data(), environ);
+        result.spawn_ns = monotonicNanoseconds() - spawn_start;
+        posix_spawnattr_destroy(&attr);
+        
+        // 本进程不能像辅助进程那样忽略SIGCHLD，由分离的线程等待应用退出并回收，避免留下僵尸进程
+        if (error == 0) {
+            std::thread([pid]() {
+                while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {
+                }
+            }).detach();
+        }
+
+        result.success = (error == 0);
+        result.pid = result.success ? pid : -1;
+        result.error = error;
+        result.total_ns = monotonicNanoseconds() - start;
+        return result;
+    }
+
+    std::string getLastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_error_;
+    }
+
+private:
+    bool startLocked() {
+        if (fd_ >= 0) return true;
+
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) < 0) {
+            last_error_ = std::string("创建套接字失败: ") + std::strerror(errno);
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            last_error_ = std::string("创建启动辅助进程失败: ") + std::strerror(errno);
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            helperMain(fds[1]);
+        }
+
+        close(fds[1]);
+        fd_ = fds[0];
+        pid_ = pid;
+        return true;
+    }
+
+    void stopLocked(bool wait) {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        if (pid_ > 0) {
+            // 关闭套接字后辅助进程自行退出；无需等待时只回收已退出的进程
+            if (waitpid(pid_, nullptr, wait ? 0 : WNOHANG) != 0 || wait) {
+                pid_ = -1;
+            }
+        }
+    }
+
+    /**
+     * @brief 发送请求并等待应答
+     * @param sent 输出请求是否已送达辅助进程
+     */
+    bool roundTrip(const std::string& request, LaunchReply& reply, bool& sent) {
+        if (send(fd_, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+            return false;
+        }
+        sent = true;
+
+        pollfd pfd = {fd_, POLLIN, 0};
+        int ready;
+        do {
+            ready = poll(&pfd, 1, kReplyTimeoutMs);
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) {
+            if (ready == 0) errno = ETIMEDOUT;
+            return false;
+        }
+
+        return recv(fd_, &reply, sizeof(reply), 0) == static_cast<ssize_t>(sizeof(reply));
+    }
+
+    mutable std::mutex mutex_;
+    int fd_;
+    pid_t pid_;
+    std::string last_error_;
+};
+
+// LaunchHelper 实现
+LaunchHelper::LaunchHelper() : impl_(std::make_unique<Impl>()) {}
+
+LaunchHelper::~LaunchHelper() = default;
+
+bool LaunchHelper::start() {
+    return impl_->start();
+}
+
+void LaunchHelper::stop() {
+    impl_->stop();
+}
+
+bool LaunchHelper::isRunning() const {
+    return impl_->isRunning();
+}
+
+LaunchResult LaunchHelper::launch(const std::string& executable, const std::vector<std::string>& arguments) {
+    return impl_->launch(executable, arguments);
+}
+
+std::string LaunchHelper::getLastError() const {
+    return impl_->getLastError();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
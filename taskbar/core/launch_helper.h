@@ -0,0 +1,96 @@
+/**
+ * @file launch_helper.h
+ * @brief 应用启动辅助进程头文件
+ *
+ * 任务栏初始化时预先fork一个小型辅助进程，启动请求经套接字发送给它，
+ * 由它以posix_spawnp创建应用进程，避免从内存占用很大的桌面进程直接派生
+ */
+
+#ifndef CLOUDFLOW_LAUNCH_HELPER_H
+#define CLOUDFLOW_LAUNCH_HELPER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct LaunchResult
+ * @brief 启动结果
+ */
+struct LaunchResult {
+    bool success;                 ///< 是否启动成功
+    pid_t pid;                    ///< 应用进程ID
+    int error;                    ///< 失败时的errno
+    uint64_t spawn_ns;            ///< 辅助进程中posix_spawnp的耗时（纳秒）
+    uint64_t total_ns;            ///< 包含请求往返的总耗时（纳秒）
+    bool via_helper;              ///< 是否经由辅助进程启动
+
+    LaunchResult() : success(false), pid(-1), error(0), spawn_ns(0), total_ns(0), via_helper(false) {}
+};
+
+/**
+ * @class LaunchHelper
+ * @brief 应用启动辅助进程
+ *
+ * start()应在任务栏加载大量数据之前调用，使辅助进程的地址空间尽量小。
+ * 辅助进程不可用时launch()退回到在当前进程中直接posix_spawnp（由后台线程回收退出的应用进程）；
+ * 请求已送达但应答超时时不退回，以免应用被启动两次
+ */
+class LaunchHelper {
+public:
+    LaunchHelper();
+
+    /**
+     * @brief 析构函数，关闭套接字并等待辅助进程退出
+     */
+    ~LaunchHelper();
+
+    // 禁用拷贝和赋值
+    LaunchHelper(const LaunchHelper&) = delete;
+    LaunchHelper& operator=(const LaunchHelper&) = delete;
+
+    /**
+     * @brief 启动辅助进程
+     * @return 启动是否成功
+     */
+    bool start();
+
+    /**
+     * @brief 停止辅助进程
+     */
+    void stop();
+
+    /**
+     * @brief 获取辅助进程是否在运行
+     * @return 是否在运行
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief 启动应用（线程安全）
+     * @param executable 可执行文件路径或名称（按PATH查找）
+     * @param arguments 启动参数
+     * @return 启动结果
+     */
+    LaunchResult launch(const std::string& executable, const std::vector<std::string>& arguments);
+
+    /**
+     * @brief 获取错误信息
+     * @return 错误描述
+     */
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_LAUNCH_HELPER_H
@@ -0,0 +1,354 @@
+/**
+ * @file lunar_calendar.cpp
+ * @brief 日历与农历实现文件
+ */
+
+#include "lunar_calendar.h"
+#include <algorithm>
+#include <array>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+constexpr int kFirstLunarYear = 1900;
+constexpr int kLunarYearCount = 201;
+
+/**
+ * @brief 农历年数据（1900-2100年）
+ *
+ * 位0-3：闰月月份（0表示无闰月）；位4-15：1至12月是否为大月（30天），
+ * 1月在位15；位16：闰月是否为大月
+ */
+constexpr uint32_t kLunarInfo[kLunarYearCount] = {
+    0x04bd8, 0x04ae0, 0x0a570, 0x054d5, 0x0d260, 0x0d950, 0x16554, 0x056a0, 0x09ad0, 0x055d2,  // 1900-1909
+    0x04ae0, 0x0a5b6, 0x0a4d0, 0x0d250, 0x1d255, 0x0b540, 0x0d6a0, 0x0ada2, 0x095b0, 0x14977,  // 1910-1919
+    0x04970, 0x0a4b0, 0x0b4b5, 0x06a50, 0x06d40, 0x1ab54, 0x02b60, 0x09570, 0x052f2, 0x04970,  // 1920-1929
+    0x06566, 0x0d4a0, 0x0ea50, 0x16a95, 0x05ad0, 0x02b60, 0x186e3, 0x092e0, 0x1c8d7, 0x0c950,  // 1930-1939
+    0x0d4a0, 0x1d8a6, 0x0b550, 0x056a0, 0x1a5b4, 0x025d0, 0x092d0, 0x0d2b2, 0x0a950, 0x0b557,  // 1940-1949
+    0x06ca0, 0x0b550, 0x15355, 0x04da0, 0x0a5b0, 0x14573, 0x052b0, 0x0a9a8, 0x0e950, 0x06aa0,  // 1950-1959
+    0x0aea6, 0x0ab50, 0x04b60, 0x0aae4, 0x0a570, 0x05260, 0x0f263, 0x0d950, 0x05b57, 0x056a0,  // 1960-1969
+    0x096d0, 0x04dd5, 0x04ad0, 0x0a4d0, 0x0d4d4, 0x0d250, 0x0d558, 0x0b540, 0x0b6a0, 0x195a6,  // 1970-1979
+    0x095b0, 0x049b0, 0x0a974, 0x0a4b0, 0x0b27a, 0x06a50, 0x06d40, 0x0af46, 0x0ab60, 0x09570,  // 1980-1989
+    0x04af5, 0x04970, 0x064b0, 0x074a3, 0x0ea50, 0x06b58, 0x05ac0, 0x0ab60, 0x096d5, 0x092e0,  // 1990-1999
+    0x0c960, 0x0d954, 0x0d4a0, 0x0da50, 0x07552, 0x056a0, 0x0abb7, 0x025d0, 0x092d0, 0x0cab5,  // 2000-2009
+    0x0a950, 0x0b4a0, 0x0baa4, 0x0ad50, 0x055d9, 0x04ba0, 0x0a5b0, 0x15176, 0x052b0, 0x0a930,  // 2010-2019
+    0x07954, 0x06aa0, 0x0ad50, 0x05b52, 0x04b60, 0x0a6e6, 0x0a4e0, 0x0d260, 0x0ea65, 0x0d530,  // 2020-2029
+    0x05aa0, 0x076a3, 0x096d0, 0x04afb, 0x04ad0, 0x0a4d0, 0x1d0b6, 0x0d250, 0x0d520, 0x0dd45,  // 2030-2039
+    0x0b5a0, 0x056d0, 0x055b2, 0x049b0, 0x0a577, 0x0a4b0, 0x0aa50, 0x1b255, 0x06d20, 0x0ada0,  // 2040-2049
+    0x14b63, 0x09370, 0x049f8, 0x04970, 0x064b0, 0x168a6, 0x0ea50, 0x06b20, 0x1a6c4, 0x0aae0,  // 2050-2059
+    0x092e0, 0x0d2e3, 0x0c960, 0x0d557, 0x0d4a0, 0x0da50, 0x05d55, 0x056a0, 0x0a6d0, 0x055d4,  // 2060-2069
+    0x052d0, 0x0a9b8, 0x0a950, 0x0b4a0, 0x0b6a6, 0x0ad50, 0x055a0, 0x0aba4, 0x0a5b0, 0x052b0,  // 2070-2079
+    0x0b273, 0x06930, 0x07337, 0x06aa0, 0x0ad50, 0x14b55, 0x04b60, 0x0a570, 0x054e4, 0x0d160,  // 2080-2089
+    0x0e968, 0x0d520, 0x0daa0, 0x16aa6, 0x056d0, 0x04ae0, 0x0a9d4, 0x0a2d0, 0x0d150, 0x0f252,  // 2090-2099
+    0x0d520,  // 2100-2100
+};
+
+/**
+ * @brief 各节气在当月的最早日期（0=小寒 ... 23=冬至，每月两个节气）
+ */
+constexpr int kSolarTermBaseDay[24] = {
+    4, 19, 3, 18, 4, 19, 4, 19, 4, 20, 4, 20, 6, 22, 6, 22, 6, 22, 7, 22, 6, 21, 6, 21
+};
+
+/**
+ * @brief 各年节气日期相对最早日期的偏移（1900-2100年，每个节气2位）
+ *
+ * 由太阳视黄经按北京时间计算得出，误差在数分钟以内
+ */
+constexpr uint64_t kSolarTermOffsets[kLunarYearCount] = {
+    0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaaaaabaaa6aULL, 0xaaabbabbafaaULL,  // 1900-1903
+    0x5aa665a65aabULL, 0x6aaaa6aa9a5aULL, 0xaaaaaaaaaa6aULL, 0xaaabbabbafaaULL,  // 1904-1907
+    0x5aa665a65aabULL, 0x6aaaa6aa9a5aULL, 0xaaaaaaaaaa6aULL, 0xaaabbabaafaaULL,  // 1908-1911
+    0x56a665a65aabULL, 0x6aa6a6aa9a56ULL, 0xaaaaaaaa9a5aULL, 0xaaabaabaaeaaULL,  // 1912-1915
+    0x569665a65aaaULL, 0x5aa6a6a69a56ULL, 0x6aaaaaaa9a5aULL, 0xaaabaabaaeaaULL,  // 1916-1919
+    0x569665a65aaaULL, 0x5aa6a6a65a56ULL, 0x6aaaaaaa9a5aULL, 0xaaabaabaaaaaULL,  // 1920-1923
+    0x569665a65aaaULL, 0x5aa6a6a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaabaabaaa6aULL,  // 1924-1927
+    0x555665a65aaaULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaaaaabaaa6aULL,  // 1928-1931
+    0x555665665aaaULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaaaaaaaaa6aULL,  // 1932-1935
+    0x555665665aaaULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaaaaaaaaa6aULL,  // 1936-1939
+    0x555665665aaaULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL, 0xaaaaaaaaaa6aULL,  // 1940-1943
+    0x555665655aaaULL, 0x5a9665a65a56ULL, 0x6aa6a6aa9a56ULL, 0xaaaaaaaa9a5aULL,  // 1944-1947
+    0x555655655aaaULL, 0x569665a65a55ULL, 0x6aa6a6a65a56ULL, 0x6aaaaaaa9a5aULL,  // 1948-1951
+    0x5556556559aaULL, 0x569665a65a55ULL, 0x5aa6a6a65a56ULL, 0x6aaaa6aa9a5aULL,  // 1952-1955
+    0x5556556555aaULL, 0x569665a65a55ULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL,  // 1956-1959
+    0x55555565556aULL, 0x555665665a55ULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL,  // 1960-1963
+    0x55555565556aULL, 0x555665665a55ULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL,  // 1964-1967
+    0x55555555556aULL, 0x555665665a55ULL, 0x5aa665a65a56ULL, 0x6aaaa6aa9a5aULL,  // 1968-1971
+    0x55555555556aULL, 0x555665655a55ULL, 0x5aa665a65a56ULL, 0x6aa6a6aa9a5aULL,  // 1972-1975
+    0x55555555456aULL, 0x555655655a55ULL, 0x5a9665a65a56ULL, 0x6aa6a6a69a56ULL,  // 1976-1979
+    0x55555555456aULL, 0x555655655a55ULL, 0x569665a65a56ULL, 0x6aa6a6a65a56ULL,  // 1980-1983
+    0x55555155455aULL, 0x555655655955ULL, 0x569665a65a55ULL, 0x5aa6a5a65a56ULL,  // 1984-1987
+    0x15555155455aULL, 0x555555655555ULL, 0x569665665a55ULL, 0x5aa665a65a56ULL,  // 1988-1991
+    0x15555155455aULL, 0x555555655515ULL, 0x555665665a55ULL, 0x5aa665a65a56ULL,  // 1992-1995
+    0x15555155455aULL, 0x555555555515ULL, 0x555665665a55ULL, 0x5aa665a65a56ULL,  // 1996-1999
+    0x15555155455aULL, 0x555555555515ULL, 0x555665665a55ULL, 0x5aa665a65a56ULL,  // 2000-2003
+    0x15555155455aULL, 0x555555555515ULL, 0x555655655a55ULL, 0x5aa665a65a56ULL,  // 2004-2007
+    0x15515155455aULL, 0x555555554515ULL, 0x555655655a55ULL, 0x5a9665a65a56ULL,  // 2008-2011
+    0x15515151455aULL, 0x555551554515ULL, 0x555655655955ULL, 0x569665a65a56ULL,  // 2012-2015
+    0x155150510556ULL, 0x555551554505ULL, 0x555655655955ULL, 0x569665665a55ULL,  // 2016-2019
+    0x155110510556ULL, 0x155551554505ULL, 0x555555655555ULL, 0x569665665a55ULL,  // 2020-2023
+    0x055110510556ULL, 0x155551554505ULL, 0x555555555515ULL, 0x555665665a55ULL,  // 2024-2027
+    0x055110510556ULL, 0x155551554505ULL, 0x555555555515ULL, 0x555665665a55ULL,  // 2028-2031
+    0x055110510556ULL, 0x155551554505ULL, 0x555555555515ULL, 0x555655655a55ULL,  // 2032-2035
+    0x055110510556ULL, 0x155551554505ULL, 0x555555555515ULL, 0x555655655a55ULL,  // 2036-2039
+    0x054110510556ULL, 0x155151514505ULL, 0x555555554515ULL, 0x555655655a55ULL,  // 2040-2043
+    0x054110510556ULL, 0x155151510505ULL, 0x555551554515ULL, 0x555655655955ULL,  // 2044-2047
+    0x014110110556ULL, 0x155110510501ULL, 0x555551554505ULL, 0x555555655555ULL,  // 2048-2051
+    0x014110110555ULL, 0x155110510501ULL, 0x555551554505ULL, 0x555555555555ULL,  // 2052-2055
+    0x014110110555ULL, 0x055110510501ULL, 0x155551554505ULL, 0x555555555515ULL,  // 2056-2059
+    0x000110110555ULL, 0x055110510501ULL, 0x155551554505ULL, 0x555555555515ULL,  // 2060-2063
+    0x000110110555ULL, 0x055110510501ULL, 0x155551554505ULL, 0x555555555515ULL,  // 2064-2067
+    0x000100100555ULL, 0x055110510501ULL, 0x155151514505ULL, 0x555555555515ULL,  // 2068-2071
+    0x000100100555ULL, 0x054110510501ULL, 0x155151514505ULL, 0x555551554515ULL,  // 2072-2075
+    0x000100100555ULL, 0x054110510501ULL, 0x155150510505ULL, 0x555551554515ULL,  // 2076-2079
+    0x000100100555ULL, 0x014110110501ULL, 0x155110510501ULL, 0x555551554505ULL,  // 2080-2083
+    0x000000000055ULL, 0x014110110500ULL, 0x155110510501ULL, 0x555551554505ULL,  // 2084-2087
+    0x000000000055ULL, 0x014110110500ULL, 0x055110510501ULL, 0x155551554505ULL,  // 2088-2091
+    0x000000000055ULL, 0x000110110500ULL, 0x055110510501ULL, 0x155551554505ULL,  // 2092-2095
+    0x000000000015ULL, 0x000100100500ULL, 0x055110510501ULL, 0x155551554505ULL,  // 2096-2099
+    0x555555555515ULL,  // 2100-2100
+};
+
+const char* const kSolarTermNames[24] = {
+    "小寒", "大寒", "立春", "雨水", "惊蛰", "春分", "清明", "谷雨", "立夏", "小满", "芒种", "夏至",
+    "小暑", "大暑", "立秋", "处暑", "白露", "秋分", "寒露", "霜降", "立冬", "小雪", "大雪", "冬至"
+};
+
+const char* const kLunarMonthNames[12] = {
+    "正", "二", "三", "四", "五", "六", "七", "八", "九", "十", "冬", "腊"
+};
+
+const char* const kLunarDayNames[30] = {
+    "初一", "初二", "初三", "初四", "初五", "初六", "初七", "初八", "初九", "初十",
+    "十一", "十二", "十三", "十四", "十五", "十六", "十七", "十八", "十九", "二十",
+    "廿一", "廿二", "廿三", "廿四", "廿五", "廿六", "廿七", "廿八", "廿九", "三十"
+};
+
+const char* const kHeavenlyStems[10] = {"甲", "乙", "丙", "丁", "戊", "己", "庚", "辛", "壬", "癸"};
+const char* const kEarthlyBranches[12] = {"子", "丑", "寅", "卯", "辰", "巳", "午", "未", "申", "酉", "戌", "亥"};
+const char* const kZodiacs[12] = {"鼠", "牛", "虎", "兔", "龙", "蛇", "马", "羊", "猴", "鸡", "狗", "猪"};
+
+/**
+ * @brief 公历日期转为自1970-01-01起的日序号
+ */
+constexpr int32_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int year_of_era = year - era * 400;
+    const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * @brief 日序号转为公历日期
+ */
+void civilFromDays(int32_t days, int& year, int& month, int& day) {
+    days += 719468;
+    const int era = (days >= 0 ? days : days - 146096) / 146097;
+    const int day_of_era = days - era * 146097;
+    const int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const int mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp + (mp < 10 ? 3 : -9);
+    year = year_of_era + era * 400 + (month <= 2);
+}
+
+/**
+ * @brief 日序号对应的星期（0=星期日，1970-01-01为星期四）
+ */
+int weekdayOf(int32_t days) {
+    return static_cast<int>(((days % 7) + 11) % 7);
+}
+
+int daysInMonth(int year, int month) {
+    static const int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap_year = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && leap_year) ? 29 : kDays[month - 1];
+}
+
+constexpr int lunarMonthDays(uint32_t info, int month) {
+    return (info & (0x10000u >> month)) ? 30 : 29;
+}
+
+constexpr int lunarLeapMonth(uint32_t info) {
+    return static_cast<int>(info & 0xF);
+}
+
+constexpr int lunarLeapDays(uint32_t info) {
+    return lunarLeapMonth(info) ? ((info & 0x10000u) ? 30 : 29) : 0;
+}
+
+constexpr int lunarYearDays(uint32_t info) {
+    int days = lunarLeapDays(info);
+    for (int month = 1; month <= 12; ++month) {
+        days += lunarMonthDays(info, month);
+    }
+    return days;
+}
+
+/**
+ * @brief 各农历年正月初一的日序号（编译期累加，最后一项为2101年正月初一）
+ */
+constexpr std::array<int32_t, kLunarYearCount + 1> kLunarNewYears = []() {
+    std::array<int32_t, kLunarYearCount + 1> new_years{};
+    new_years[0] = daysFromCivil(1900, 1, 31);
+    for (int i = 0; i < kLunarYearCount; ++i) {
+        new_years[i + 1] = new_years[i] + lunarYearDays(kLunarInfo[i]);
+    }
+    return new_years;
+}();
+
+int solarTermOfDay(int year, int month, int day) {
+    if (year < kFirstLunarYear || year >= kFirstLunarYear + kLunarYearCount) return -1;
+
+    uint64_t offsets = kSolarTermOffsets[year - kFirstLunarYear];
+    for (int index = (month - 1) * 2; index < month * 2; ++index) {
+        if (day == kSolarTermBaseDay[index] + static_cast<int>((offsets >> (index * 2)) & 0x3)) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+bool lunarFromDays(int32_t days, LunarDate& lunar) {
+    if (days < kLunarNewYears.front() || days >= kLunarNewYears.back()) return false;
+
+    // 二分查找所在农历年，再在年内逐月扣除（最多13个月）
+    auto it = std::upper_bound(kLunarNewYears.begin(), kLunarNewYears.end(), days) - 1;
+    int index = static_cast<int>(it - kLunarNewYears.begin());
+    uint32_t info = kLunarInfo[index];
+    int offset = days - *it;
+    int leap_month = lunarLeapMonth(info);
+
+    lunar.year = kFirstLunarYear + index;
+    lunar.leap = false;
+    for (int month = 1; month <= 12; ++month) {
+        int length = lunarMonthDays(info, month);
+        if (offset < length) {
+            lunar.month = month;
+            lunar.day = offset + 1;
+            return true;
+        }
+        offset -= length;
+
+        if (month == leap_month) {
+            length = lunarLeapDays(info);
+            if (offset < length) {
+                lunar.month = month;
+                lunar.day = offset + 1;
+                lunar.leap = true;
+                return true;
+            }
+            offset -= length;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+LunarCalendar::LunarCalendar(size_t cache_size)
+    : cache_size_(std::max<size_t>(1, cache_size)),
+      hits_(0),
+      misses_(0) {}
+
+std::shared_ptr<const CalendarMonth> LunarCalendar::getMonth(int year, int month) {
+    if (year < 1 || year > 9999 || month < 1 || month > 12) return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+            if ((*it)->year == year && (*it)->month == month) {
+                cache_.splice(cache_.begin(), cache_, it);
+                hits_++;
+                return cache_.front();
+            }
+        }
+        misses_++;
+    }
+
+    auto grid = buildMonth(year, month);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.push_front(grid);
+    if (cache_.size() > cache_size_) {
+        cache_.pop_back();
+    }
+    return grid;
+}
+
+std::pair<uint64_t, uint64_t> LunarCalendar::getCacheStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {hits_, misses_};
+}
+
+std::shared_ptr<const CalendarMonth> LunarCalendar::buildMonth(int year, int month) const {
+    auto grid = std::make_shared<CalendarMonth>();
+    grid->year = year;
+    grid->month = month;
+
+    // 每周从星期一开始，前面用上月日期补位
+    int32_t first = daysFromCivil(year, month, 1);
+    int32_t start = first - (weekdayOf(first) + 6) % 7;
+    int32_t end = first + daysInMonth(year, month);
+
+    for (size_t i = 0; i < CalendarMonth::kDays; ++i) {
+        int32_t days = start + static_cast<int32_t>(i);
+        int day_year = 0;
+        int day_month = 0;
+        int day_of_month = 0;
+        civilFromDays(days, day_year, day_month, day_of_month);
+
+        CalendarDay& cell = grid->days[i];
+        cell.year = static_cast<int16_t>(day_year);
+        cell.month = static_cast<int8_t>(day_month);
+        cell.day = static_cast<int8_t>(day_of_month);
+        cell.weekday = static_cast<int8_t>(weekdayOf(days));
+        cell.in_month = (days >= first && days < end);
+        cell.solar_term = static_cast<int8_t>(solarTermOfDay(day_year, day_month, day_of_month));
+
+        LunarDate lunar;
+        if (lunarFromDays(days, lunar)) {
+            cell.lunar_month = static_cast<int8_t>(lunar.month);
+            cell.lunar_day = static_cast<int8_t>(lunar.day);
+            cell.lunar_leap = lunar.leap;
+        }
+    }
+    return grid;
+}
+
+bool LunarCalendar::toLunar(int year, int month, int day, LunarDate& lunar) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return false;
+    return lunarFromDays(daysFromCivil(year, month, day), lunar);
+}
+
+int LunarCalendar::solarTerm(int year, int month, int day) {
+    if (month < 1 || month > 12) return -1;
+    return solarTermOfDay(year, month, day);
+}
+
+const char* LunarCalendar::solarTermName(int index) {
+    return (index >= 0 && index < 24) ? kSolarTermNames[index] : "";
+}
+
+std::string LunarCalendar::lunarMonthName(int month, bool leap) {
+    if (month < 1 || month > 12) return "";
+    return std::string(leap ? "闰" : "") + kLunarMonthNames[month - 1] + "月";
+}
+
+const char* LunarCalendar::lunarDayName(int day) {
+    return (day >= 1 && day <= 30) ? kLunarDayNames[day - 1] : "";
+}
+
+std::string LunarCalendar::lunarYearName(int year) {
+    // 公元4年为甲子年
+    int cycle = ((year - 4) % 60 + 60) % 60;
+    return std::string(kHeavenlyStems[cycle % 10]) + kEarthlyBranches[cycle % 12] + kZodiacs[cycle % 12] + "年";
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
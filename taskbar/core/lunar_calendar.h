@@ -0,0 +1,165 @@
+/**
+ * @file lunar_calendar.h
+ * @brief 日历与农历头文件
+ *
+ * 为时钟弹出的日历提供公历月视图、农历日期和二十四节气。
+ * 农历月大小、闰月和节气日期均来自编译期数据表（1900-2100年），
+ * 各年农历新年的日序号在编译期累加得到；月视图生成后按月缓存，
+ * 打开和翻页日历只做查表
+ */
+
+#ifndef CLOUDFLOW_LUNAR_CALENDAR_H
+#define CLOUDFLOW_LUNAR_CALENDAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct LunarDate
+ * @brief 农历日期
+ */
+struct LunarDate {
+    int year;                     ///< 农历年（以公历年表示，正月初一所在的公历年）
+    int month;                    ///< 农历月（1-12）
+    int day;                      ///< 农历日（1-30）
+    bool leap;                    ///< 是否闰月
+
+    LunarDate() : year(0), month(0), day(0), leap(false) {}
+};
+
+/**
+ * @struct CalendarDay
+ * @brief 月视图中的一天
+ */
+struct CalendarDay {
+    int16_t year;                 ///< 公历年
+    int8_t month;                 ///< 公历月（1-12）
+    int8_t day;                   ///< 公历日
+    int8_t weekday;               ///< 星期（0=星期日）
+    int8_t lunar_month;           ///< 农历月，超出数据表范围时为0
+    int8_t lunar_day;             ///< 农历日
+    bool lunar_leap;              ///< 是否农历闰月
+    int8_t solar_term;            ///< 节气序号（0=小寒 ... 23=冬至），不是节气时为-1
+    bool in_month;                ///< 是否属于本月（否则为前后月的补位）
+
+    CalendarDay() : year(0), month(0), day(0), weekday(0), lunar_month(0), lunar_day(0),
+                    lunar_leap(false), solar_term(-1), in_month(false) {}
+};
+
+/**
+ * @struct CalendarMonth
+ * @brief 月视图（6周 x 7天，每周从星期一开始）
+ */
+struct CalendarMonth {
+    static constexpr size_t kDays = 42;
+
+    int year;                     ///< 公历年
+    int month;                    ///< 公历月（1-12）
+    CalendarDay days[kDays];      ///< 按行排列的日期
+
+    CalendarMonth() : year(0), month(0) {}
+};
+
+/**
+ * @class LunarCalendar
+ * @brief 日历服务
+ *
+ * 转换函数为纯查表，可在任意线程调用；月视图缓存线程安全
+ */
+class LunarCalendar {
+public:
+    /**
+     * @brief 构造函数
+     * @param cache_size 缓存的月视图数量
+     */
+    explicit LunarCalendar(size_t cache_size = 12);
+
+    // 禁用拷贝和赋值
+    LunarCalendar(const LunarCalendar&) = delete;
+    LunarCalendar& operator=(const LunarCalendar&) = delete;
+
+    /**
+     * @brief 获取月视图（命中缓存时直接返回）
+     * @param year 公历年
+     * @param month 公历月（1-12）
+     * @return 月视图，参数无效时返回空指针
+     */
+    std::shared_ptr<const CalendarMonth> getMonth(int year, int month);
+
+    /**
+     * @brief 获取缓存命中和未命中次数
+     * @return {命中次数, 未命中次数}
+     */
+    std::pair<uint64_t, uint64_t> getCacheStats() const;
+
+    /**
+     * @brief 公历转农历
+     * @param year 公历年
+     * @param month 公历月
+     * @param day 公历日
+     * @param lunar 输出农历日期
+     * @return 是否在数据表范围内（1900年正月初一至2100年除夕）
+     */
+    static bool toLunar(int year, int month, int day, LunarDate& lunar);
+
+    /**
+     * @brief 查询节气
+     * @param year 公历年
+     * @param month 公历月
+     * @param day 公历日
+     * @return 节气序号（0=小寒 ... 23=冬至），不是节气或超出范围时返回-1
+     */
+    static int solarTerm(int year, int month, int day);
+
+    /**
+     * @brief 获取节气名称
+     * @param index 节气序号
+     * @return 名称，序号无效时返回空字符串
+     */
+    static const char* solarTermName(int index);
+
+    /**
+     * @brief 获取农历月名称（如"正月"、"闰四月"、"腊月"）
+     * @param month 农历月
+     * @param leap 是否闰月
+     * @return 名称
+     */
+    static std::string lunarMonthName(int month, bool leap);
+
+    /**
+     * @brief 获取农历日名称（如"初一"、"十五"、"廿三"）
+     * @param day 农历日
+     * @return 名称，日期无效时返回空字符串
+     */
+    static const char* lunarDayName(int day);
+
+    /**
+     * @brief 获取农历年的干支和生肖（如"甲辰龙年"）
+     * @param year 农历年
+     * @return 名称
+     */
+    static std::string lunarYearName(int year);
+
+private:
+    std::shared_ptr<const CalendarMonth> buildMonth(int year, int month) const;
+
+    const size_t cache_size_;
+
+    mutable std::mutex mutex_;
+    std::list<std::shared_ptr<const CalendarMonth>> cache_;  ///< 最近使用的在前
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_LUNAR_CALENDAR_H
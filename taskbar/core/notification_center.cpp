@@ -0,0 +1,307 @@
+/**
+ * @file notification_center.cpp
+ * @brief 通知中心实现文件
+ */
+
+#include "notification_center.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+// 令牌桶数量超过该值时清理已经补满的桶
+constexpr size_t kBucketPruneThreshold = 256;
+
+uint64_t hashField(uint64_t hash, const std::string& text) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    // 字段之间加入分隔，避免("ab","c")与("a","bc")冲突
+    hash ^= 0xFF;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+uint64_t duplicateKey(const Notification& notification) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashField(hash, notification.app_id);
+    hash = hashField(hash, notification.summary);
+    hash = hashField(hash, notification.body);
+    return hash;
+}
+
+} // namespace
+
+// NotificationCenter 实现类
+class NotificationCenter::Impl {
+public:
+    explicit Impl(const NotificationPolicy& policy)
+        : policy_(policy),
+          slots_(std::max<size_t>(1, policy.capacity)),
+          next_id_(1),
+          read_watermark_(0),
+          unread_(0) {}
+
+    uint64_t post(const Notification& notification) {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t key = duplicateKey(notification);
+        uint64_t id = 0;
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.posted++;
+
+            // 合并窗口内仍未读的重复通知只增加计数，不消耗令牌
+            auto duplicate = duplicates_.find(key);
+            if (duplicate != duplicates_.end()) {
+                Slot* slot = findSlot(duplicate->second);
+                if (slot && duplicate->second > read_watermark_ &&
+                    now - slot->last_posted <= policy_.collapse_window) {
+                    slot->notification.count++;
+                    slot->notification.timestamp = std::chrono::system_clock::now();
+                    slot->last_posted = now;
+                    stats_.collapsed++;
+                    id = slot->notification.id;
+                }
+            }
+
+            if (id == 0) {
+                if (notification.urgency != NotificationUrgency::Critical && !takeToken(notification.app_id, now)) {
+                    stats_.rate_limited++;
+                    return 0;
+                }
+                id = insert(notification, key, now);
+            }
+            callback = change_callback_;
+        }
+
+        if (callback) {
+            callback();
+        }
+        return id;
+    }
+
+    bool dismiss(uint64_t id) {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Slot* slot = findSlot(id);
+            if (!slot) return false;
+
+            release(*slot);
+            callback = change_callback_;
+        }
+
+        if (callback) {
+            callback();
+        }
+        return true;
+    }
+
+    void clear() {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& slot : slots_) {
+                slot.notification.id = 0;
+            }
+            duplicates_.clear();
+            unread_ = 0;
+            callback = change_callback_;
+        }
+
+        if (callback) {
+            callback();
+        }
+    }
+
+    void markAllRead() {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (unread_ == 0) return;
+
+            read_watermark_ = next_id_ - 1;
+            unread_ = 0;
+            callback = change_callback_;
+        }
+
+        if (callback) {
+            callback();
+        }
+    }
+
+    size_t unreadCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return unread_;
+    }
+
+    std::vector<Notification> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Notification> notifications;
+        notifications.reserve(slots_.size());
+
+        // 最近的capacity个ID依次对应环形缓冲区中的各个槽位
+        for (size_t i = 0; i < slots_.size() && i + 1 < next_id_; ++i) {
+            uint64_t id = next_id_ - 1 - i;
+            const Slot& slot = slots_[slotIndex(id)];
+            if (slot.notification.id == id) {
+                notifications.push_back(slot.notification);
+            }
+        }
+        return notifications;
+    }
+
+    void setChangeCallback(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        change_callback_ = std::move(callback);
+    }
+
+    NotificationCenterStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    struct Slot {
+        Notification notification;    ///< id为0表示空槽位
+        uint64_t key = 0;
+        std::chrono::steady_clock::time_point last_posted;
+    };
+
+    struct TokenBucket {
+        double tokens;
+        std::chrono::steady_clock::time_point last_refill;
+    };
+
+    size_t slotIndex(uint64_t id) const {
+        return static_cast<size_t>((id - 1) % slots_.size());
+    }
+
+    uint64_t insert(const Notification& notification, uint64_t key, std::chrono::steady_clock::time_point now) {
+        uint64_t id = next_id_++;
+        Slot& slot = slots_[slotIndex(id)];
+        if (slot.notification.id != 0) {
+            stats_.evicted++;
+            release(slot);
+        }
+
+        slot.notification = notification;
+        slot.notification.id = id;
+        slot.notification.count = 1;
+        slot.notification.timestamp = std::chrono::system_clock::now();
+        slot.key = key;
+        slot.last_posted = now;
+        duplicates_[key] = id;
+        unread_++;
+        stats_.accepted++;
+        return id;
+    }
+
+    Slot* findSlot(uint64_t id) {
+        if (id == 0) return nullptr;
+        Slot& slot = slots_[slotIndex(id)];
+        return slot.notification.id == id ? &slot : nullptr;
+    }
+
+    void release(Slot& slot) {
+        auto duplicate = duplicates_.find(slot.key);
+        if (duplicate != duplicates_.end() && duplicate->second == slot.notification.id) {
+            duplicates_.erase(duplicate);
+        }
+        if (slot.notification.id > read_watermark_) {
+            unread_--;
+        }
+        slot.notification.id = 0;
+    }
+
+    bool takeToken(const std::string& app_id, std::chrono::steady_clock::time_point now) {
+        if (buckets_.size() > kBucketPruneThreshold) {
+            pruneBuckets(now);
+        }
+
+        auto it = buckets_.find(app_id);
+        if (it == buckets_.end()) {
+            it = buckets_.emplace(app_id, TokenBucket{policy_.burst, now}).first;
+        }
+
+        TokenBucket& bucket = it->second;
+        double elapsed = std::chrono::duration<double>(now - bucket.last_refill).count();
+        bucket.tokens = std::min(policy_.burst, bucket.tokens + elapsed * policy_.refill_per_second);
+        bucket.last_refill = now;
+
+        if (bucket.tokens < 1.0) return false;
+        bucket.tokens -= 1.0;
+        return true;
+    }
+
+    void pruneBuckets(std::chrono::steady_clock::time_point now) {
+        // 已经补满的桶与新建的桶等价，可以直接丢弃
+        for (auto it = buckets_.begin(); it != buckets_.end();) {
+            double elapsed = std::chrono::duration<double>(now - it->second.last_refill).count();
+            if (it->second.tokens + elapsed * policy_.refill_per_second >= policy_.burst) {
+                it = buckets_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    const NotificationPolicy policy_;
+
+    mutable std::mutex mutex_;
+    std::vector<Slot> slots_;
+    uint64_t next_id_;
+    uint64_t read_watermark_;
+    size_t unread_;
+    std::unordered_map<uint64_t, uint64_t> duplicates_;
+    std::unordered_map<std::string, TokenBucket> buckets_;
+    NotificationCenterStats stats_;
+    std::function<void()> change_callback_;
+};
+
+// NotificationCenter 实现
+NotificationCenter::NotificationCenter(const NotificationPolicy& policy)
+    : impl_(std::make_unique<Impl>(policy)) {}
+
+NotificationCenter::~NotificationCenter() = default;
+
+uint64_t NotificationCenter::post(const Notification& notification) {
+    return impl_->post(notification);
+}
+
+bool NotificationCenter::dismiss(uint64_t id) {
+    return impl_->dismiss(id);
+}
+
+void NotificationCenter::clear() {
+    impl_->clear();
+}
+
+void NotificationCenter::markAllRead() {
+    impl_->markAllRead();
+}
+
+size_t NotificationCenter::unreadCount() const {
+    return impl_->unreadCount();
+}
+
+std::vector<Notification> NotificationCenter::snapshot() const {
+    return impl_->snapshot();
+}
+
+void NotificationCenter::setChangeCallback(std::function<void()> callback) {
+    impl_->setChangeCallback(std::move(callback));
+}
+
+NotificationCenterStats NotificationCenter::getStats() const {
+    return impl_->getStats();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
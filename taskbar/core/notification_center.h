@@ -0,0 +1,156 @@
+/**
+ * @file notification_center.h
+ * @brief 通知中心头文件
+ *
+ * 以固定容量的环形缓冲区保存通知，按应用进行令牌桶限流，
+ * 并将短时间内的重复通知合并为一条；变化只置脏并请求一帧，
+ * 由任务栏的帧调度统一更新托盘项和通知面板
+ */
+
+#ifndef CLOUDFLOW_NOTIFICATION_CENTER_H
+#define CLOUDFLOW_NOTIFICATION_CENTER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @enum NotificationUrgency
+ * @brief 通知紧急程度
+ */
+enum class NotificationUrgency {
+    Low,        ///< 低
+    Normal,     ///< 普通
+    Critical    ///< 紧急（不受限流）
+};
+
+/**
+ * @struct Notification
+ * @brief 通知
+ */
+struct Notification {
+    uint64_t id;                  ///< 通知ID（由通知中心分配）
+    std::string app_id;           ///< 发送方应用标识
+    std::string summary;          ///< 标题
+    std::string body;             ///< 正文
+    std::string icon_path;        ///< 图标路径
+    NotificationUrgency urgency;  ///< 紧急程度
+    std::chrono::system_clock::time_point timestamp; ///< 最近一次发送时间
+    uint32_t count;               ///< 合并的重复通知数量
+
+    Notification() : id(0), urgency(NotificationUrgency::Normal), count(1) {}
+};
+
+/**
+ * @struct NotificationPolicy
+ * @brief 通知中心策略
+ */
+struct NotificationPolicy {
+    size_t capacity;                          ///< 环形缓冲区容量
+    double burst;                             ///< 每个应用的突发上限（令牌桶容量）
+    double refill_per_second;                 ///< 每个应用每秒补充的令牌数
+    std::chrono::milliseconds collapse_window; ///< 该时间内的重复通知合并为一条
+
+    NotificationPolicy() : capacity(128), burst(8.0), refill_per_second(1.0),
+                           collapse_window(10000) {}
+};
+
+/**
+ * @struct NotificationCenterStats
+ * @brief 通知中心统计
+ */
+struct NotificationCenterStats {
+    uint64_t posted;              ///< 收到的通知数量
+    uint64_t accepted;            ///< 新加入缓冲区的通知数量
+    uint64_t collapsed;           ///< 合并到已有通知的重复通知数量
+    uint64_t rate_limited;        ///< 因限流丢弃的通知数量
+    uint64_t evicted;             ///< 缓冲区满时被覆盖的通知数量
+
+    NotificationCenterStats() : posted(0), accepted(0), collapsed(0), rate_limited(0), evicted(0) {}
+};
+
+/**
+ * @class NotificationCenter
+ * @brief 通知中心（线程安全）
+ */
+class NotificationCenter {
+public:
+    /**
+     * @brief 构造函数
+     * @param policy 通知策略
+     */
+    explicit NotificationCenter(const NotificationPolicy& policy = NotificationPolicy());
+
+    /**
+     * @brief 析构函数
+     */
+    ~NotificationCenter();
+
+    // 禁用拷贝和赋值
+    NotificationCenter(const NotificationCenter&) = delete;
+    NotificationCenter& operator=(const NotificationCenter&) = delete;
+
+    /**
+     * @brief 发送通知（可在任意线程调用）
+     * @param notification 通知，id、timestamp和count由通知中心填写
+     * @return 通知ID（合并时为已有通知的ID），被限流丢弃时返回0
+     */
+    uint64_t post(const Notification& notification);
+
+    /**
+     * @brief 移除通知
+     * @param id 通知ID
+     * @return 移除是否成功
+     */
+    bool dismiss(uint64_t id);
+
+    /**
+     * @brief 移除所有通知
+     */
+    void clear();
+
+    /**
+     * @brief 将所有通知标记为已读
+     */
+    void markAllRead();
+
+    /**
+     * @brief 获取未读通知数量
+     * @return 未读数量
+     */
+    size_t unreadCount() const;
+
+    /**
+     * @brief 获取所有通知（从新到旧）
+     * @return 通知列表
+     */
+    std::vector<Notification> snapshot() const;
+
+    /**
+     * @brief 设置变化回调（在发送通知的线程中调用，应只做置脏和请求帧）
+     * @param callback 回调函数
+     */
+    void setChangeCallback(std::function<void()> callback);
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计信息
+     */
+    NotificationCenterStats getStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_NOTIFICATION_CENTER_H
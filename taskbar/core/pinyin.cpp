@@ -0,0 +1,228 @@
+/**
+ * @file pinyin.cpp
+ * @brief 汉字拼音表实现文件
+ */
+
+#include "pinyin.h"
+#include <cstdlib>
+#include <fstream>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+struct PinyinEntry {
+    char32_t code_point;
+    const char* pinyin;
+};
+
+// 应用名称中的常用字（按码点排序）
+const PinyinEntry kBuiltinPinyin[] = {
+    {0x4E0A, "shang"}, {0x4E0B, "xia"}, {0x4E16, "shi"}, {0x4E1A, "ye"}, {0x4E1C, "dong"},
+    {0x4E2A, "ge"}, {0x4E2D, "zhong"}, {0x4E3A, "wei"}, {0x4E3B, "zhu"}, {0x4E4E, "hu"},
+    {0x4E50, "yue"}, {0x4E60, "xi"}, {0x4E66, "shu"}, {0x4E8B, "shi"}, {0x4E8E, "yu"}, {0x4E91, "yun"},
+    {0x4E94, "wu"}, {0x4EA4, "jiao"}, {0x4EAB, "xiang"}, {0x4EAC, "jing"}, {0x4EBA, "ren"},
+    {0x4ECA, "jin"}, {0x4ED8, "fu"}, {0x4EE3, "dai"}, {0x4EE4, "ling"}, {0x4EEA, "yi"},
+    {0x4EF6, "jian"}, {0x4EFB, "ren"}, {0x4EFD, "fen"}, {0x4EFF, "fang"}, {0x4F01, "qi"},
+    {0x4F11, "xiu"}, {0x4F18, "you"}, {0x4F1A, "hui"}, {0x4F20, "chuan"}, {0x4F4D, "wei"},
+    {0x4F53, "ti"}, {0x4FBF, "bian"}, {0x4FE1, "xin"}, {0x5012, "dao"}, {0x5065, "jian"},
+    {0x50A8, "chu"}, {0x50B2, "ao"}, {0x50CF, "xiang"}, {0x513F, "er"}, {0x514B, "ke"}, {0x5165, "ru"},
+    {0x5168, "quan"}, {0x516C, "gong"}, {0x5171, "gong"}, {0x5173, "guan"}, {0x5177, "ju"},
+    {0x5178, "dian"}, {0x518C, "ce"}, {0x51B2, "chong"}, {0x51FA, "chu"}, {0x5206, "fen"},
+    {0x5236, "zhi"}, {0x526A, "jian"}, {0x529E, "ban"}, {0x529F, "gong"}, {0x52A1, "wu"},
+    {0x52A8, "dong"}, {0x52A9, "zhu"}, {0x5305, "bao"}, {0x5316, "hua"}, {0x533A, "qu"},
+    {0x5347, "sheng"}, {0x534E, "hua"}, {0x5355, "dan"}, {0x535A, "bo"}, {0x5370, "yin"},
+    {0x5378, "xie"}, {0x5386, "li"}, {0x538B, "ya"}, {0x539F, "yuan"}, {0x53BB, "qu"}, {0x53CD, "fan"},
+    {0x53D1, "fa"}, {0x53D6, "qu"}, {0x53E3, "kou"}, {0x53F0, "tai"}, {0x53F7, "hao"}, {0x5408, "he"},
+    {0x542F, "qi"}, {0x544A, "gao"}, {0x547D, "ming"}, {0x54D4, "bi"}, {0x54EA, "na"},
+    {0x5546, "shang"}, {0x5668, "qi"}, {0x56DE, "hui"}, {0x56E2, "tuan"}, {0x56FE, "tu"},
+    {0x5730, "di"}, {0x5740, "zhi"}, {0x575B, "tan"}, {0x5883, "jing"}, {0x5899, "qiang"},
+    {0x58C1, "bi"}, {0x58F0, "sheng"}, {0x5904, "chu"}, {0x5907, "bei"}, {0x590D, "fu"},
+    {0x5916, "wai"}, {0x591A, "duo"}, {0x5927, "da"}, {0x5929, "tian"}, {0x5934, "tou"},
+    {0x5938, "kua"}, {0x5947, "qi"}, {0x5B50, "zi"}, {0x5B57, "zi"}, {0x5B58, "cun"}, {0x5B66, "xue"},
+    {0x5B89, "an"}, {0x5B9A, "ding"}, {0x5B9D, "bao"}, {0x5BA2, "ke"}, {0x5BB9, "rong"},
+    {0x5BC6, "mi"}, {0x5BFC, "dao"}, {0x5C0F, "xiao"}, {0x5C40, "ju"}, {0x5C4F, "ping"},
+    {0x5C71, "shan"}, {0x5DE5, "gong"}, {0x5DEE, "cha"}, {0x5E03, "bu"}, {0x5E10, "zhang"},
+    {0x5E2E, "bang"}, {0x5E55, "mu"}, {0x5E76, "bing"}, {0x5E93, "ku"}, {0x5E94, "ying"},
+    {0x5E97, "dian"}, {0x5EA6, "du"}, {0x5EB7, "kang"}, {0x5EFA, "jian"}, {0x5F00, "kai"},
+    {0x5F02, "yi"}, {0x5F55, "lu"}, {0x5F62, "xing"}, {0x5F69, "cai"}, {0x5F71, "ying"},
+    {0x5FAE, "wei"}, {0x5FC3, "xin"}, {0x5FD7, "zhi"}, {0x5FD8, "wang"}, {0x5FEB, "kuai"},
+    {0x6027, "xing"}, {0x6062, "hui"}, {0x606F, "xi"}, {0x60F3, "xiang"}, {0x620F, "xi"},
+    {0x6210, "cheng"}, {0x6211, "wo"}, {0x622A, "jie"}, {0x6237, "hu"}, {0x624B, "shou"},
+    {0x6253, "da"}, {0x6258, "tuo"}, {0x626B, "sao"}, {0x627E, "zhao"}, {0x6296, "dou"},
+    {0x62A4, "hu"}, {0x62A5, "bao"}, {0x62C9, "la"}, {0x62DF, "ni"}, {0x62FC, "pin"}, {0x6301, "chi"},
+    {0x636E, "ju"}, {0x63A7, "kong"}, {0x63A8, "tui"}, {0x63CF, "miao"}, {0x63D0, "ti"},
+    {0x641C, "sou"}, {0x643A, "xie"}, {0x6444, "she"}, {0x6478, "mo"}, {0x64AD, "bo"}, {0x652F, "zhi"},
+    {0x6536, "shou"}, {0x653E, "fang"}, {0x6548, "xiao"}, {0x6559, "jiao"}, {0x6570, "shu"},
+    {0x6587, "wen"}, {0x6597, "dou"}, {0x65B0, "xin"}, {0x65C5, "lv"}, {0x65CF, "zu"}, {0x65E0, "wu"},
+    {0x65E5, "ri"}, {0x65F6, "shi"}, {0x6613, "yi"}, {0x661F, "xing"}, {0x6620, "ying"},
+    {0x663E, "xian"}, {0x66F4, "geng"}, {0x6709, "you"}, {0x670B, "peng"}, {0x670D, "fu"},
+    {0x6717, "lang"}, {0x672C, "ben"}, {0x673A, "ji"}, {0x6740, "sha"}, {0x6743, "quan"},
+    {0x6761, "tiao"}, {0x677F, "ban"}, {0x6784, "gou"}, {0x679C, "guo"}, {0x67E5, "cha"},
+    {0x6807, "biao"}, {0x680F, "lan"}, {0x683C, "ge"}, {0x6848, "an"}, {0x684C, "zhuo"},
+    {0x6863, "dang"}, {0x6A21, "mo"}, {0x6B27, "ou"}, {0x6B4C, "ge"}, {0x6B64, "ci"}, {0x6BD2, "du"},
+    {0x6BD4, "bi"}, {0x6C14, "qi"}, {0x6C47, "hui"}, {0x6C60, "chi"}, {0x6CD5, "fa"}, {0x6CE8, "zhu"},
+    {0x6D01, "jie"}, {0x6D41, "liu"}, {0x6D4B, "ce"}, {0x6D4F, "liu"}, {0x6DD8, "tao"},
+    {0x6E05, "qing"}, {0x6E38, "you"}, {0x6E90, "yuan"}, {0x6EF4, "di"}, {0x6F14, "yan"},
+    {0x706B, "huo"}, {0x70B9, "dian"}, {0x70ED, "re"}, {0x7167, "zhao"}, {0x7231, "ai"},
+    {0x7247, "pian"}, {0x7248, "ban"}, {0x724C, "pai"}, {0x7259, "ya"}, {0x7269, "wu"}, {0x72D0, "hu"},
+    {0x72D7, "gou"}, {0x730E, "lie"}, {0x7387, "lv"}, {0x73AF, "huan"}, {0x7406, "li"},
+    {0x74DC, "gua"}, {0x74E3, "ban"}, {0x7528, "yong"}, {0x7535, "dian"}, {0x753B, "hua"},
+    {0x754C, "jie"}, {0x767B, "deng"}, {0x767E, "bai"}, {0x7684, "de"}, {0x76D1, "jian"},
+    {0x76D8, "pan"}, {0x76EE, "mu"}, {0x76F4, "zhi"}, {0x76F8, "xiang"}, {0x770B, "kan"},
+    {0x771F, "zhen"}, {0x7720, "mian"}, {0x77E5, "zhi"}, {0x77ED, "duan"}, {0x7801, "ma"},
+    {0x78C1, "ci"}, {0x793A, "shi"}, {0x793E, "she"}, {0x7968, "piao"}, {0x79C1, "si"},
+    {0x79D2, "miao"}, {0x79DF, "zu"}, {0x7A0B, "cheng"}, {0x7A3F, "gao"}, {0x7A81, "tu"},
+    {0x7A97, "chuang"}, {0x7AD9, "zhan"}, {0x7AEF, "duan"}, {0x7B14, "bi"}, {0x7B54, "da"},
+    {0x7B7E, "qian"}, {0x7B97, "suan"}, {0x7BA1, "guan"}, {0x7BB1, "xiang"}, {0x7C73, "mi"},
+    {0x7CFB, "xi"}, {0x7D22, "suo"}, {0x7EA7, "ji"}, {0x7EB8, "zhi"}, {0x7EBF, "xian"},
+    {0x7EC8, "zhong"}, {0x7ED8, "hui"}, {0x7EDC, "luo"}, {0x7EDF, "tong"}, {0x7EED, "xu"},
+    {0x7F16, "bian"}, {0x7F29, "suo"}, {0x7F51, "wang"}, {0x7F6E, "zhi"}, {0x7F72, "shu"},
+    {0x7F8E, "mei"}, {0x7FFB, "fan"}, {0x8000, "yao"}, {0x8003, "kao"}, {0x8033, "er"},
+    {0x804A, "liao"}, {0x8054, "lian"}, {0x80A1, "gu"}, {0x80B2, "yu"}, {0x80FD, "neng"},
+    {0x8111, "nao"}, {0x811A, "jiao"}, {0x817E, "teng"}, {0x822A, "hang"}, {0x8272, "se"},
+    {0x827A, "yi"}, {0x8282, "jie"}, {0x8292, "mang"}, {0x8363, "rong"}, {0x83DC, "cai"},
+    {0x84DD, "lan"}, {0x864E, "hu"}, {0x865A, "xu"}, {0x884C, "xing"}, {0x8868, "biao"},
+    {0x88C5, "zhuang"}, {0x897F, "xi"}, {0x89C2, "guan"}, {0x89C6, "shi"}, {0x89C8, "lan"},
+    {0x89E3, "jie"}, {0x89E6, "chu"}, {0x8A00, "yan"}, {0x8BA1, "ji"}, {0x8BAE, "yi"}, {0x8BAF, "xun"},
+    {0x8BB0, "ji"}, {0x8BBA, "lun"}, {0x8BBE, "she"}, {0x8BC1, "zheng"}, {0x8BCD, "ci"},
+    {0x8BD1, "yi"}, {0x8BD5, "shi"}, {0x8BDD, "hua"}, {0x8BED, "yu"}, {0x8BEF, "wu"}, {0x8BF5, "song"},
+    {0x8BFB, "du"}, {0x8C03, "tiao"}, {0x8C37, "gu"}, {0x8C46, "dou"}, {0x8C61, "xiang"},
+    {0x8C79, "bao"}, {0x8D26, "zhang"}, {0x8D2D, "gou"}, {0x8D34, "tie"}, {0x8D44, "zi"},
+    {0x8F66, "che"}, {0x8F6F, "ruan"}, {0x8F7D, "zai"}, {0x8F83, "jiao"}, {0x8F85, "fu"},
+    {0x8F91, "ji"}, {0x8F93, "shu"}, {0x8FC5, "xun"}, {0x8FD0, "yun"}, {0x8FD8, "huan"},
+    {0x8FDB, "jin"}, {0x8FDC, "yuan"}, {0x9000, "tui"}, {0x9001, "song"}, {0x901A, "tong"},
+    {0x901F, "su"}, {0x9053, "dao"}, {0x9068, "ao"}, {0x90AE, "you"}, {0x90E8, "bu"}, {0x9152, "jiu"},
+    {0x9177, "ku"}, {0x91CC, "li"}, {0x91CD, "chong"}, {0x91CF, "liang"}, {0x91D1, "jin"},
+    {0x9489, "ding"}, {0x949F, "zhong"}, {0x94A5, "yao"}, {0x94B1, "qian"}, {0x94C1, "tie"},
+    {0x94F6, "yin"}, {0x9500, "xiao"}, {0x9501, "suo"}, {0x9519, "cuo"}, {0x952E, "jian"},
+    {0x955C, "jing"}, {0x95ED, "bi"}, {0x95EE, "wen"}, {0x95F9, "nao"}, {0x95FB, "wen"},
+    {0x9605, "yue"}, {0x9632, "fang"}, {0x963F, "a"}, {0x9646, "lu"}, {0x9650, "xian"},
+    {0x9662, "yuan"}, {0x9686, "long"}, {0x9690, "yin"}, {0x96C6, "ji"}, {0x96F7, "lei"},
+    {0x9762, "mian"}, {0x97F3, "yin"}, {0x9879, "xiang"}, {0x9891, "pin"}, {0x9898, "ti"},
+    {0x98CE, "feng"}, {0x98DE, "fei"}, {0x997F, "e"}, {0x9988, "kui"}, {0x9B45, "mei"}, {0x9C7C, "yu"},
+    {0x9EA6, "mai"}, {0x9F20, "shu"}
+};
+
+/**
+ * @brief 将带声调的拼音字母还原为ASCII（ü记为v）
+ */
+char toneless(char32_t code_point) {
+    switch (code_point) {
+        case 0x0101: case 0x00E1: case 0x01CE: case 0x00E0: return 'a';
+        case 0x0113: case 0x00E9: case 0x011B: case 0x00E8: case 0x00EA: return 'e';
+        case 0x012B: case 0x00ED: case 0x01D0: case 0x00EC: return 'i';
+        case 0x014D: case 0x00F3: case 0x01D2: case 0x00F2: return 'o';
+        case 0x016B: case 0x00FA: case 0x01D4: case 0x00F9: return 'u';
+        case 0x00FC: case 0x01D6: case 0x01D8: case 0x01DA: case 0x01DC: return 'v';
+        case 0x0144: case 0x0148: case 0x01F9: return 'n';
+        case 0x1E3F: return 'm';
+        default:
+            return (code_point >= 'a' && code_point <= 'z') ? static_cast<char>(code_point) : 0;
+    }
+}
+
+} // namespace
+
+char32_t decodeUtf8(std::string_view text, size_t& pos) {
+    unsigned char lead = static_cast<unsigned char>(text[pos]);
+    int length = (lead < 0x80) ? 1 : ((lead >> 5) == 0x6) ? 2 : ((lead >> 4) == 0xE) ? 3 : ((lead >> 3) == 0x1E) ? 4 : 0;
+    if (length == 0 || pos + length > text.size()) {
+        ++pos;
+        return 0xFFFD;
+    }
+
+    char32_t code_point = (length == 1) ? lead : (lead & (0x7F >> length));
+    for (int i = 1; i < length; ++i) {
+        unsigned char next = static_cast<unsigned char>(text[pos + i]);
+        if ((next & 0xC0) != 0x80) {
+            ++pos;
+            return 0xFFFD;
+        }
+        code_point = (code_point << 6) | (next & 0x3F);
+    }
+    pos += length;
+    return code_point;
+}
+
+PinyinTable::PinyinTable() {
+    table_.reserve(sizeof(kBuiltinPinyin) / sizeof(kBuiltinPinyin[0]));
+    for (const auto& entry : kBuiltinPinyin) {
+        table_.emplace(entry.code_point, entry.pinyin);
+    }
+}
+
+bool PinyinTable::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 2, "U+") != 0) continue;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        char32_t code_point = static_cast<char32_t>(std::strtoul(line.c_str() + 2, nullptr, 16));
+        if (code_point == 0) continue;
+
+        // 只取第一个读音，并去掉声调
+        std::string pinyin;
+        size_t pos = line.find_first_not_of(' ', colon + 1);
+        while (pos != std::string::npos && pos < line.size() &&
+               line[pos] != ',' && line[pos] != ' ' && line[pos] != '#') {
+            char letter = toneless(decodeUtf8(line, pos));
+            if (letter) {
+                pinyin += letter;
+            }
+        }
+
+        if (!pinyin.empty()) {
+            table_[code_point] = pinyin;
+        }
+    }
+    return true;
+}
+
+const std::string* PinyinTable::lookup(char32_t code_point) const {
+    auto it = table_.find(code_point);
+    return it != table_.end() ? &it->second : nullptr;
+}
+
+bool PinyinTable::transliterate(std::string_view text, std::string& full, std::string& initials) const {
+    bool converted = false;
+    bool word_start = true;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        char32_t code_point = decodeUtf8(text, pos);
+        if (code_point < 0x80) {
+            char c = static_cast<char>(code_point);
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            bool alnum = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+            if (alnum) {
+                full += c;
+                if (word_start) initials += c;
+            }
+            word_start = !alnum;
+            continue;
+        }
+
+        const std::string* pinyin = lookup(code_point);
+        if (pinyin) {
+            full += *pinyin;
+            initials += (*pinyin)[0];
+            converted = true;
+        }
+        word_start = true;
+    }
+    return converted;
+}
+
+size_t PinyinTable::size() const {
+    return table_.size();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,76 @@
+/**
+ * @file pinyin.h
+ * @brief 汉字拼音表头文件
+ *
+ * 为开始菜单搜索提供汉字到拼音（不带声调）的转换，
+ * 内置应用名称常用字，可从pinyin-data格式的数据文件加载完整字表
+ */
+
+#ifndef CLOUDFLOW_PINYIN_H
+#define CLOUDFLOW_PINYIN_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @class PinyinTable
+ * @brief 汉字拼音表
+ *
+ * 多音字只保留第一个读音
+ */
+class PinyinTable {
+public:
+    /**
+     * @brief 构造函数，载入内置字表
+     */
+    PinyinTable();
+
+    /**
+     * @brief 从数据文件加载字表（格式：U+4E2D: zhōng,zhòng  # 中）
+     * @param path 数据文件路径
+     * @return 加载是否成功
+     */
+    bool loadFromFile(const std::string& path);
+
+    /**
+     * @brief 查询单个汉字的拼音
+     * @param code_point Unicode码点
+     * @return 拼音，不存在返回nullptr
+     */
+    const std::string* lookup(char32_t code_point) const;
+
+    /**
+     * @brief 将文本转换为全拼和首字母形式（ASCII字母转为小写保留）
+     * @param text UTF-8文本
+     * @param full 输出全拼
+     * @param initials 输出首字母
+     * @return 文本中是否含有可转换的汉字
+     */
+    bool transliterate(std::string_view text, std::string& full, std::string& initials) const;
+
+    /**
+     * @brief 获取字表大小
+     * @return 汉字数量
+     */
+    size_t size() const;
+
+private:
+    std::unordered_map<char32_t, std::string> table_;
+};
+
+/**
+ * @brief 解码一个UTF-8字符
+ * @param text 文本
+ * @param pos 当前位置，返回时指向下一个字符
+ * @return Unicode码点，非法序列返回U+FFFD
+ */
+char32_t decodeUtf8(std::string_view text, size_t& pos);
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_PINYIN_H
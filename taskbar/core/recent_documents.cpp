@@ -0,0 +1,717 @@
+/**
+ * @file recent_documents.cpp
+ * @brief 最近文档服务实现文件
+ */
+
+#include "recent_documents.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+// 合并连续写入的防抖间隔；持续写入时最迟在首次写入之后4倍间隔重新解析
+constexpr std::chrono::milliseconds kWatchDebounce(200);
+constexpr int kMaxDebounceFactor = 4;
+
+/**
+ * @brief 书签中记录的一次应用使用
+ */
+struct ApplicationUse {
+    std::string name_key;         ///< 应用名称（规范化）
+    std::string exec_key;         ///< 启动命令的程序名（规范化）
+    int64_t modified;             ///< 使用时间
+};
+
+/**
+ * @brief 解析后的书签
+ */
+struct ParsedBookmark {
+    RecentDocument document;
+    std::vector<ApplicationUse> applications;
+};
+
+/**
+ * @brief 以书签原文的散列为键缓存解析结果，原文不变的书签无需重新解析
+ */
+using BookmarkCache = std::unordered_map<uint64_t, std::shared_ptr<const ParsedBookmark>>;
+
+uint64_t hashBytes(std::string_view bytes) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief 读取标签中的属性原始值
+ */
+std::string_view attribute(std::string_view tag, std::string_view name) {
+    for (size_t pos = tag.find(name); pos != std::string_view::npos; pos = tag.find(name, pos + 1)) {
+        size_t eq = pos + name.size();
+        if (pos == 0 || (tag[pos - 1] != ' ' && tag[pos - 1] != '\t' && tag[pos - 1] != '\n')) continue;
+        if (eq + 1 >= tag.size() || tag[eq] != '=' || (tag[eq + 1] != '"' && tag[eq + 1] != '\'')) continue;
+
+        char quote = tag[eq + 1];
+        size_t end = tag.find(quote, eq + 2);
+        if (end == std::string_view::npos) return {};
+        return tag.substr(eq + 2, end - eq - 2);
+    }
+    return {};
+}
+
+std::string decodeEntities(std::string_view text) {
+    static const struct { std::string_view entity; char value; } kEntities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''},
+    };
+
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '&') {
+            bool decoded = false;
+            for (const auto& entry : kEntities) {
+                if (text.compare(i, entry.entity.size(), entry.entity) == 0) {
+                    out += entry.value;
+                    i += entry.entity.size() - 1;
+                    decoded = true;
+                    break;
+                }
+            }
+            if (decoded) continue;
+        }
+        out += text[i];
+    }
+    return out;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string percentDecode(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '%' && i + 2 < text.size() && hexValue(text[i + 1]) >= 0 && hexValue(text[i + 2]) >= 0) {
+            out += static_cast<char>(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief 解析ISO 8601时间（如2026-03-01T08:30:00.123456Z），按UTC处理
+ */
+int64_t parseTimestamp(std::string_view text) {
+    char buffer[32];
+    size_t length = std::min(text.size(), sizeof(buffer) - 1);
+    std::memcpy(buffer, text.data(), length);
+    buffer[length] = '\0';
+
+    struct tm tm = {};
+    if (std::sscanf(buffer, "%4d-%2d-%2dT%2d:%2d:%2d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                    &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        return 0;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    return static_cast<int64_t>(timegm(&tm));
+}
+
+/**
+ * @brief 规范化应用标识：去掉目录和.desktop后缀并转为小写
+ */
+std::string normalizeKey(std::string_view app_id) {
+    size_t slash = app_id.rfind('/');
+    if (slash != std::string_view::npos) app_id.remove_prefix(slash + 1);
+    if (app_id.size() > 8 && app_id.substr(app_id.size() - 8) == ".desktop") app_id.remove_suffix(8);
+
+    std::string key(app_id);
+    for (char& c : key) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return key;
+}
+
+/**
+ * @brief 从启动命令（如'gedit %u'）中取出程序名
+ */
+std::string execProgram(std::string_view exec) {
+    std::string command = decodeEntities(exec);
+    size_t begin = command.find_first_not_of(" \t'\"");
+    if (begin == std::string::npos) return {};
+    size_t end = command.find_first_of(" \t'\"", begin);
+    return normalizeKey(std::string_view(command).substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+}
+
+std::shared_ptr<const ParsedBookmark> parseBookmark(std::string_view block) {
+    std::string_view open_tag = block.substr(0, block.find('>'));
+    std::string_view href = attribute(open_tag, "href");
+    if (href.empty()) return nullptr;
+
+    auto bookmark = std::make_shared<ParsedBookmark>();
+    RecentDocument& document = bookmark->document;
+    document.uri = decodeEntities(href);
+
+    std::string_view path(document.uri);
+    while (path.size() > 1 && path.back() == '/') path.remove_suffix(1);
+    size_t slash = path.rfind('/');
+    document.display_name = percentDecode(slash == std::string_view::npos ? path : path.substr(slash + 1));
+
+    size_t mime_pos = block.find("<mime:mime-type");
+    if (mime_pos != std::string_view::npos) {
+        std::string_view tag = block.substr(mime_pos, block.find('>', mime_pos) - mime_pos);
+        document.mime_type = decodeEntities(attribute(tag, "type"));
+    }
+
+    std::string_view fallback = attribute(open_tag, "modified");
+    if (fallback.empty()) fallback = attribute(open_tag, "visited");
+    document.modified = parseTimestamp(fallback);
+
+    for (size_t pos = block.find("<bookmark:application "); pos != std::string_view::npos;
+         pos = block.find("<bookmark:application ", pos + 1)) {
+        std::string_view tag = block.substr(pos, block.find('>', pos) - pos);
+
+        ApplicationUse use;
+        use.name_key = normalizeKey(decodeEntities(attribute(tag, "name")));
+        use.exec_key = execProgram(attribute(tag, "exec"));
+        if (use.exec_key == use.name_key) use.exec_key.clear();
+
+        // 旧版格式使用timestamp属性（Unix时间）
+        std::string_view modified = attribute(tag, "modified");
+        std::string_view timestamp = attribute(tag, "timestamp");
+        if (!modified.empty()) {
+            use.modified = parseTimestamp(modified);
+        } else if (!timestamp.empty()) {
+            use.modified = std::strtoll(std::string(timestamp).c_str(), nullptr, 10);
+        } else {
+            use.modified = document.modified;
+        }
+
+        if (!use.name_key.empty() || !use.exec_key.empty()) {
+            bookmark->applications.push_back(std::move(use));
+        }
+    }
+    return bookmark;
+}
+
+std::string defaultPath() {
+    const char* data_home = std::getenv("XDG_DATA_HOME");
+    if (data_home && *data_home) {
+        return std::string(data_home) + "/recently-used.xbel";
+    }
+    const char* home = std::getenv("HOME");
+    return std::string(home ? home : "") + "/.local/share/recently-used.xbel";
+}
+
+} // namespace
+
+// RecentDocuments 实现类
+class RecentDocuments::Impl {
+public:
+    Impl(const std::string& path, size_t per_app_limit, size_t app_limit)
+        : path_(path.empty() ? defaultPath() : path),
+          per_app_limit_(std::max<size_t>(1, per_app_limit)),
+          app_limit_(std::max<size_t>(1, app_limit)),
+          file_size_(-1),
+          file_mtime_ns_(-1),
+          file_inode_(0),
+          reused_count_(0),
+          inotify_fd_(-1) {
+        stop_pipe_[0] = stop_pipe_[1] = -1;
+    }
+
+    ~Impl() {
+        stopWatching();
+    }
+
+    bool load() {
+        std::lock_guard<std::mutex> build_lock(build_mutex_);
+        return reloadLocked(nullptr);
+    }
+
+    bool startWatching() {
+        if (watch_thread_.joinable()) return true;
+
+        size_t slash = path_.rfind('/');
+        std::string directory = (slash == std::string::npos) ? "." : path_.substr(0, std::max<size_t>(slash, 1));
+        file_name_ = (slash == std::string::npos) ? path_ : path_.substr(slash + 1);
+
+        if (pipe2(stop_pipe_, O_CLOEXEC) != 0) {
+            setError(std::string("无法创建管道: ") + std::strerror(errno));
+            closeWatchFds();
+            return false;
+        }
+
+        // 写入方通常先写临时文件再重命名，因此监视所在目录；
+        // inotify不可用时线程仍完成首次解析，只是之后不再跟踪变化
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0) {
+            setError(std::string("无法创建inotify监视: ") + std::strerror(errno));
+        } else if (inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+            setError("无法监视目录: " + directory);
+            close(inotify_fd_);
+            inotify_fd_ = -1;
+        }
+
+        watch_thread_ = std::thread([this]() { watchLoop(); });
+        return true;
+    }
+
+    void stopWatching() {
+        if (!watch_thread_.joinable()) return;
+
+        char byte = 0;
+        (void)write(stop_pipe_[1], &byte, 1);
+        watch_thread_.join();
+        closeWatchFds();
+    }
+
+    std::shared_ptr<const RecentDocumentList> query(const std::string& app_id) const {
+        std::string key = normalizeKey(app_id);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = lists_.find(key);
+        if (it != lists_.end()) return it->second;
+
+        // 反向域名形式的desktop文件ID（如org.gnome.gedit）再按最后一段查找
+        size_t dot = key.rfind('.');
+        if (dot != std::string::npos) {
+            it = lists_.find(key.substr(dot + 1));
+            if (it != lists_.end()) return it->second;
+        }
+        return nullptr;
+    }
+
+    void touch(const std::string& app_id, const RecentDocument& document) {
+        std::string key = normalizeKey(app_id);
+        if (key.empty()) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto list = std::make_shared<RecentDocumentList>();
+        list->reserve(per_app_limit_);
+        list->push_back(document);
+
+        auto it = lists_.find(key);
+        if (it != lists_.end()) {
+            for (const auto& existing : *it->second) {
+                if (list->size() >= per_app_limit_) break;
+                if (existing.uri != document.uri) list->push_back(existing);
+            }
+        } else if (lists_.size() >= app_limit_ * 2) {
+            evictOldestLocked();
+        }
+        lists_[key] = std::move(list);
+
+        // 记下尚未写入文件的使用，重新解析后合并回列表
+        RecentDocumentList& touched = touched_[key];
+        touched.erase(std::remove_if(touched.begin(), touched.end(), [&document](const RecentDocument& entry) {
+            return entry.uri == document.uri;
+        }), touched.end());
+        touched.insert(touched.begin(), document);
+        if (touched.size() > per_app_limit_) touched.resize(per_app_limit_);
+        if (touched_.size() > app_limit_ * 2) {
+            auto oldest = std::min_element(touched_.begin(), touched_.end(), [](const auto& a, const auto& b) {
+                return a.second.front().modified < b.second.front().modified;
+            });
+            touched_.erase(oldest);
+        }
+    }
+
+    void setChangeCallback(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        change_callback_ = std::move(callback);
+    }
+
+    size_t getReusedBookmarkCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reused_count_;
+    }
+
+    std::string getLastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return last_error_;
+    }
+
+private:
+    /**
+     * @brief 重新解析文件（需持有build_mutex_）
+     * @param changed 输出列表是否变化
+     */
+    bool reloadLocked(bool* changed) {
+        if (changed) *changed = false;
+
+        int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            if (errno != ENOENT) {
+                setError("无法打开最近文档文件: " + path_);
+                return false;
+            }
+            // 文件不存在视为没有最近文档
+            if (file_size_ != -1) {
+                file_size_ = -1;
+                file_mtime_ns_ = -1;
+                cache_.clear();
+                publish({}, 0);
+                if (changed) *changed = true;
+            }
+            return true;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            setError("无法读取最近文档文件: " + path_);
+            return false;
+        }
+
+        int64_t mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+        if (st.st_size == file_size_ && mtime_ns == file_mtime_ns_ && st.st_ino == file_inode_) {
+            close(fd);
+            return true;
+        }
+
+        std::string content(static_cast<size_t>(st.st_size), '\0');
+        size_t offset = 0;
+        while (offset < content.size()) {
+            ssize_t length = read(fd, &content[offset], content.size() - offset);
+            if (length <= 0) break;
+            offset += static_cast<size_t>(length);
+        }
+        close(fd);
+        content.resize(offset);
+
+        file_size_ = st.st_size;
+        file_mtime_ns_ = mtime_ns;
+        file_inode_ = st.st_ino;
+
+        parse(content);
+        if (changed) *changed = true;
+        return true;
+    }
+
+    void parse(std::string_view content) {
+        BookmarkCache cache;
+        std::vector<std::shared_ptr<const ParsedBookmark>> bookmarks;
+        size_t reused = 0;
+
+        for (size_t begin = content.find("<bookmark "); begin != std::string_view::npos;
+             begin = content.find("<bookmark ", begin + 1)) {
+            size_t end = content.find("</bookmark>", begin);
+            size_t open_end = content.find('>', begin);
+            if (open_end == std::string_view::npos) break;
+
+            // 自闭合书签没有应用信息
+            if (content[open_end - 1] == '/' && (end == std::string_view::npos || open_end < end)) {
+                continue;
+            }
+            if (end == std::string_view::npos) break;
+
+            std::string_view block = content.substr(begin, end - begin);
+            uint64_t hash = hashBytes(block);
+            auto cached = cache_.find(hash);
+            std::shared_ptr<const ParsedBookmark> bookmark;
+            if (cached != cache_.end()) {
+                bookmark = cached->second;
+                reused++;
+            } else {
+                bookmark = parseBookmark(block);
+            }
+
+            if (bookmark) {
+                cache.emplace(hash, bookmark);
+                bookmarks.push_back(std::move(bookmark));
+            }
+            begin = end;
+        }
+
+        cache_ = std::move(cache);
+        publish(buildLists(bookmarks), reused);
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const RecentDocumentList>>
+    buildLists(const std::vector<std::shared_ptr<const ParsedBookmark>>& bookmarks) const {
+        struct Candidate {
+            int64_t modified;
+            const RecentDocument* document;
+        };
+
+        std::unordered_map<std::string, std::vector<Candidate>> by_app;
+        for (const auto& bookmark : bookmarks) {
+            for (const auto& use : bookmark->applications) {
+                if (!use.name_key.empty()) by_app[use.name_key].push_back({use.modified, &bookmark->document});
+                if (!use.exec_key.empty()) by_app[use.exec_key].push_back({use.modified, &bookmark->document});
+            }
+        }
+
+        auto newer = [](const Candidate& a, const Candidate& b) {
+            return a.modified > b.modified;
+        };
+
+        // 应用数量超出上限时只保留最近活跃的应用（名称和程序名各占一个键）
+        std::vector<std::pair<int64_t, const std::string*>> activity;
+        activity.reserve(by_app.size());
+        for (const auto& app : by_app) {
+            int64_t latest = std::max_element(app.second.begin(), app.second.end(), [](const Candidate& a, const Candidate& b) {
+                return a.modified < b.modified;
+            })->modified;
+            activity.push_back({latest, &app.first});
+        }
+        size_t key_limit = app_limit_ * 2;
+        if (activity.size() > key_limit) {
+            std::nth_element(activity.begin(), activity.begin() + key_limit, activity.end(),
+                             [](const auto& a, const auto& b) { return a.first > b.first; });
+            activity.resize(key_limit);
+        }
+
+        std::unordered_map<std::string, std::shared_ptr<const RecentDocumentList>> lists;
+        lists.reserve(activity.size());
+        for (const auto& entry : activity) {
+            std::vector<Candidate>& candidates = by_app[*entry.second];
+            size_t count = std::min(candidates.size(), per_app_limit_);
+            std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), newer);
+
+            auto list = std::make_shared<RecentDocumentList>();
+            list->reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                list->push_back(*candidates[i].document);
+                list->back().modified = candidates[i].modified;
+            }
+            lists.emplace(*entry.second, std::move(list));
+        }
+        return lists;
+    }
+
+    void publish(std::unordered_map<std::string, std::shared_ptr<const RecentDocumentList>> lists, size_t reused) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mergeTouchesLocked(lists);
+        lists_ = std::move(lists);
+        reused_count_ = reused;
+    }
+
+    /**
+     * @brief 把touch()记录的使用合并到新解析的列表最前（需持有mutex_）
+     *
+     * 文件中已出现的文档说明写入方已记录，不再保留在内存中
+     */
+    void mergeTouchesLocked(std::unordered_map<std::string, std::shared_ptr<const RecentDocumentList>>& lists) {
+        for (auto it = touched_.begin(); it != touched_.end();) {
+            auto parsed = lists.find(it->first);
+            RecentDocumentList& touched = it->second;
+            if (parsed != lists.end()) {
+                const RecentDocumentList& documents = *parsed->second;
+                touched.erase(std::remove_if(touched.begin(), touched.end(), [&documents](const RecentDocument& entry) {
+                    return std::any_of(documents.begin(), documents.end(), [&entry](const RecentDocument& document) {
+                        return document.uri == entry.uri;
+                    });
+                }), touched.end());
+            }
+            if (touched.empty()) {
+                it = touched_.erase(it);
+                continue;
+            }
+
+            auto list = std::make_shared<RecentDocumentList>(touched);
+            if (parsed != lists.end()) {
+                for (const auto& document : *parsed->second) {
+                    if (list->size() >= per_app_limit_) break;
+                    list->push_back(document);
+                }
+            }
+            lists[it->first] = std::move(list);
+            ++it;
+        }
+    }
+
+    void evictOldestLocked() {
+        auto oldest = lists_.end();
+        for (auto it = lists_.begin(); it != lists_.end(); ++it) {
+            if (oldest == lists_.end() || it->second->empty() ||
+                (!oldest->second->empty() && it->second->front().modified < oldest->second->front().modified)) {
+                oldest = it;
+            }
+        }
+        if (oldest != lists_.end()) lists_.erase(oldest);
+    }
+
+    void watchLoop() {
+        // 首次解析也在监视线程中完成，不阻塞调用startWatching()的线程
+        bool initial_changed = false;
+        {
+            std::lock_guard<std::mutex> build_lock(build_mutex_);
+            reloadLocked(&initial_changed);
+        }
+        if (initial_changed) notifyChange();
+
+        bool pending = false;
+        std::chrono::steady_clock::time_point first_event;
+        std::chrono::steady_clock::time_point deadline;
+        alignas(struct inotify_event) char buffer[4096];
+
+        while (true) {
+            struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {stop_pipe_[0], POLLIN, 0}};
+            // 有未处理的写入时等到防抖截止时间，合并连续写入
+            int timeout = -1;
+            if (pending) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                timeout = static_cast<int>(std::max<int64_t>(0, remaining));
+            }
+            int ready = poll(fds, 2, timeout);
+            if (ready < 0 && errno != EINTR) return;
+            if (fds[1].revents & POLLIN) return;
+
+            if (ready > 0 && inotify_fd_ >= 0 && readEvents(buffer, sizeof(buffer))) {
+                // 每次写入推后截止时间，但最迟在首次写入之后kMaxDebounceFactor倍间隔解析
+                auto now = std::chrono::steady_clock::now();
+                if (!pending) first_event = now;
+                deadline = std::min(now + kWatchDebounce, first_event + kWatchDebounce * kMaxDebounceFactor);
+                pending = true;
+            }
+
+            if (pending && std::chrono::steady_clock::now() >= deadline) {
+                pending = false;
+                bool changed = false;
+                {
+                    std::lock_guard<std::mutex> build_lock(build_mutex_);
+                    reloadLocked(&changed);
+                }
+                if (changed) notifyChange();
+            }
+        }
+    }
+
+    /**
+     * @brief 读取所有可读的inotify事件
+     * @return 是否有涉及书签文件的事件
+     */
+    bool readEvents(char* buffer, size_t buffer_size) {
+        bool relevant = false;
+        ssize_t length;
+        while ((length = read(inotify_fd_, buffer, buffer_size)) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(p);
+                if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && file_name_ == event->name)) {
+                    relevant = true;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return relevant;
+    }
+
+    void notifyChange() {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = change_callback_;
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    void setError(const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_error_ = error;
+    }
+
+    void closeWatchFds() {
+        for (int* fd : {&inotify_fd_, &stop_pipe_[0], &stop_pipe_[1]}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    const std::string path_;
+    const size_t per_app_limit_;
+    const size_t app_limit_;
+    std::string file_name_;
+
+    // 解析状态（build_mutex_保护）
+    std::mutex build_mutex_;
+    BookmarkCache cache_;
+    int64_t file_size_;
+    int64_t file_mtime_ns_;
+    ino_t file_inode_;
+
+    // 查询状态（mutex_保护）
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const RecentDocumentList>> lists_;
+    std::unordered_map<std::string, RecentDocumentList> touched_;
+    std::function<void()> change_callback_;
+    size_t reused_count_;
+    std::string last_error_;
+
+    int inotify_fd_;
+    int stop_pipe_[2];
+    std::thread watch_thread_;
+};
+
+// RecentDocuments 实现
+RecentDocuments::RecentDocuments(const std::string& path, size_t per_app_limit, size_t app_limit)
+    : impl_(std::make_unique<Impl>(path, per_app_limit, app_limit)) {}
+
+RecentDocuments::~RecentDocuments() = default;
+
+bool RecentDocuments::load() {
+    return impl_->load();
+}
+
+bool RecentDocuments::startWatching() {
+    return impl_->startWatching();
+}
+
+void RecentDocuments::stopWatching() {
+    impl_->stopWatching();
+}
+
+std::shared_ptr<const RecentDocumentList> RecentDocuments::query(const std::string& app_id) const {
+    return impl_->query(app_id);
+}
+
+void RecentDocuments::touch(const std::string& app_id, const RecentDocument& document) {
+    impl_->touch(app_id, document);
+}
+
+void RecentDocuments::setChangeCallback(std::function<void()> callback) {
+    impl_->setChangeCallback(std::move(callback));
+}
+
+size_t RecentDocuments::getReusedBookmarkCount() const {
+    return impl_->getReusedBookmarkCount();
+}
+
+std::string RecentDocuments::getLastError() const {
+    return impl_->getLastError();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,128 @@
+/**
+ * @file recent_documents.h
+ * @brief 最近文档服务头文件
+ *
+ * 解析recently-used.xbel，为任务栏项的跳转列表提供每个应用最近使用的文档。
+ * 文件变化时由inotify触发在后台重新解析，未变化的书签沿用上次的解析结果；
+ * 查询只读取内存中的有界列表，不访问文件系统
+ */
+
+#ifndef CLOUDFLOW_RECENT_DOCUMENTS_H
+#define CLOUDFLOW_RECENT_DOCUMENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct RecentDocument
+ * @brief 最近文档项
+ */
+struct RecentDocument {
+    std::string uri;              ///< 文档URI
+    std::string display_name;     ///< 显示名称（URI最后一段，已解码）
+    std::string mime_type;        ///< MIME类型
+    int64_t modified;             ///< 该应用最近一次使用的时间（Unix时间，秒）
+
+    RecentDocument() : modified(0) {}
+};
+
+/**
+ * @brief 最近文档列表（按使用时间从新到旧排列）
+ */
+using RecentDocumentList = std::vector<RecentDocument>;
+
+/**
+ * @class RecentDocuments
+ * @brief 最近文档服务
+ *
+ * 每个应用按名称和启动命令的程序名（均为小写）各建一个索引，
+ * 每个列表最多保留per_app_limit项，最多保留最近活跃的app_limit个应用
+ */
+class RecentDocuments {
+public:
+    /**
+     * @brief 构造函数
+     * @param path xbel文件路径，为空时使用$XDG_DATA_HOME/recently-used.xbel
+     * @param per_app_limit 每个应用保留的文档数量
+     * @param app_limit 保留的应用数量
+     */
+    explicit RecentDocuments(const std::string& path = "", size_t per_app_limit = 10, size_t app_limit = 128);
+
+    /**
+     * @brief 析构函数，停止监视线程
+     */
+    ~RecentDocuments();
+
+    // 禁用拷贝和赋值
+    RecentDocuments(const RecentDocuments&) = delete;
+    RecentDocuments& operator=(const RecentDocuments&) = delete;
+
+    /**
+     * @brief 加载文件（文件不存在时得到空列表）
+     * @return 加载是否成功
+     */
+    bool load();
+
+    /**
+     * @brief 启动监视线程：先在线程中完成首次解析，再通过inotify监视文件所在目录并在变化时重新解析
+     *
+     * inotify不可用时仍完成首次解析，错误通过getLastError()获取
+     * @return 监视线程是否启动
+     */
+    bool startWatching();
+
+    /**
+     * @brief 停止监视
+     */
+    void stopWatching();
+
+    /**
+     * @brief 查询应用的最近文档
+     * @param app_id 应用名称、可执行文件名或desktop文件ID（不区分大小写）
+     * @return 文档列表，没有记录时返回空指针
+     */
+    std::shared_ptr<const RecentDocumentList> query(const std::string& app_id) const;
+
+    /**
+     * @brief 在内存中记录一次文档使用，移到该应用列表最前
+     *
+     * 文件重新解析后该记录仍保留在列表最前，直到文件中出现同一文档
+     * @param app_id 应用标识
+     * @param document 文档
+     */
+    void touch(const std::string& app_id, const RecentDocument& document);
+
+    /**
+     * @brief 设置列表变化回调（在监视线程中调用）
+     * @param callback 回调函数
+     */
+    void setChangeCallback(std::function<void()> callback);
+
+    /**
+     * @brief 获取最近一次解析中沿用上次结果的书签数量
+     * @return 沿用的书签数量
+     */
+    size_t getReusedBookmarkCount() const;
+
+    /**
+     * @brief 获取错误信息
+     * @return 错误描述
+     */
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_RECENT_DOCUMENTS_H
@@ -0,0 +1,73 @@
+/**
+ * @file sparkline.cpp
+ * @brief 托盘项历史曲线实现文件
+ */
+
+#include "sparkline.h"
+#include <algorithm>
+#include <cstring>
+
+namespace CloudFlow {
+namespace Desktop {
+
+void SparklineHistory::Ring::push(float value) {
+    constexpr size_t capacity = Sparkline::kCapacity;
+    size_t slot;
+    float evicted = 0;
+    if (count < capacity) {
+        slot = head + count;
+        count++;
+    } else {
+        slot = head;
+        evicted = points[head];
+        head = (head + 1) % capacity;
+    }
+
+    // slot可能落在第二份副本中，两份都写入
+    slot %= capacity;
+    points[slot] = value;
+    points[slot + capacity] = value;
+
+    // 只有移出的点恰好是最大值时才需要重新扫描
+    if (value >= peak) {
+        peak = value;
+    } else if (count == capacity && evicted >= peak) {
+        peak = *std::max_element(points + head, points + head + count);
+    }
+}
+
+SparklineHistory::SparklineHistory(size_t coarse_factor)
+    : coarse_factor_(std::max<size_t>(1, coarse_factor)),
+      coarse_sum_(0),
+      coarse_samples_(0) {}
+
+void SparklineHistory::add(float value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    minute_.push(value);
+
+    coarse_sum_ += value;
+    if (++coarse_samples_ == coarse_factor_) {
+        ten_minutes_.push(coarse_sum_ / static_cast<float>(coarse_factor_));
+        coarse_sum_ = 0;
+        coarse_samples_ = 0;
+    }
+}
+
+void SparklineHistory::copy(SparklineRange range, Sparkline& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Ring& ring = (range == SparklineRange::Minute) ? minute_ : ten_minutes_;
+    std::memcpy(out.points, ring.points + ring.head, ring.count * sizeof(float));
+    out.count = ring.count;
+    out.peak = ring.peak;
+}
+
+void SparklineHistory::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    minute_ = Ring();
+    ten_minutes_ = Ring();
+    coarse_sum_ = 0;
+    coarse_samples_ = 0;
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,91 @@
+/**
+ * @file sparkline.h
+ * @brief 托盘项历史曲线头文件
+ *
+ * 每个指标保存两条固定长度的环形缓冲区：最近60秒（每次采样一个点）
+ * 和最近10分钟（每10次采样合并为一个点），均在采样时增量维护。
+ * 缓冲区写成两份相邻的副本，任意时刻的窗口都是连续内存，
+ * 显示工具提示时直接memcpy，无需重新降采样
+ */
+
+#ifndef CLOUDFLOW_SPARKLINE_H
+#define CLOUDFLOW_SPARKLINE_H
+
+#include "taskbar.h"
+#include <cstddef>
+#include <mutex>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @enum SparklineRange
+ * @brief 历史曲线的时间范围
+ */
+enum class SparklineRange {
+    Minute,       ///< 最近60个采样（默认1秒一次，即60秒）
+    TenMinutes    ///< 最近60个合并点（每点10个采样，即10分钟）
+};
+
+/**
+ * @class SparklineHistory
+ * @brief 单个指标的历史曲线（线程安全，采样线程写入，界面线程读取）
+ */
+class SparklineHistory {
+public:
+    /**
+     * @brief 构造函数
+     * @param coarse_factor 10分钟视图中每个点合并的采样数
+     */
+    explicit SparklineHistory(size_t coarse_factor = 10);
+
+    // 禁用拷贝和赋值
+    SparklineHistory(const SparklineHistory&) = delete;
+    SparklineHistory& operator=(const SparklineHistory&) = delete;
+
+    /**
+     * @brief 添加一个采样
+     * @param value 采样值
+     */
+    void add(float value);
+
+    /**
+     * @brief 复制指定范围的曲线
+     * @param range 时间范围
+     * @param out 输出曲线
+     */
+    void copy(SparklineRange range, Sparkline& out) const;
+
+    /**
+     * @brief 清除历史
+     */
+    void clear();
+
+private:
+    /**
+     * @brief 环形缓冲区，每个点同时写入i和i+kCapacity，
+     *        最近count个点总是从head开始的连续区间
+     */
+    struct Ring {
+        float points[Sparkline::kCapacity * 2];
+        size_t head;              ///< 最旧点的下标
+        size_t count;
+        float peak;               ///< 最近count个点的最大值
+
+        Ring() : points{}, head(0), count(0), peak(0) {}
+        void push(float value);
+    };
+
+    const size_t coarse_factor_;
+
+    mutable std::mutex mutex_;
+    Ring minute_;
+    Ring ten_minutes_;
+    float coarse_sum_;            ///< 当前未满合并点的采样和
+    size_t coarse_samples_;       ///< 当前未满合并点的采样数
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_SPARKLINE_H
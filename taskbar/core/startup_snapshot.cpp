@@ -0,0 +1,329 @@
+/**
+ * @file startup_snapshot.cpp
+ * @brief 任务栏启动快照实现文件
+ */
+
+#include "startup_snapshot.h"
+#include "config_persister.h"
+#include <fstream>
+#include <iterator>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'F', 'T', 'S'};
+constexpr uint32_t kVersion = 1;
+
+// 快照只有几KB，超过该大小视为损坏
+constexpr size_t kMaxSnapshotSize = 1 << 20;
+
+/**
+ * @brief 小端序二进制编码
+ */
+class Encoder {
+public:
+    void u8(uint8_t value) { data_.push_back(static_cast<char>(value)); }
+
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            u8(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    void u64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            u8(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    void i32(int value) { u32(static_cast<uint32_t>(value)); }
+    void boolean(bool value) { u8(value ? 1 : 0); }
+
+    void string(const std::string& text) {
+        u32(static_cast<uint32_t>(text.size()));
+        data_.append(text);
+    }
+
+    const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+/**
+ * @brief 带边界检查的解码，任一读取越界后所有读取都失败
+ */
+class Decoder {
+public:
+    Decoder(const std::string& data, size_t offset) : data_(data), pos_(offset), ok_(true) {}
+
+    bool u8(uint8_t& value) {
+        if (!ok_ || pos_ >= data_.size()) return ok_ = false;
+        value = static_cast<uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    bool u32(uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint8_t byte = 0;
+            if (!u8(byte)) return false;
+            value |= static_cast<uint32_t>(byte) << (i * 8);
+        }
+        return true;
+    }
+
+    bool u64(uint64_t& value) {
+        value = 0;
+        for (int i = 0; i < 8; ++i) {
+            uint8_t byte = 0;
+            if (!u8(byte)) return false;
+            value |= static_cast<uint64_t>(byte) << (i * 8);
+        }
+        return true;
+    }
+
+    bool i32(int& value) {
+        uint32_t raw = 0;
+        if (!u32(raw)) return false;
+        value = static_cast<int>(static_cast<int32_t>(raw));
+        return true;
+    }
+
+    bool boolean(bool& value) {
+        uint8_t raw = 0;
+        if (!u8(raw) || raw > 1) return ok_ = false;
+        value = (raw == 1);
+        return true;
+    }
+
+    bool string(std::string& text) {
+        uint32_t size = 0;
+        if (!u32(size) || size > data_.size() - pos_) return ok_ = false;
+        text.assign(data_, pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool atEnd() const { return ok_ && pos_ == data_.size(); }
+
+private:
+    const std::string& data_;
+    size_t pos_;
+    bool ok_;
+};
+
+uint64_t checksum(const std::string& data, size_t offset) {
+    InputHasher hasher;
+    hasher.add(data.substr(offset));
+    return hasher.value();
+}
+
+bool encodeCommand(Encoder& encoder, const DisplayList& list, const DisplayList::Command& command) {
+    encoder.u8(static_cast<uint8_t>(command.op));
+    encoder.u8(command.flags);
+    switch (command.op) {
+        case DisplayList::Op::Background:
+        case DisplayList::Op::StartMenuButton:
+            return true;
+        case DisplayList::Op::QuickLaunchItem: {
+            const QuickLaunchItem& item = list.quickLaunchItem(command);
+            encoder.string(item.id);
+            encoder.string(item.name);
+            encoder.string(item.icon_path);
+            encoder.string(item.executable_path);
+            encoder.u32(static_cast<uint32_t>(item.arguments.size()));
+            for (const auto& argument : item.arguments) {
+                encoder.string(argument);
+            }
+            encoder.i32(item.launch_count);
+            encoder.boolean(item.visible);
+            return true;
+        }
+        case DisplayList::Op::SystemTrayItem: {
+            const SystemTrayItem& item = list.systemTrayItem(command);
+            encoder.string(item.id);
+            encoder.string(item.name);
+            encoder.string(item.icon_path);
+            encoder.string(item.tooltip);
+            encoder.boolean(item.visible);
+            encoder.boolean(item.active);
+            return true;
+        }
+        default:
+            // 窗口列表的命令不进入快照
+            return false;
+    }
+}
+
+bool decodeCommand(Decoder& decoder, DisplayListRecorder& recorder) {
+    static const TaskbarAppearance kAppearance;
+
+    uint8_t op = 0;
+    uint8_t flags = 0;
+    if (!decoder.u8(op) || !decoder.u8(flags)) return false;
+
+    switch (static_cast<DisplayList::Op>(op)) {
+        case DisplayList::Op::Background:
+            recorder.renderBackground(kAppearance);
+            return true;
+        case DisplayList::Op::StartMenuButton:
+            recorder.renderStartMenuButton(kAppearance, (flags & 0x1) != 0);
+            return true;
+        case DisplayList::Op::QuickLaunchItem: {
+            QuickLaunchItem item;
+            uint32_t argument_count = 0;
+            if (!decoder.string(item.id) || !decoder.string(item.name) || !decoder.string(item.icon_path) ||
+                !decoder.string(item.executable_path) || !decoder.u32(argument_count)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < argument_count; ++i) {
+                std::string argument;
+                if (!decoder.string(argument)) return false;
+                item.arguments.push_back(std::move(argument));
+            }
+            if (!decoder.i32(item.launch_count) || !decoder.boolean(item.visible)) return false;
+            recorder.renderQuickLaunchItem(item, kAppearance);
+            return true;
+        }
+        case DisplayList::Op::SystemTrayItem: {
+            SystemTrayItem item;
+            if (!decoder.string(item.id) || !decoder.string(item.name) || !decoder.string(item.icon_path) ||
+                !decoder.string(item.tooltip) || !decoder.boolean(item.visible) || !decoder.boolean(item.active)) {
+                return false;
+            }
+            recorder.renderSystemTrayItem(item, kAppearance);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool decode(const std::string& data, StartupSnapshot& snapshot) {
+    Decoder decoder(data, sizeof(kMagic) + 4 + 8);
+
+    uint8_t position = 0;
+    uint8_t style = 0;
+    if (!decoder.u8(position) || position > static_cast<uint8_t>(TaskbarPosition::Right) ||
+        !decoder.u8(style) || style > static_cast<uint8_t>(TaskbarStyle::Compact) ||
+        !decoder.i32(snapshot.appearance.height) ||
+        !decoder.boolean(snapshot.appearance.auto_hide) ||
+        !decoder.boolean(snapshot.appearance.always_on_top) ||
+        !decoder.boolean(snapshot.appearance.show_clock) ||
+        !decoder.boolean(snapshot.appearance.show_system_tray) ||
+        !decoder.boolean(snapshot.appearance.group_windows) ||
+        !decoder.i32(snapshot.width) || !decoder.i32(snapshot.height) ||
+        !decoder.boolean(snapshot.clock_format.show_date) ||
+        !decoder.boolean(snapshot.clock_format.show_seconds) ||
+        !decoder.string(snapshot.clock_format.time_format) ||
+        !decoder.string(snapshot.clock_format.date_format)) {
+        return false;
+    }
+    snapshot.appearance.position = static_cast<TaskbarPosition>(position);
+    snapshot.appearance.style = static_cast<TaskbarStyle>(style);
+
+    uint32_t component_count = 0;
+    if (!decoder.u32(component_count) || component_count > kTaskbarComponentCount) return false;
+    for (uint32_t i = 0; i < component_count; ++i) {
+        StartupSnapshot::Component component;
+        uint8_t id = 0;
+        uint32_t command_count = 0;
+        if (!decoder.u8(id) || id >= kTaskbarComponentCount ||
+            !decoder.u64(component.input_hash) || !decoder.u32(command_count)) {
+            return false;
+        }
+        component.component = static_cast<TaskbarComponent>(id);
+
+        DisplayListRecorder recorder(component.list);
+        for (uint32_t j = 0; j < command_count; ++j) {
+            if (!decodeCommand(decoder, recorder)) return false;
+        }
+        snapshot.components.push_back(std::move(component));
+    }
+    return decoder.atEnd();
+}
+
+} // namespace
+
+bool StartupSnapshot::write(const std::string& path, const StartupSnapshot& snapshot, std::string& error) {
+    Encoder encoder;
+    encoder.u8(static_cast<uint8_t>(snapshot.appearance.position));
+    encoder.u8(static_cast<uint8_t>(snapshot.appearance.style));
+    encoder.i32(snapshot.appearance.height);
+    encoder.boolean(snapshot.appearance.auto_hide);
+    encoder.boolean(snapshot.appearance.always_on_top);
+    encoder.boolean(snapshot.appearance.show_clock);
+    encoder.boolean(snapshot.appearance.show_system_tray);
+    encoder.boolean(snapshot.appearance.group_windows);
+    encoder.i32(snapshot.width);
+    encoder.i32(snapshot.height);
+    encoder.boolean(snapshot.clock_format.show_date);
+    encoder.boolean(snapshot.clock_format.show_seconds);
+    encoder.string(snapshot.clock_format.time_format);
+    encoder.string(snapshot.clock_format.date_format);
+
+    encoder.u32(static_cast<uint32_t>(snapshot.components.size()));
+    for (const auto& component : snapshot.components) {
+        encoder.u8(static_cast<uint8_t>(component.component));
+        encoder.u64(component.input_hash);
+        encoder.u32(static_cast<uint32_t>(component.list.size()));
+        for (const auto& command : component.list.commands()) {
+            if (!encodeCommand(encoder, component.list, command)) {
+                error = "快照包含不支持的显示列表命令";
+                return false;
+            }
+        }
+    }
+
+    // 文件头：魔数、版本和负载校验和
+    Encoder header;
+    for (char c : kMagic) {
+        header.u8(static_cast<uint8_t>(c));
+    }
+    header.u32(kVersion);
+    header.u64(checksum(encoder.data(), 0));
+
+    return ConfigPersister::writeFile(path, header.data() + encoder.data(), error);
+}
+
+bool StartupSnapshot::read(const std::string& path, StartupSnapshot& snapshot, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "无法打开快照文件: " + path;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() > kMaxSnapshotSize) {
+        error = "快照文件过大: " + path;
+        return false;
+    }
+
+    const size_t header_size = sizeof(kMagic) + 4 + 8;
+    Decoder header(data, sizeof(kMagic));
+    uint32_t version = 0;
+    uint64_t expected = 0;
+    if (data.size() < header_size || data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0 ||
+        !header.u32(version) || version != kVersion) {
+        error = "快照文件格式或版本不符: " + path;
+        return false;
+    }
+    header.u64(expected);
+    if (checksum(data, header_size) != expected) {
+        error = "快照文件校验失败: " + path;
+        return false;
+    }
+
+    StartupSnapshot staged;
+    if (!decode(data, staged)) {
+        error = "快照文件内容无效: " + path;
+        return false;
+    }
+    snapshot = std::move(staged);
+    return true;
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,73 @@
+/**
+ * @file startup_snapshot.h
+ * @brief 任务栏启动快照头文件
+ *
+ * 保存上一次会话最后布局好的任务栏（背景、开始按钮、快速启动项和托盘项的显示列表，
+ * 连同外观、尺寸和时钟格式），登录时在启动辅助进程、状态轮询和加载配置之前
+ * 直接回放，使面板在第一帧就显示完整；实时数据就绪后按组件输入哈希对账，
+ * 没有变化的组件沿用快照中的显示列表
+ */
+
+#ifndef CLOUDFLOW_STARTUP_SNAPSHOT_H
+#define CLOUDFLOW_STARTUP_SNAPSHOT_H
+
+#include "taskbar.h"
+#include "display_list.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct StartupSnapshot
+ * @brief 任务栏启动快照
+ *
+ * 窗口列表不进入快照：上一次会话的窗口在登录时已不存在
+ */
+struct StartupSnapshot {
+    /**
+     * @brief 单个组件的显示列表
+     */
+    struct Component {
+        TaskbarComponent component;   ///< 组件
+        uint64_t input_hash;          ///< 录制时的组件输入哈希
+        DisplayList list;             ///< 显示列表（托盘项和快速启动项含图标路径）
+
+        Component() : component(TaskbarComponent::Background), input_hash(0) {}
+    };
+
+    TaskbarAppearance appearance;     ///< 录制时的外观
+    int width;                        ///< 录制时的任务栏宽度
+    int height;                       ///< 录制时的任务栏高度
+    ClockFormat clock_format;         ///< 时钟格式
+    std::vector<Component> components; ///< 按渲染顺序排列的组件
+
+    StartupSnapshot() : width(0), height(0) {}
+
+    /**
+     * @brief 写入快照文件（紧凑二进制格式，原子替换）
+     * @param path 快照文件路径
+     * @param snapshot 快照
+     * @param error 失败时的错误描述
+     * @return 写入是否成功
+     */
+    static bool write(const std::string& path, const StartupSnapshot& snapshot, std::string& error);
+
+    /**
+     * @brief 读取并校验快照文件
+     *
+     * 版本不符、校验和不符或内容截断时整体失败，snapshot保持不变
+     * @param path 快照文件路径
+     * @param snapshot 读取结果
+     * @param error 失败时的错误描述
+     * @return 读取是否成功
+     */
+    static bool read(const std::string& path, StartupSnapshot& snapshot, std::string& error);
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_STARTUP_SNAPSHOT_H
@@ -0,0 +1,625 @@
+/**
+ * @file system_status.cpp
+ * @brief 系统状态提供者实现文件
+ */
+
+#include "system_status.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+/**
+ * @brief 从文件开头读取内容（保持文件描述符打开，避免每次轮询重复open）
+ * @return 读取的字节数，失败返回0
+ */
+size_t readAt(int fd, char* buffer, size_t size) {
+    if (fd < 0) return 0;
+    ssize_t length = pread(fd, buffer, size - 1, 0);
+    if (length <= 0) return 0;
+    buffer[length] = '\0';
+    return static_cast<size_t>(length);
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+const char* nextLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    return (p < end) ? p + 1 : end;
+}
+
+uint64_t parseUint(const char*& p, const char* end) {
+    uint64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+void formatRate(char* out, size_t size, double bytes_per_second) {
+    if (bytes_per_second < 1024) {
+        std::snprintf(out, size, "%.0f B/s", bytes_per_second);
+    } else if (bytes_per_second < 1024 * 1024) {
+        std::snprintf(out, size, "%.1f KB/s", bytes_per_second / 1024);
+    } else {
+        std::snprintf(out, size, "%.1f MB/s", bytes_per_second / (1024 * 1024));
+    }
+}
+
+int openReadOnly(const std::string& path) {
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+void closeFd(int fd) {
+    if (fd >= 0) close(fd);
+}
+
+uint64_t threadCpuNanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+} // namespace
+
+// NetworkStatusProvider 实现
+NetworkStatusProvider::NetworkStatusProvider(const SystemTrayItem& item, TrayItemSink sink,
+                                             std::shared_ptr<SparklineHistory> history)
+    : item_(item),
+      sink_(std::move(sink)),
+      history_(std::move(history)),
+      dev_fd_(openReadOnly("/proc/net/dev")),
+      route_fd_(openReadOnly("/proc/net/route")),
+      last_rx_bytes_(0),
+      last_tx_bytes_(0),
+      has_sample_(false) {
+    last_text_[0] = '\0';
+}
+
+NetworkStatusProvider::~NetworkStatusProvider() {
+    closeFd(dev_fd_);
+    closeFd(route_fd_);
+}
+
+void NetworkStatusProvider::poll(std::chrono::steady_clock::time_point now) {
+    // 汇总除回环接口外的收发字节数：iface: rx_bytes ... (第9列为tx_bytes)
+    uint64_t rx_bytes = 0;
+    uint64_t tx_bytes = 0;
+    size_t length = readAt(dev_fd_, buffer_, sizeof(buffer_));
+    const char* end = buffer_ + length;
+    const char* line = nextLine(nextLine(buffer_, end), end);
+    for (; line < end; line = nextLine(line, end)) {
+        const char* p = skipSpaces(line, end);
+        const char* name = p;
+        while (p < end && *p != ':' && *p != '\n') ++p;
+        if (p >= end || *p != ':') continue;
+        bool loopback = (p - name == 2 && name[0] == 'l' && name[1] == 'o');
+        ++p;
+
+        uint64_t fields[9];
+        for (uint64_t& field : fields) {
+            p = skipSpaces(p, end);
+            field = parseUint(p, end);
+        }
+        if (!loopback) {
+            rx_bytes += fields[0];
+            tx_bytes += fields[8];
+        }
+    }
+
+    // 存在默认路由（目标为00000000）视为已连接
+    bool connected = false;
+    length = readAt(route_fd_, buffer_, sizeof(buffer_));
+    end = buffer_ + length;
+    for (line = nextLine(buffer_, end); line < end && !connected; line = nextLine(line, end)) {
+        const char* p = line;
+        while (p < end && *p != '\t' && *p != ' ' && *p != '\n') ++p;
+        p = skipSpaces(p, end);
+        connected = (end - p >= 8 && std::memcmp(p, "00000000", 8) == 0);
+    }
+
+    double seconds = std::chrono::duration<double>(now - last_poll_).count();
+    double rx_rate = 0;
+    double tx_rate = 0;
+    if (has_sample_ && seconds > 0 && rx_bytes >= last_rx_bytes_ && tx_bytes >= last_tx_bytes_) {
+        rx_rate = (rx_bytes - last_rx_bytes_) / seconds;
+        tx_rate = (tx_bytes - last_tx_bytes_) / seconds;
+    }
+    last_rx_bytes_ = rx_bytes;
+    last_tx_bytes_ = tx_bytes;
+    last_poll_ = now;
+    has_sample_ = true;
+    if (history_) {
+        history_->add(static_cast<float>(rx_rate + tx_rate));
+    }
+
+    char rx_text[32];
+    char tx_text[32];
+    char text[sizeof(last_text_)];
+    formatRate(rx_text, sizeof(rx_text), rx_rate);
+    formatRate(tx_text, sizeof(tx_text), tx_rate);
+    std::snprintf(text, sizeof(text), "%s  ↓ %s  ↑ %s", connected ? "已连接" : "未连接", rx_text, tx_text);
+
+    // 只有显示文本变化时才构造托盘项并推送
+    if (std::strcmp(text, last_text_) == 0) return;
+    std::memcpy(last_text_, text, sizeof(text));
+    item_.tooltip = text;
+    item_.active = connected;
+    sink_(item_);
+}
+
+// CpuStatusProvider 实现
+CpuStatusProvider::CpuStatusProvider(const SystemTrayItem& item, TrayItemSink sink,
+                                     std::shared_ptr<SparklineHistory> history)
+    : item_(item),
+      sink_(std::move(sink)),
+      history_(std::move(history)),
+      stat_fd_(openReadOnly("/proc/stat")),
+      last_busy_(0),
+      last_total_(0),
+      last_percent_(-1) {}
+
+CpuStatusProvider::~CpuStatusProvider() {
+    closeFd(stat_fd_);
+}
+
+void CpuStatusProvider::poll(std::chrono::steady_clock::time_point) {
+    // 第一行汇总所有CPU：cpu user nice system idle iowait irq softirq steal ...
+    size_t length = readAt(stat_fd_, buffer_, sizeof(buffer_));
+    if (length < 4 || std::strncmp(buffer_, "cpu ", 4) != 0) return;
+
+    const char* p = buffer_ + 4;
+    const char* end = buffer_ + length;
+    uint64_t fields[8];
+    uint64_t total = 0;
+    for (uint64_t& field : fields) {
+        p = skipSpaces(p, end);
+        field = parseUint(p, end);
+        total += field;
+    }
+    uint64_t busy = total - fields[3] - fields[4];
+
+    // 首次采样只记录基准
+    if (last_total_ == 0 || total <= last_total_ || busy < last_busy_) {
+        last_busy_ = busy;
+        last_total_ = total;
+        return;
+    }
+    double usage = 100.0 * static_cast<double>(busy - last_busy_) / static_cast<double>(total - last_total_);
+    last_busy_ = busy;
+    last_total_ = total;
+    if (history_) {
+        history_->add(static_cast<float>(usage));
+    }
+
+    int percent = static_cast<int>(usage + 0.5);
+    if (percent == last_percent_) return;
+    last_percent_ = percent;
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "CPU %d%%", percent);
+    item_.tooltip = text;
+    item_.active = percent >= 80;
+    sink_(item_);
+}
+
+// BatteryStatusProvider 实现
+BatteryStatusProvider::BatteryStatusProvider(const SystemTrayItem& item, TrayItemSink sink)
+    : item_(item),
+      sink_(std::move(sink)),
+      capacity_fd_(-1),
+      status_fd_(-1),
+      last_capacity_(-1),
+      last_charging_(-1),
+      published_(false) {
+    const std::string root = "/sys/class/power_supply/";
+    DIR* dir = opendir(root.c_str());
+    if (!dir) return;
+
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+
+        std::string device = root + entry->d_name + "/";
+        char type[32];
+        int type_fd = openReadOnly(device + "type");
+        bool is_battery = readAt(type_fd, type, sizeof(type)) > 0 && std::strncmp(type, "Battery", 7) == 0;
+        closeFd(type_fd);
+        if (!is_battery) continue;
+
+        capacity_fd_ = openReadOnly(device + "capacity");
+        status_fd_ = openReadOnly(device + "status");
+        break;
+    }
+    closedir(dir);
+}
+
+BatteryStatusProvider::~BatteryStatusProvider() {
+    closeFd(capacity_fd_);
+    closeFd(status_fd_);
+}
+
+void BatteryStatusProvider::poll(std::chrono::steady_clock::time_point) {
+    if (capacity_fd_ < 0) {
+        // 没有电池的设备隐藏电池托盘项
+        if (!published_) {
+            published_ = true;
+            item_.visible = false;
+            sink_(item_);
+        }
+        return;
+    }
+
+    char buffer[32];
+    size_t length = readAt(capacity_fd_, buffer, sizeof(buffer));
+    const char* p = buffer;
+    int capacity = static_cast<int>(parseUint(p, buffer + length));
+
+    length = readAt(status_fd_, buffer, sizeof(buffer));
+    int charging = (length >= 8 && std::strncmp(buffer, "Charging", 8) == 0) ? 1 :
+                   (length >= 4 && std::strncmp(buffer, "Full", 4) == 0) ? 2 : 0;
+
+    if (published_ && capacity == last_capacity_ && charging == last_charging_) return;
+    published_ = true;
+    last_capacity_ = capacity;
+    last_charging_ = charging;
+
+    static const char* const kStates[] = {"", "（充电中）", "（已充满）"};
+    char text[64];
+    std::snprintf(text, sizeof(text), "电量 %d%%%s", capacity, kStates[charging]);
+    item_.tooltip = text;
+    item_.active = (charging != 0);
+    sink_(item_);
+}
+
+// VolumeStatusProvider 实现
+VolumeStatusProvider::VolumeStatusProvider(const SystemTrayItem& item, TrayItemSink sink)
+    : item_(item),
+      sink_(std::move(sink)),
+      cards_fd_(openReadOnly("/proc/asound/cards")),
+      volume_(-1),
+      muted_(false),
+      last_state_(-2) {}
+
+VolumeStatusProvider::~VolumeStatusProvider() {
+    closeFd(cards_fd_);
+}
+
+void VolumeStatusProvider::setVolume(int percent, bool muted) {
+    volume_ = std::max(0, std::min(100, percent));
+    muted_ = muted;
+}
+
+void VolumeStatusProvider::poll(std::chrono::steady_clock::time_point) {
+    size_t length = readAt(cards_fd_, buffer_, sizeof(buffer_));
+    bool present = length > 0 && std::strncmp(buffer_, "--- no soundcards ---", 21) != 0;
+
+    int volume = volume_;
+    bool muted = muted_;
+    int state = !present ? -1 : (volume + 1) * 2 + (muted ? 1 : 0);
+    if (state == last_state_) return;
+    last_state_ = state;
+
+    char text[64];
+    if (!present) {
+        std::snprintf(text, sizeof(text), "无音频设备");
+    } else if (muted) {
+        std::snprintf(text, sizeof(text), "已静音");
+    } else if (volume < 0) {
+        std::snprintf(text, sizeof(text), "音量控制");
+    } else {
+        std::snprintf(text, sizeof(text), "音量 %d%%", volume);
+    }
+    item_.tooltip = text;
+    item_.active = present && !muted;
+    sink_(item_);
+}
+
+// ProcessUsageProvider 实现
+ProcessUsageProvider::ProcessUsageProvider(ProcessUsageSink sink, const ProcessUsageThresholds& thresholds)
+    : sink_(std::move(sink)),
+      thresholds_(thresholds),
+      clock_ticks_(static_cast<double>(std::max(1L, sysconf(_SC_CLK_TCK)))),
+      page_size_(static_cast<uint64_t>(std::max(1L, sysconf(_SC_PAGESIZE)))),
+      has_pending_(false) {}
+
+ProcessUsageProvider::~ProcessUsageProvider() {
+    for (const auto& sample : processes_) {
+        closeFd(sample.stat_fd);
+        closeFd(sample.statm_fd);
+    }
+}
+
+void ProcessUsageProvider::trackWindow(const std::string& window_id, int pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.emplace_back(window_id, std::max(0, pid));
+    has_pending_ = true;
+}
+
+void ProcessUsageProvider::untrackWindow(const std::string& window_id) {
+    trackWindow(window_id, 0);
+}
+
+ProcessUsage ProcessUsageProvider::getUsage(const std::string& window_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& window : windows_) {
+        if (window.window_id == window_id) {
+            return processes_[window.process].usage;
+        }
+    }
+    return ProcessUsage();
+}
+
+void ProcessUsageProvider::applyPendingChanges() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& change : pending_) {
+        auto window = std::find_if(windows_.begin(), windows_.end(),
+                                   [&change](const TrackedWindow& tracked) { return tracked.window_id == change.first; });
+        if (window != windows_.end()) {
+            if (change.second != 0 && processes_[window->process].pid == change.second) continue;
+            if (window->published_alert != 0) {
+                cleared_windows_.push_back(window->window_id);
+            }
+            windows_.erase(window);
+        }
+        if (change.second == 0) continue;
+
+        auto process = std::find_if(processes_.begin(), processes_.end(),
+                                    [&change](const ProcessSample& sample) { return sample.pid == change.second; });
+        if (process == processes_.end()) {
+            std::string root = "/proc/" + std::to_string(change.second) + "/";
+            ProcessSample sample;
+            sample.pid = change.second;
+            sample.stat_fd = openReadOnly(root + "stat");
+            sample.statm_fd = openReadOnly(root + "statm");
+            sample.last_cpu_ticks = 0;
+            sample.has_sample = false;
+            sample.usage.pid = change.second;
+            process = processes_.insert(processes_.end(), sample);
+        }
+        windows_.push_back(TrackedWindow{change.first, static_cast<size_t>(process - processes_.begin()), 0});
+    }
+    pending_.clear();
+    has_pending_ = false;
+
+    // 关闭不再被任何窗口引用的进程，并重建窗口到进程的下标
+    std::vector<ProcessSample> processes;
+    processes.reserve(processes_.size());
+    for (auto& sample : processes_) {
+        bool referenced = std::any_of(windows_.begin(), windows_.end(), [&](const TrackedWindow& window) {
+            return processes_[window.process].pid == sample.pid;
+        });
+        if (referenced) {
+            processes.push_back(sample);
+        } else {
+            closeFd(sample.stat_fd);
+            closeFd(sample.statm_fd);
+        }
+    }
+    for (auto& window : windows_) {
+        int pid = processes_[window.process].pid;
+        window.process = static_cast<size_t>(std::find_if(processes.begin(), processes.end(),
+            [pid](const ProcessSample& sample) { return sample.pid == pid; }) - processes.begin());
+    }
+    processes_.swap(processes);
+}
+
+void ProcessUsageProvider::sampleProcess(ProcessSample& sample, double elapsed_seconds) {
+    // stat: pid (comm) state ...，comm可能包含空格和括号，从最后一个')'之后开始解析，
+    // 其后第12和第13个字段为utime和stime
+    size_t length = readAt(sample.stat_fd, buffer_, sizeof(buffer_));
+    const char* end = buffer_ + length;
+    const char* p = end;
+    while (p > buffer_ && *(p - 1) != ')') --p;
+    if (length == 0 || p == buffer_) {
+        // 进程已退出（保持打开的描述符在pid被复用后也不会读到新进程）
+        closeFd(sample.stat_fd);
+        closeFd(sample.statm_fd);
+        sample.stat_fd = -1;
+        sample.statm_fd = -1;
+        sample.has_sample = false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        sample.usage.cpu_percent = 0;
+        sample.usage.rss_bytes = 0;
+        sample.usage.alert = 0;
+        return;
+    }
+
+    uint64_t fields[13] = {};
+    for (uint64_t& field : fields) {
+        p = skipSpaces(p, end);
+        const char* start = p;
+        field = parseUint(p, end);
+        if (p == start) {
+            while (p < end && *p != ' ' && *p != '\n') ++p;
+        }
+    }
+    uint64_t cpu_ticks = fields[11] + fields[12];
+
+    length = readAt(sample.statm_fd, buffer_, sizeof(buffer_));
+    p = buffer_;
+    end = buffer_ + length;
+    parseUint(p, end);
+    p = skipSpaces(p, end);
+    uint64_t rss_bytes = parseUint(p, end) * page_size_;
+
+    double cpu_percent = 0;
+    if (sample.has_sample && elapsed_seconds > 0 && cpu_ticks >= sample.last_cpu_ticks) {
+        cpu_percent = (cpu_ticks - sample.last_cpu_ticks) / clock_ticks_ / elapsed_seconds * 100.0;
+    }
+
+    uint8_t alert = sample.usage.alert;
+    if (sample.has_sample) {
+        if (cpu_percent >= thresholds_.cpu_high_percent) {
+            alert |= WindowOverlay::HighCpu;
+        } else if (cpu_percent < thresholds_.cpu_clear_percent) {
+            alert &= static_cast<uint8_t>(~WindowOverlay::HighCpu);
+        }
+    }
+    if (rss_bytes >= thresholds_.memory_high_bytes) {
+        alert |= WindowOverlay::HighMemory;
+    } else if (rss_bytes < thresholds_.memory_clear_bytes) {
+        alert &= static_cast<uint8_t>(~WindowOverlay::HighMemory);
+    }
+    sample.last_cpu_ticks = cpu_ticks;
+    sample.has_sample = true;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    sample.usage.cpu_percent = cpu_percent;
+    sample.usage.rss_bytes = rss_bytes;
+    sample.usage.alert = alert;
+}
+
+void ProcessUsageProvider::poll(std::chrono::steady_clock::time_point now) {
+    if (has_pending_) {
+        applyPendingChanges();
+
+        // 已推送告警的窗口停止跟踪或换了进程时推送解除，避免叠加层残留旧告警
+        for (const auto& window_id : cleared_windows_) {
+            sink_(window_id, ProcessUsage());
+        }
+        cleared_windows_.clear();
+    }
+
+    double elapsed_seconds = std::chrono::duration<double>(now - last_poll_).count();
+    last_poll_ = now;
+    for (auto& sample : processes_) {
+        if (sample.stat_fd >= 0) {
+            sampleProcess(sample, elapsed_seconds);
+        }
+    }
+
+    // 只推送告警状态发生变化的窗口
+    for (auto& window : windows_) {
+        const ProcessUsage& usage = processes_[window.process].usage;
+        if (usage.alert == window.published_alert) continue;
+        window.published_alert = usage.alert;
+        sink_(window.window_id, usage);
+    }
+}
+
+// SystemStatusMonitor 实现类
+class SystemStatusMonitor::Impl {
+public:
+    explicit Impl(std::chrono::milliseconds interval)
+        : interval_(interval),
+          running_(false),
+          tick_count_(0),
+          total_cpu_ns_(0),
+          max_tick_cpu_ns_(0) {}
+
+    ~Impl() {
+        stop();
+    }
+
+    void addProvider(std::shared_ptr<IStatusProvider> provider) {
+        providers_.push_back(std::move(provider));
+    }
+
+    bool start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) return true;
+
+        running_ = true;
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    SystemStatusStats getStats() const {
+        SystemStatusStats stats;
+        stats.tick_count = tick_count_.load(std::memory_order_relaxed);
+        stats.total_cpu_ns = total_cpu_ns_.load(std::memory_order_relaxed);
+        stats.max_tick_cpu_ns = max_tick_cpu_ns_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    void run() {
+        auto next_tick = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            lock.unlock();
+
+            // 所有提供者共享同一次定时唤醒，并统计本次轮询消耗的CPU时间
+            uint64_t cpu_start = threadCpuNanoseconds();
+            auto now = std::chrono::steady_clock::now();
+            for (const auto& provider : providers_) {
+                provider->poll(now);
+            }
+            uint64_t cpu_used = threadCpuNanoseconds() - cpu_start;
+
+            tick_count_.fetch_add(1, std::memory_order_relaxed);
+            total_cpu_ns_.fetch_add(cpu_used, std::memory_order_relaxed);
+            if (cpu_used > max_tick_cpu_ns_.load(std::memory_order_relaxed)) {
+                max_tick_cpu_ns_.store(cpu_used, std::memory_order_relaxed);
+            }
+
+            next_tick += interval_;
+            lock.lock();
+            cv_.wait_until(lock, next_tick, [this]() { return !running_; });
+        }
+    }
+
+    const std::chrono::milliseconds interval_;
+    std::vector<std::shared_ptr<IStatusProvider>> providers_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool running_;
+
+    std::atomic<uint64_t> tick_count_;
+    std::atomic<uint64_t> total_cpu_ns_;
+    std::atomic<uint64_t> max_tick_cpu_ns_;
+};
+
+// SystemStatusMonitor 实现
+SystemStatusMonitor::SystemStatusMonitor(std::chrono::milliseconds interval)
+    : impl_(std::make_unique<Impl>(interval)) {}
+
+SystemStatusMonitor::~SystemStatusMonitor() = default;
+
+void SystemStatusMonitor::addProvider(std::shared_ptr<IStatusProvider> provider) {
+    impl_->addProvider(std::move(provider));
+}
+
+bool SystemStatusMonitor::start() {
+    return impl_->start();
+}
+
+void SystemStatusMonitor::stop() {
+    impl_->stop();
+}
+
+SystemStatusStats SystemStatusMonitor::getStats() const {
+    return impl_->getStats();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
@@ -0,0 +1,343 @@
+/**
+ * @file system_status.h
+ * @brief 系统状态提供者头文件
+ *
+ * 为网络、音量和电池等托盘项提供实时状态，并采样窗口所属进程的资源占用。
+ * 所有提供者在同一个定时线程中轮询，对/proc和/sys下的数据源保持打开的文件描述符
+ * 并用pread读取，使用不分配内存的解析器，只在状态变化时推送更新
+ */
+
+#ifndef CLOUDFLOW_SYSTEM_STATUS_H
+#define CLOUDFLOW_SYSTEM_STATUS_H
+
+#include "taskbar.h"
+#include "sparkline.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @brief 托盘项状态推送函数
+ */
+using TrayItemSink = std::function<void(const SystemTrayItem& item)>;
+
+/**
+ * @class IStatusProvider
+ * @brief 系统状态提供者接口
+ */
+class IStatusProvider {
+public:
+    virtual ~IStatusProvider() = default;
+
+    /**
+     * @brief 轮询数据源（在状态监视线程中调用）
+     * @param now 本次轮询时间
+     */
+    virtual void poll(std::chrono::steady_clock::time_point now) = 0;
+};
+
+/**
+ * @class NetworkStatusProvider
+ * @brief 网络状态提供者（/proc/net/dev与/proc/net/route）
+ */
+class NetworkStatusProvider : public IStatusProvider {
+public:
+    /**
+     * @brief 构造函数
+     * @param item 托盘项模板（ID、名称和图标）
+     * @param sink 状态推送函数
+     * @param history 收发速率（字节/秒）历史，为空时不记录
+     */
+    NetworkStatusProvider(const SystemTrayItem& item, TrayItemSink sink,
+                          std::shared_ptr<SparklineHistory> history = nullptr);
+    ~NetworkStatusProvider() override;
+
+    void poll(std::chrono::steady_clock::time_point now) override;
+
+private:
+    SystemTrayItem item_;
+    TrayItemSink sink_;
+    std::shared_ptr<SparklineHistory> history_;
+    int dev_fd_;
+    int route_fd_;
+    uint64_t last_rx_bytes_;
+    uint64_t last_tx_bytes_;
+    std::chrono::steady_clock::time_point last_poll_;
+    bool has_sample_;
+    char buffer_[16384];
+    char last_text_[96];
+};
+
+/**
+ * @class CpuStatusProvider
+ * @brief CPU占用状态提供者（/proc/stat）
+ */
+class CpuStatusProvider : public IStatusProvider {
+public:
+    /**
+     * @brief 构造函数
+     * @param item 托盘项模板（ID、名称和图标）
+     * @param sink 状态推送函数
+     * @param history CPU占用（百分比）历史，为空时不记录
+     */
+    CpuStatusProvider(const SystemTrayItem& item, TrayItemSink sink,
+                      std::shared_ptr<SparklineHistory> history = nullptr);
+    ~CpuStatusProvider() override;
+
+    void poll(std::chrono::steady_clock::time_point now) override;
+
+private:
+    SystemTrayItem item_;
+    TrayItemSink sink_;
+    std::shared_ptr<SparklineHistory> history_;
+    int stat_fd_;
+    uint64_t last_busy_;
+    uint64_t last_total_;
+    int last_percent_;
+    char buffer_[512];
+};
+
+/**
+ * @class BatteryStatusProvider
+ * @brief 电池状态提供者（/sys/class/power_supply）
+ */
+class BatteryStatusProvider : public IStatusProvider {
+public:
+    /**
+     * @brief 构造函数，查找第一个电池设备
+     * @param item 托盘项模板（ID、名称和图标）
+     * @param sink 状态推送函数
+     */
+    BatteryStatusProvider(const SystemTrayItem& item, TrayItemSink sink);
+    ~BatteryStatusProvider() override;
+
+    void poll(std::chrono::steady_clock::time_point now) override;
+
+private:
+    SystemTrayItem item_;
+    TrayItemSink sink_;
+    int capacity_fd_;
+    int status_fd_;
+    int last_capacity_;
+    int last_charging_;
+    bool published_;
+};
+
+/**
+ * @class VolumeStatusProvider
+ * @brief 音量状态提供者
+ *
+ * 声卡是否存在由/proc/asound/cards判断；混音器音量没有文件数据源，
+ * 由音频服务通过setVolume()推送，在下一次轮询时发布
+ */
+class VolumeStatusProvider : public IStatusProvider {
+public:
+    /**
+     * @brief 构造函数
+     * @param item 托盘项模板（ID、名称和图标）
+     * @param sink 状态推送函数
+     */
+    VolumeStatusProvider(const SystemTrayItem& item, TrayItemSink sink);
+    ~VolumeStatusProvider() override;
+
+    /**
+     * @brief 设置音量（可在任意线程调用）
+     * @param percent 音量百分比（0-100）
+     * @param muted 是否静音
+     */
+    void setVolume(int percent, bool muted);
+
+    void poll(std::chrono::steady_clock::time_point now) override;
+
+private:
+    SystemTrayItem item_;
+    TrayItemSink sink_;
+    int cards_fd_;
+    std::atomic<int> volume_;
+    std::atomic<bool> muted_;
+    int last_state_;
+    char buffer_[256];
+};
+
+/**
+ * @struct ProcessUsageThresholds
+ * @brief 进程资源占用告警阈值（告警与解除使用不同阈值，避免在边界附近反复切换）
+ */
+struct ProcessUsageThresholds {
+    double cpu_high_percent;      ///< CPU占用（单核百分比）达到该值时告警
+    double cpu_clear_percent;     ///< CPU占用低于该值时解除告警
+    uint64_t memory_high_bytes;   ///< 常驻内存达到该值时告警
+    uint64_t memory_clear_bytes;  ///< 常驻内存低于该值时解除告警
+
+    ProcessUsageThresholds() : cpu_high_percent(80.0), cpu_clear_percent(50.0),
+                               memory_high_bytes(2ULL << 30), memory_clear_bytes(3ULL << 29) {}
+};
+
+/**
+ * @struct ProcessUsage
+ * @brief 进程资源占用采样结果
+ */
+struct ProcessUsage {
+    int pid;                      ///< 进程ID
+    double cpu_percent;           ///< 两次采样之间的CPU占用（单核百分比）
+    uint64_t rss_bytes;           ///< 常驻内存
+    uint8_t alert;                ///< 告警（WindowOverlay::UsageAlert位组合）
+
+    ProcessUsage() : pid(0), cpu_percent(0), rss_bytes(0), alert(0) {}
+};
+
+/**
+ * @brief 窗口进程告警变化推送函数
+ */
+using ProcessUsageSink = std::function<void(const std::string& window_id, const ProcessUsage& usage)>;
+
+/**
+ * @class ProcessUsageProvider
+ * @brief 窗口进程资源占用提供者（/proc/<pid>/stat与/proc/<pid>/statm）
+ *
+ * 每次轮询对所有跟踪的进程各读取一次（多个窗口属于同一进程时共享采样），
+ * 稳态下不分配内存；只在窗口的告警状态跨越阈值时推送
+ */
+class ProcessUsageProvider : public IStatusProvider {
+public:
+    /**
+     * @brief 构造函数
+     * @param sink 告警变化推送函数（在状态监视线程中调用）
+     * @param thresholds 告警阈值
+     */
+    explicit ProcessUsageProvider(ProcessUsageSink sink,
+                                  const ProcessUsageThresholds& thresholds = ProcessUsageThresholds());
+    ~ProcessUsageProvider() override;
+
+    /**
+     * @brief 跟踪窗口所属进程（可在任意线程调用，下一次轮询时生效）
+     * @param window_id 窗口ID
+     * @param pid 进程ID，小于等于0时停止跟踪该窗口
+     */
+    void trackWindow(const std::string& window_id, int pid);
+
+    /**
+     * @brief 停止跟踪窗口（可在任意线程调用）
+     * @param window_id 窗口ID
+     */
+    void untrackWindow(const std::string& window_id);
+
+    /**
+     * @brief 获取窗口进程最近一次的采样结果（可在任意线程调用）
+     * @param window_id 窗口ID
+     * @return 采样结果，未跟踪时pid为0
+     */
+    ProcessUsage getUsage(const std::string& window_id) const;
+
+    void poll(std::chrono::steady_clock::time_point now) override;
+
+private:
+    struct ProcessSample {
+        int pid;
+        int stat_fd;
+        int statm_fd;
+        uint64_t last_cpu_ticks;
+        bool has_sample;
+        ProcessUsage usage;
+    };
+
+    struct TrackedWindow {
+        std::string window_id;
+        size_t process;           ///< processes_中的下标
+        uint8_t published_alert;
+    };
+
+    void applyPendingChanges();
+    void sampleProcess(ProcessSample& sample, double elapsed_seconds);
+
+    ProcessUsageSink sink_;
+    const ProcessUsageThresholds thresholds_;
+    const double clock_ticks_;
+    const uint64_t page_size_;
+
+    // 跟踪请求在轮询线程中统一应用，pid为0表示停止跟踪
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, int>> pending_;
+    std::atomic<bool> has_pending_;
+
+    // 以下只在轮询线程中修改，修改时持有mutex_以供getUsage查询
+    std::vector<ProcessSample> processes_;
+    std::vector<TrackedWindow> windows_;
+    std::vector<std::string> cleared_windows_;  ///< 停止跟踪或换了进程、需要推送解除告警的窗口
+    std::chrono::steady_clock::time_point last_poll_;
+    char buffer_[1024];
+};
+
+/**
+ * @struct SystemStatusStats
+ * @brief 状态监视线程的CPU开销统计
+ */
+struct SystemStatusStats {
+    uint64_t tick_count;          ///< 轮询次数
+    uint64_t total_cpu_ns;        ///< 累计CPU时间（纳秒）
+    uint64_t max_tick_cpu_ns;     ///< 单次轮询最大CPU时间（纳秒）
+
+    SystemStatusStats() : tick_count(0), total_cpu_ns(0), max_tick_cpu_ns(0) {}
+};
+
+/**
+ * @class SystemStatusMonitor
+ * @brief 系统状态监视器，以共享定时器驱动所有提供者
+ */
+class SystemStatusMonitor {
+public:
+    /**
+     * @brief 构造函数
+     * @param interval 轮询间隔
+     */
+    explicit SystemStatusMonitor(std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief 析构函数，停止轮询线程
+     */
+    ~SystemStatusMonitor();
+
+    // 禁用拷贝和赋值
+    SystemStatusMonitor(const SystemStatusMonitor&) = delete;
+    SystemStatusMonitor& operator=(const SystemStatusMonitor&) = delete;
+
+    /**
+     * @brief 添加状态提供者（应在start之前调用）
+     * @param provider 状态提供者
+     */
+    void addProvider(std::shared_ptr<IStatusProvider> provider);
+
+    /**
+     * @brief 启动轮询线程
+     * @return 启动是否成功
+     */
+    bool start();
+
+    /**
+     * @brief 停止轮询线程
+     */
+    void stop();
+
+    /**
+     * @brief 获取CPU开销统计
+     * @return 统计信息
+     */
+    SystemStatusStats getStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_SYSTEM_STATUS_H
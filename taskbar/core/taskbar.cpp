@@ -4,25 +4,296 @@
  */
 
 #include "taskbar.h"
+#include "auto_hide.h"
+#include "display_list.h"
+#include "metrics.h"
+#include "clock_text.h"
+#include "config_persister.h"
+#include "startup_snapshot.h"
+#include "system_status.h"
+#include "sparkline.h"
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <atomic>
+#include <cstring>
 #include <iomanip>
 #include <ctime>
-#include <json/json.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace CloudFlow {
 namespace Desktop {
 
+// 开始菜单搜索结果的最大数量
+constexpr size_t kStartMenuResultLimit = 50;
+
+// 通知中心托盘项ID
+constexpr char kNotificationTrayId[] = "notifications";
+
+// 系统托盘布局（简化实现：托盘位于窗口列表保留区内、时钟左侧，每项等宽）
+constexpr int kTrayRightReserve = 50;
+constexpr int kTrayItemWidth = 30;
+
+// 窗口列表布局（简化实现：列表从快速启动栏右侧开始，右侧为托盘和时钟保留空间，每项等宽）
+constexpr int kWindowListLeft = 210;
+constexpr int kWindowListRightReserve = 200;
+constexpr int kWindowListItemWidth = 200;
+
+/**
+ * @class MeteredRenderer
+ * @brief 统计渲染器调用次数的包装渲染器，按方法名记入taskbar_renderer_calls_total
+ */
+class MeteredRenderer : public ITaskbarRenderer {
+public:
+    explicit MeteredRenderer(std::shared_ptr<ITaskbarRenderer> renderer) : renderer_(std::move(renderer)) {
+        static const char* const kMethods[MethodCount] = {
+            "renderBackground", "renderStartMenuButton", "renderQuickLaunchItem",
+            "renderWindowListItem", "renderSystemTrayItem", "renderWindowGroupItem",
+            "renderWindowPreview", "hideWindowPreview", "renderStartMenu", "hideStartMenu",
+            "renderClock", "renderClockText", "setTaskbarOffset", "getTaskbarSize",
+            "renderDisplayList", "showJumpList", "renderNotifications", "hideNotifications",
+            "renderWindowListOverflow", "renderWindowOverlay", "renderTrayTooltip", "hideTrayTooltip",
+            "renderCalendar", "hideCalendar", "renderKeyboardFocus"
+        };
+        auto& metrics = Common::MetricsRegistry::global();
+        for (int i = 0; i < MethodCount; ++i) {
+            calls_[i] = metrics.counter("taskbar_renderer_calls_total", "任务栏渲染器调用次数",
+                                        {{"method", kMethods[i]}});
+        }
+    }
+    
+    void renderBackground(const TaskbarAppearance& appearance) override {
+        calls_[RenderBackground]->increment();
+        renderer_->renderBackground(appearance);
+    }
+    
+    void renderStartMenuButton(const TaskbarAppearance& appearance, bool is_active) override {
+        calls_[RenderStartMenuButton]->increment();
+        renderer_->renderStartMenuButton(appearance, is_active);
+    }
+    
+    void renderQuickLaunchItem(const QuickLaunchItem& item, const TaskbarAppearance& appearance) override {
+        calls_[RenderQuickLaunchItem]->increment();
+        renderer_->renderQuickLaunchItem(item, appearance);
+    }
+    
+    void renderWindowListItem(const std::string& window_id, const std::string& window_title,
+                              bool is_active, bool is_minimized, const TaskbarAppearance& appearance) override {
+        calls_[RenderWindowListItem]->increment();
+        renderer_->renderWindowListItem(window_id, window_title, is_active, is_minimized, appearance);
+    }
+    
+    void renderSystemTrayItem(const SystemTrayItem& item, const TaskbarAppearance& appearance) override {
+        calls_[RenderSystemTrayItem]->increment();
+        renderer_->renderSystemTrayItem(item, appearance);
+    }
+    
+    void renderWindowGroupItem(const WindowGroup& group, const std::string& window_title,
+                               bool is_active, bool is_minimized, const TaskbarAppearance& appearance) override {
+        calls_[RenderWindowGroupItem]->increment();
+        renderer_->renderWindowGroupItem(group, window_title, is_active, is_minimized, appearance);
+    }
+    
+    void renderWindowPreview(const WindowPreview& preview, const TaskbarAppearance& appearance) override {
+        calls_[RenderWindowPreview]->increment();
+        renderer_->renderWindowPreview(preview, appearance);
+    }
+    
+    void hideWindowPreview(const TaskbarAppearance& appearance) override {
+        calls_[HideWindowPreview]->increment();
+        renderer_->hideWindowPreview(appearance);
+    }
+    
+    void renderStartMenu(const std::vector<ApplicationEntry>& entries, const TaskbarAppearance& appearance) override {
+        calls_[RenderStartMenu]->increment();
+        renderer_->renderStartMenu(entries, appearance);
+    }
+    
+    void hideStartMenu(const TaskbarAppearance& appearance) override {
+        calls_[HideStartMenu]->increment();
+        renderer_->hideStartMenu(appearance);
+    }
+    
+    void renderClock(const std::chrono::system_clock::time_point& current_time,
+                     const ClockFormat& format, const TaskbarAppearance& appearance) override {
+        calls_[RenderClock]->increment();
+        renderer_->renderClock(current_time, format, appearance);
+    }
+    
+    void renderClockText(const ClockText& text, const ClockFormat& format,
+                         const TaskbarAppearance& appearance) override {
+        calls_[RenderClockText]->increment();
+        renderer_->renderClockText(text, format, appearance);
+    }
+    
+    void setTaskbarOffset(int offset, const TaskbarAppearance& appearance) override {
+        calls_[SetTaskbarOffset]->increment();
+        renderer_->setTaskbarOffset(offset, appearance);
+    }
+    
+    std::pair<int, int> getTaskbarSize(const TaskbarAppearance& appearance) override {
+        calls_[GetTaskbarSize]->increment();
+        return renderer_->getTaskbarSize(appearance);
+    }
+    
+    bool renderDisplayList(TaskbarComponent component, const DisplayList& list,
+                           bool changed, const TaskbarAppearance& appearance) override {
+        calls_[RenderDisplayList]->increment();
+        return renderer_->renderDisplayList(component, list, changed, appearance);
+    }
+    
+    void showJumpList(const std::string& app_id, const RecentDocumentList& documents,
+                      const TaskbarAppearance& appearance) override {
+        calls_[ShowJumpList]->increment();
+        renderer_->showJumpList(app_id, documents, appearance);
+    }
+    
+    void renderNotifications(const std::vector<Notification>& notifications,
+                             const TaskbarAppearance& appearance) override {
+        calls_[RenderNotifications]->increment();
+        renderer_->renderNotifications(notifications, appearance);
+    }
+    
+    void hideNotifications(const TaskbarAppearance& appearance) override {
+        calls_[HideNotifications]->increment();
+        renderer_->hideNotifications(appearance);
+    }
+    
+    void renderWindowListOverflow(const WindowListViewport& viewport, const TaskbarAppearance& appearance) override {
+        calls_[RenderWindowListOverflow]->increment();
+        renderer_->renderWindowListOverflow(viewport, appearance);
+    }
+    
+    void renderWindowOverlay(const std::string& window_id, const WindowOverlay& overlay,
+                             const TaskbarAppearance& appearance) override {
+        calls_[RenderWindowOverlay]->increment();
+        renderer_->renderWindowOverlay(window_id, overlay, appearance);
+    }
+    
+    void renderTrayTooltip(const SystemTrayItem& item, const Sparkline& minute,
+                           const Sparkline& ten_minutes, const TaskbarAppearance& appearance) override {
+        calls_[RenderTrayTooltip]->increment();
+        renderer_->renderTrayTooltip(item, minute, ten_minutes, appearance);
+    }
+    
+    void hideTrayTooltip(const TaskbarAppearance& appearance) override {
+        calls_[HideTrayTooltip]->increment();
+        renderer_->hideTrayTooltip(appearance);
+    }
+    
+    void renderCalendar(const CalendarMonth& month, int today_index,
+                        const TaskbarAppearance& appearance) override {
+        calls_[RenderCalendar]->increment();
+        renderer_->renderCalendar(month, today_index, appearance);
+    }
+    
+    void hideCalendar(const TaskbarAppearance& appearance) override {
+        calls_[HideCalendar]->increment();
+        renderer_->hideCalendar(appearance);
+    }
+    
+    void renderKeyboardFocus(const std::string& item_id, const TaskbarAppearance& appearance) override {
+        calls_[RenderKeyboardFocus]->increment();
+        renderer_->renderKeyboardFocus(item_id, appearance);
+    }
+    
+private:
+    enum Method {
+        RenderBackground, RenderStartMenuButton, RenderQuickLaunchItem,
+        RenderWindowListItem, RenderSystemTrayItem, RenderWindowGroupItem,
+        RenderWindowPreview, HideWindowPreview, RenderStartMenu, HideStartMenu,
+        RenderClock, RenderClockText, SetTaskbarOffset, GetTaskbarSize,
+        RenderDisplayList, ShowJumpList, RenderNotifications, HideNotifications,
+        RenderWindowListOverflow, RenderWindowOverlay,
+        RenderTrayTooltip, HideTrayTooltip, RenderCalendar, HideCalendar, RenderKeyboardFocus,
+        MethodCount
+    };
+    
+    std::shared_ptr<ITaskbarRenderer> renderer_;
+    std::shared_ptr<Common::Counter> calls_[MethodCount];
+};
+
 class TaskbarManager::Impl {
 public:
-    Impl() : is_visible_(false), 
+    Impl() : keyboard_focused_(false),
+              keyboard_focus_index_(-1),
+              window_list_scroll_(0),
+              desktop_shown_(false),
+              shown_(false),
+              is_visible_(false), 
               is_start_menu_active_(false),
+              screen_width_(1920),
+              screen_height_(1080),
+              taskbar_offset_(0),
+              clock_running_(false),
+              clock_dirty_(false),
+              clock_shown_(true),
               last_error_(""),
-              total_launches_(0),
-              total_clicks_(0) {}
+              frame_requested_(false),
+              start_menu_dirty_(false),
+              snapshot_commands_(0),
+              calendar_open_(false),
+              calendar_year_(0),
+              calendar_month_(0),
+              notifications_(std::make_shared<NotificationCenter>()),
+              notifications_dirty_(false),
+              notification_panel_open_(false),
+              preview_ready_(false) {
+        // 每个任务栏实例的指标以instance标签区分，getStatistics()只读取本实例的序列
+        static std::atomic<uint64_t> next_instance(0);
+        const Common::MetricLabels labels = {{"instance", std::to_string(next_instance++)}};
+        auto& metrics = Common::MetricsRegistry::global();
+        clicks_metric_ = metrics.counter("taskbar_clicks_total", "任务栏点击次数", labels);
+        launches_metric_ = metrics.counter("taskbar_launches_total", "通过任务栏启动应用的次数", labels);
+        refresh_metric_ = metrics.counter("taskbar_refresh_total", "任务栏完整重绘次数", labels);
+        refresh_duration_metric_ = metrics.histogram("taskbar_refresh_duration_seconds", "任务栏完整重绘耗时（秒）", {}, labels);
+        windows_metric_ = metrics.gauge("taskbar_windows", "窗口列表中的窗口数量", labels);
+        launch_failures_metric_ = metrics.counter("taskbar_launch_failures_total", "应用启动失败次数", labels);
+        launch_spawn_metric_ = metrics.histogram("taskbar_launch_spawn_seconds", "posix_spawnp耗时（秒）", {}, labels);
+        display_list_hits_metric_ = metrics.counter("taskbar_display_list_hits_total", "复用缓存显示列表的组件渲染次数", labels);
+        display_list_records_metric_ = metrics.counter("taskbar_display_list_records_total", "重新录制显示列表的组件渲染次数", labels);
+        show_desktop_duration_metric_ = metrics.histogram("taskbar_show_desktop_duration_seconds", "显示桌面切换耗时（秒）", {}, labels);
+        minimize_all_duration_metric_ = metrics.histogram("taskbar_minimize_all_duration_seconds", "最小化全部窗口耗时（秒）", {}, labels);
+        launch_total_metric_ = metrics.histogram("taskbar_launch_seconds", "应用启动总耗时，含辅助进程往返（秒）", {}, labels);
+        
+        preview_cache_.setCompletionCallback([this](const std::string&) {
+            preview_ready_ = true;
+            requestFrame();
+        });
+        
+        // 通知只置脏，托盘项和通知面板在下一帧统一更新
+        notifications_->setChangeCallback([this]() {
+            notifications_dirty_ = true;
+            requestFrame();
+        });
+    }
     
-    ~Impl() = default;
+    ~Impl() {
+        // 保存最后布局好的状态，供下次登录时直接回放
+        if (!snapshot_path_.empty() && renderer_) {
+            saveStartupSnapshot();
+        }
+        
+        stopClockThread();
+        
+        // 停止状态轮询线程，避免其推送访问已析构的托盘状态
+        if (status_monitor_) {
+            status_monitor_->stop();
+        }
+        
+        // 停止索引监视线程，避免其回调访问已析构的任务栏
+        if (app_index_) {
+            app_index_->setChangeCallback(nullptr);
+            app_index_->stopWatching();
+        }
+        
+        // 注册表中的序列在实例析构后仍会导出，窗口数量归零
+        windows_metric_->set(0);
+    }
     
     bool initialize(std::shared_ptr<ITaskbarRenderer> renderer) {
         if (!renderer) {
@@ -30,7 +301,16 @@ public:
             return false;
         }
         
-        renderer_ = renderer;
+        renderer_ = std::make_shared<MeteredRenderer>(renderer);
+        configureAutoHide();
+        
+        // 在fork启动辅助进程、启动后台线程和加载配置之前回放上次的布局，面板在第一帧即显示完整
+        renderStartupSnapshot();
+        
+        // 在启动状态轮询和时钟线程、加载应用索引之前fork启动辅助进程，使其地址空间尽量小
+        if (!launch_helper_.start()) {
+            last_error_ = launch_helper_.getLastError();
+        }
         
         // 创建默认快速启动项
         createDefaultQuickLaunchItems();
@@ -38,6 +318,9 @@ public:
         // 创建默认系统托盘项
         createDefaultSystemTrayItems();
         
+        // 启动系统状态轮询
+        startStatusMonitor();
+        
         // 启动时钟更新线程
         startClockThread();
         
@@ -45,55 +328,40 @@ public:
     }
     
     void show() {
+        shown_ = true;
         is_visible_ = true;
         refresh();
     }
     
     void hide() {
+        shown_ = false;
         is_visible_ = false;
     }
     
     void refresh() {
         if (!is_visible_ || !renderer_) return;
         
-        // 渲染任务栏背景
-        renderer_->renderBackground(appearance_);
-        
-        // 渲染开始菜单按钮
-        renderer_->renderStartMenuButton(appearance_, is_start_menu_active_);
-        
-        // 渲染快速启动项
-        for (const auto& item : quick_launch_items_) {
-            if (item.visible) {
-                renderer_->renderQuickLaunchItem(item, appearance_);
-            }
-        }
+        auto refresh_start = std::chrono::steady_clock::now();
         
-        // 渲染窗口列表
-        for (const auto& window : window_list_) {
-            bool is_active = (active_window_id_ == window.first);
-            bool is_minimized = (minimized_windows_.find(window.first) != minimized_windows_.end());
-            renderer_->renderWindowListItem(window.first, window.second, is_active, is_minimized, appearance_);
+        // 所有输出共享同一份模型，依次按各自外观渲染
+        renderOutput(*renderer_, appearance_, display_lists_);
+        for (auto& output : outputs_) {
+            renderOutput(*output.renderer, output.appearance, output.display_lists);
         }
         
-        // 渲染系统托盘项
-        if (appearance_.show_system_tray) {
-            for (const auto& item : system_tray_items_) {
-                if (item.visible) {
-                    renderer_->renderSystemTrayItem(item, appearance_);
-                }
-            }
-        }
+        // 时钟文本只格式化一次
+        renderClock();
         
-        // 渲染时钟
-        if (appearance_.show_clock) {
-            renderer_->renderClock(current_time_, clock_format_, appearance_);
-        }
+        refresh_metric_->increment();
+        refresh_duration_metric_->observeDuration(std::chrono::steady_clock::now() - refresh_start);
     }
     
     void setAppearance(const TaskbarAppearance& appearance) {
         appearance_ = appearance;
+        updateClockVisibility();
+        configureAutoHide();
         refresh();
+        scheduleConfigSave();
         
         // 触发外观改变事件
         TaskbarEvent event(TaskbarEvent::Type::TaskbarResized);
@@ -116,6 +384,7 @@ public:
         
         quick_launch_items_.push_back(item);
         refresh();
+        scheduleConfigSave();
         return true;
     }
     
@@ -132,6 +401,7 @@ public:
         
         quick_launch_items_.erase(it);
         refresh();
+        scheduleConfigSave();
         return true;
     }
     
@@ -139,6 +409,40 @@ public:
         return quick_launch_items_;
     }
     
+    std::vector<QuickLaunchItem> getRankedQuickLaunchItems() const {
+        std::vector<QuickLaunchItem> ranked;
+        ranked.reserve(quick_launch_items_.size());
+        std::set<std::string> added;
+        
+        for (const auto& id : frecency_.getRanked()) {
+            auto it = std::find_if(quick_launch_items_.begin(), quick_launch_items_.end(),
+                                  [&id](const QuickLaunchItem& item) {
+                                      return item.id == id;
+                                  });
+            if (it != quick_launch_items_.end()) {
+                ranked.push_back(*it);
+                added.insert(id);
+            }
+        }
+        
+        for (const auto& item : quick_launch_items_) {
+            if (added.find(item.id) == added.end()) {
+                ranked.push_back(item);
+            }
+        }
+        return ranked;
+    }
+    
+    void recordApplicationLaunch(const std::string& app_id) {
+        frecency_.recordLaunch(app_id);
+        launches_metric_->increment();
+        scheduleConfigSave();
+    }
+    
+    std::vector<std::string> getRankedApplications(size_t limit) const {
+        return frecency_.getRanked(limit);
+    }
+    
     bool addSystemTrayItem(const SystemTrayItem& item) {
         // 检查项目ID是否已存在
         if (std::find_if(system_tray_items_.begin(), system_tray_items_.end(),
@@ -150,6 +454,7 @@ public:
         }
         
         system_tray_items_.push_back(item);
+        registerTrayItem(item);
         refresh();
         return true;
     }
@@ -165,6 +470,10 @@ public:
             return false;
         }
         
+        {
+            std::lock_guard<std::mutex> lock(tray_mutex_);
+            tray_updates_.erase(item_id);
+        }
         system_tray_items_.erase(it);
         refresh();
         return true;
@@ -174,22 +483,75 @@ public:
         return system_tray_items_;
     }
     
+    bool updateSystemTrayItem(const SystemTrayItem& item) {
+        {
+            std::lock_guard<std::mutex> lock(tray_mutex_);
+            auto it = tray_updates_.find(item.id);
+            if (it == tray_updates_.end()) return false;
+            
+            // 冗余更新在进入渲染路径之前丢弃
+            TrayUpdateState& state = it->second;
+            if (sameTrayState(state.latest, item)) return true;
+            
+            state.latest = item;
+            if (state.version++ == state.committed_version) {
+                dirty_tray_ids_.push_back(item.id);
+            }
+        }
+        requestFrame();
+        return true;
+    }
+    
+    bool setSystemTrayItemMaxUpdateRate(const std::string& item_id, double max_updates_per_second) {
+        std::lock_guard<std::mutex> lock(tray_mutex_);
+        auto it = tray_updates_.find(item_id);
+        if (it == tray_updates_.end()) return false;
+        
+        it->second.min_interval = (max_updates_per_second > 0)
+            ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(1.0 / max_updates_per_second))
+            : std::chrono::steady_clock::duration::zero();
+        return true;
+    }
+    
     void setClockFormat(const ClockFormat& format) {
-        clock_format_ = format;
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            clock_format_ = format;
+            clock_text_.setFormat(format);
+        }
+        // 更新周期可能变化，唤醒时钟线程重新计算下一个进位时刻
+        clock_cv_.notify_all();
         refresh();
+        scheduleConfigSave();
     }
     
     ClockFormat getClockFormat() const {
+        std::lock_guard<std::mutex> lock(clock_mutex_);
         return clock_format_;
     }
     
-    bool addWindowToList(const std::string& window_id, const std::string& window_title) {
+    bool addWindowToList(const std::string& window_id, const std::string& window_title, 
+                         const std::string& app_id) {
         if (window_list_.find(window_id) != window_list_.end()) {
             last_error_ = "窗口已存在: " + window_id;
             return false;
         }
         
-        window_list_[window_id] = window_title;
+        auto inserted = window_list_.emplace(window_id, window_title).first;
+        auto pos = window_order_.insert(std::lower_bound(window_order_.begin(), window_order_.end(), window_id,
+                                                         [](WindowListIterator item, const std::string& id) {
+                                                             return item->first < id;
+                                                         }),
+                                        inserted);
+        reindexWindowOrder(static_cast<size_t>(pos - window_order_.begin()));
+        addWindowToGroup(window_id, app_id);
+        {
+            std::lock_guard<std::mutex> lock(overlay_mutex_);
+            window_overlays_.emplace(window_id, OverlayUpdateState());
+        }
+        endShowDesktop();
+        windows_metric_->set(static_cast<int64_t>(window_list_.size()));
         refresh();
         return true;
     }
@@ -201,12 +563,36 @@ public:
             return false;
         }
         
+        removeWindowFromGroup(window_id);
+        auto position = window_positions_.find(window_id);
+        size_t index = position->second;
+        window_positions_.erase(position);
+        window_order_.erase(window_order_.begin() + index);
+        reindexWindowOrder(index);
         window_list_.erase(it);
+        windows_metric_->set(static_cast<int64_t>(window_list_.size()));
         minimized_windows_.erase(window_id);
+        content_generations_.erase(window_id);
+        if (window_pids_.erase(window_id) && usage_provider_) {
+            usage_provider_->untrackWindow(window_id);
+        }
+        {
+            std::lock_guard<std::mutex> lock(overlay_mutex_);
+            window_overlays_.erase(window_id);
+        }
+        preview_cache_.invalidate(window_id);
+        if (hovered_window_id_ == window_id) {
+            hovered_window_id_.clear();
+            renderer_->hideWindowPreview(appearance_);
+        }
         
         if (active_window_id_ == window_id) {
             active_window_id_.clear();
         }
+        int item_count = static_cast<int>(windowListItemCount(appearance_));
+        if (keyboard_focus_index_ >= item_count) {
+            keyboard_focus_index_ = item_count - 1;
+        }
         
         refresh();
         return true;
@@ -215,243 +601,719 @@ public:
     void setWindowActive(const std::string& window_id, bool is_active) {
         if (is_active) {
             active_window_id_ = window_id;
+            revealWindow(window_id);
         } else if (active_window_id_ == window_id) {
             active_window_id_.clear();
         }
         refresh();
     }
     
+    void scrollWindowList(int items) {
+        if (!renderer_) return;
+        
+        WindowListViewport viewport = windowListViewport(*renderer_, appearance_);
+        long long first = static_cast<long long>(viewport.first) + items;
+        long long last_first = static_cast<long long>(viewport.total - viewport.visible);
+        size_t clamped = static_cast<size_t>(std::max(0LL, std::min(first, last_first)));
+        if (clamped == viewport.first) return;
+        
+        window_list_scroll_ = clamped;
+        refresh();
+    }
+    
+    WindowListViewport getWindowListViewport() const {
+        if (!renderer_) return WindowListViewport();
+        return windowListViewport(*renderer_, appearance_);
+    }
+    
     void setWindowMinimized(const std::string& window_id, bool is_minimized) {
-        if (is_minimized) {
-            minimized_windows_.insert(window_id);
+        markWindowMinimized(window_id, is_minimized);
+        refresh();
+    }
+    
+    void setWindowProgress(const std::string& window_id, WindowOverlay::ProgressState state, double fraction) {
+        double clamped = std::max(0.0, std::min(1.0, fraction));
+        uint16_t progress = static_cast<uint16_t>(clamped * 1000 + 0.5);
+        updateWindowOverlay(window_id, [state, progress](WindowOverlay& overlay) {
+            overlay.progress_state = state;
+            overlay.progress = (state == WindowOverlay::ProgressState::None) ? 0 : progress;
+        });
+    }
+    
+    void setWindowBadge(const std::string& window_id, uint32_t count) {
+        updateWindowOverlay(window_id, [count](WindowOverlay& overlay) {
+            overlay.badge = count;
+        });
+    }
+    
+    WindowOverlay getWindowOverlay(const std::string& window_id) const {
+        std::lock_guard<std::mutex> lock(overlay_mutex_);
+        auto it = window_overlays_.find(window_id);
+        return it != window_overlays_.end() ? it->second.latest : WindowOverlay();
+    }
+    
+    void setWindowProcess(const std::string& window_id, int pid) {
+        if (pid > 0 && window_list_.count(window_id)) {
+            window_pids_[window_id] = pid;
         } else {
-            minimized_windows_.erase(window_id);
+            window_pids_.erase(window_id);
+            pid = 0;
+        }
+        if (usage_provider_) {
+            usage_provider_->trackWindow(window_id, pid);
         }
-        refresh();
     }
     
-    std::map<std::string, std::string> getWindowList() const {
-        return window_list_;
+    void setWindowController(std::shared_ptr<ITaskbarWindowController> controller) {
+        window_controller_ = std::move(controller);
     }
     
-    void handleMouseClick(int x, int y, int button) {
-        total_clicks_++;
+    void minimizeAllWindows() {
+        auto start = std::chrono::steady_clock::now();
         
-        // 检测点击位置并处理相应事件
-        if (isStartMenuButtonClicked(x, y)) {
-            handleStartMenuClick(button);
-        } else if (isQuickLaunchItemClicked(x, y)) {
-            handleQuickLaunchItemClick(x, y, button);
-        } else if (isWindowListItemClicked(x, y)) {
-            handleWindowListItemClick(x, y, button);
-        } else if (isSystemTrayItemClicked(x, y)) {
-            handleSystemTrayItemClick(x, y, button);
-        } else if (isClockClicked(x, y)) {
-            handleClockClick(button);
-        }
+        endShowDesktop();
+        setWindowsMinimized(collectVisibleWindows(), true);
+        refresh();
+        
+        minimize_all_duration_metric_->observeDuration(std::chrono::steady_clock::now() - start);
     }
     
-    void handleMouseMove(int x, int y) {
-        // 处理鼠标悬停效果
-        if (appearance_.auto_hide) {
-            // 自动隐藏逻辑：鼠标靠近任务栏区域时显示
-            auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-            int screen_width = 1920; // 假设屏幕宽度
-            int screen_height = 1080; // 假设屏幕高度
-            
-            bool should_show = false;
-            switch (appearance_.position) {
-                case TaskbarPosition::Bottom:
-                    should_show = (y >= screen_height - 10);
-                    break;
-                case TaskbarPosition::Top:
-                    should_show = (y <= 10);
-                    break;
-                case TaskbarPosition::Left:
-                    should_show = (x <= 10);
-                    break;
-                case TaskbarPosition::Right:
-                    should_show = (x >= screen_width - 10);
-                    break;
+    void showDesktop() {
+        auto start = std::chrono::steady_clock::now();
+        
+        // 取消开始菜单激活状态
+        is_start_menu_active_ = false;
+        
+        if (desktop_shown_) {
+            // 只恢复显示桌面前可见、且仍处于最小化的窗口
+            std::vector<std::string> restore_ids;
+            restore_ids.reserve(desktop_restore_ids_.size());
+            for (const auto& window_id : desktop_restore_ids_) {
+                if (minimized_windows_.count(window_id)) {
+                    restore_ids.push_back(window_id);
+                }
             }
-            
-            if (should_show != is_visible_) {
-                is_visible_ = should_show;
-                refresh();
+            endShowDesktop();
+            setWindowsMinimized(restore_ids, false);
+        } else {
+            std::vector<std::string> visible_ids = collectVisibleWindows();
+            if (setWindowsMinimized(visible_ids, true)) {
+                desktop_restore_ids_ = std::move(visible_ids);
+                desktop_shown_ = true;
             }
         }
+        refresh();
+        
+        show_desktop_duration_metric_->observeDuration(std::chrono::steady_clock::now() - start);
     }
     
-    void handleKeyboardEvent(int key_code, bool ctrl_pressed, bool shift_pressed) {
-        // 处理键盘快捷键
-        switch (key_code) {
-            case 91: // Windows键 - 打开开始菜单
-                toggleStartMenu();
-                break;
-            case 77: // M键 + Windows键 - 最小化所有窗口
-                if (ctrl_pressed) {
-                    minimizeAllWindows();
-                }
-                break;
-            case 68: // D键 + Windows键 - 显示桌面
-                if (ctrl_pressed) {
-                    showDesktop();
-                }
-                break;
-        }
+    std::map<std::string, std::string> getWindowList() const {
+        return window_list_;
     }
     
-    void addEventListener(std::function<void(const TaskbarEvent&)> callback) {
-        event_listeners_.push_back(callback);
+    std::vector<WindowGroup> getWindowGroups() const {
+        std::vector<WindowGroup> groups;
+        groups.reserve(group_order_.size());
+        for (const auto& key : group_order_) {
+            groups.push_back(window_groups_.at(key));
+        }
+        return groups;
     }
     
-    bool saveConfig(const std::string& config_path) {
-        try {
-            Json::Value root;
-            
-            // 保存外观设置
-            Json::Value appearance_obj;
-            appearance_obj["position"] = static_cast<int>(appearance_.position);
-            appearance_obj["style"] = static_cast<int>(appearance_.style);
-            appearance_obj["height"] = appearance_.height;
-            appearance_obj["auto_hide"] = appearance_.auto_hide;
-            appearance_obj["always_on_top"] = appearance_.always_on_top;
-            appearance_obj["show_clock"] = appearance_.show_clock;
-            appearance_obj["show_system_tray"] = appearance_.show_system_tray;
-            root["appearance"] = appearance_obj;
-            
-            // 保存快速启动项
-            Json::Value quick_launch_array(Json::arrayValue);
-            for (const auto& item : quick_launch_items_) {
-                Json::Value item_obj;
-                item_obj["id"] = item.id;
-                item_obj["name"] = item.name;
-                item_obj["icon_path"] = item.icon_path;
-                item_obj["executable_path"] = item.executable_path;
-                item_obj["launch_count"] = item.launch_count;
-                quick_launch_array.append(item_obj);
-            }
-            root["quick_launch_items"] = quick_launch_array;
-            
-            // 保存时钟格式
-            Json::Value clock_format_obj;
-            clock_format_obj["show_date"] = clock_format_.show_date;
-            clock_format_obj["show_seconds"] = clock_format_.show_seconds;
-            clock_format_obj["time_format"] = clock_format_.time_format;
-            clock_format_obj["date_format"] = clock_format_.date_format;
-            root["clock_format"] = clock_format_obj;
-            
-            std::ofstream file(config_path);
-            if (!file.is_open()) {
-                last_error_ = "无法打开配置文件: " + config_path;
-                return false;
-            }
-            
-            file << root;
-            file.close();
-            
-            return true;
-        } catch (const std::exception& e) {
-            last_error_ = std::string("保存配置失败: ") + e.what();
+    bool openApplicationIndex(const std::string& cache_path) {
+        auto index = std::make_shared<ApplicationIndex>(cache_path);
+        
+        // 先设置回调：索引在后台加载或重建，完成后在同一线程中重建搜索数据并刷新开始菜单
+        // （回调保存在索引内，捕获裸指针避免循环引用）
+        ApplicationIndex* raw_index = index.get();
+        index->setChangeCallback([this, raw_index]() {
+            rebuildSearch(raw_index->snapshot());
+            start_menu_dirty_ = true;
+            requestFrame();
+        });
+        if (!index->load()) {
+            last_error_ = "加载应用索引失败: " + index->getLastError();
             return false;
         }
+        
+        if (!index->startWatching()) {
+            last_error_ = index->getLastError();
+        }
+        
+        app_index_ = index;
+        return true;
     }
     
-    bool loadConfig(const std::string& config_path) {
-        try {
-            std::ifstream file(config_path);
-            if (!file.is_open()) {
-                last_error_ = "无法打开配置文件: " + config_path;
-                return false;
-            }
-            
-            Json::Value root;
-            file >> root;
-            file.close();
-            
-            // 加载外观设置
-            const Json::Value& appearance_obj = root["appearance"];
-            appearance_.position = static_cast<TaskbarPosition>(appearance_obj["position"].asInt());
-            appearance_.style = static_cast<TaskbarStyle>(appearance_obj["style"].asInt());
-            appearance_.height = appearance_obj["height"].asInt();
-            appearance_.auto_hide = appearance_obj["auto_hide"].asBool();
-            appearance_.always_on_top = appearance_obj["always_on_top"].asBool();
-            appearance_.show_clock = appearance_obj["show_clock"].asBool();
-            appearance_.show_system_tray = appearance_obj["show_system_tray"].asBool();
-            
-            // 加载快速启动项
-            quick_launch_items_.clear();
-            const Json::Value& quick_launch_array = root["quick_launch_items"];
-            for (const auto& item_obj : quick_launch_array) {
-                QuickLaunchItem item;
-                item.id = item_obj["id"].asString();
-                item.name = item_obj["name"].asString();
-                item.icon_path = item_obj["icon_path"].asString();
-                item.executable_path = item_obj["executable_path"].asString();
-                item.launch_count = item_obj["launch_count"].asInt();
-                quick_launch_items_.push_back(item);
-            }
-            
-            // 加载时钟格式
-            const Json::Value& clock_format_obj = root["clock_format"];
-            clock_format_.show_date = clock_format_obj["show_date"].asBool();
-            clock_format_.show_seconds = clock_format_obj["show_seconds"].asBool();
-            clock_format_.time_format = clock_format_obj["time_format"].asString();
-            clock_format_.date_format = clock_format_obj["date_format"].asString();
-            
-            refresh();
-            return true;
-        } catch (const std::exception& e) {
-            last_error_ = std::string("加载配置失败: ") + e.what();
+    std::shared_ptr<ApplicationIndex> getApplicationIndex() const {
+        return app_index_;
+    }
+    
+    bool openRecentDocuments(const std::string& path) {
+        auto documents = std::make_shared<RecentDocuments>(path);
+        
+        // 首次解析在服务的监视线程中进行，完成前跳转列表为空
+        if (!documents->startWatching()) {
+            last_error_ = "打开最近文档失败: " + documents->getLastError();
             return false;
         }
+        
+        std::string error = documents->getLastError();
+        if (!error.empty()) {
+            last_error_ = error;
+        }
+        
+        recent_documents_ = documents;
+        return true;
     }
     
-    std::string getLastError() const {
-        return last_error_;
+    std::shared_ptr<const RecentDocumentList> getRecentDocuments(const std::string& app_id) const {
+        if (!recent_documents_) return nullptr;
+        return recent_documents_->query(app_id);
     }
     
-    bool isVisible() const {
-        return is_visible_;
+    uint64_t postNotification(const Notification& notification) {
+        return notifications_->post(notification);
     }
     
-    void toggleAutoHide() {
-        appearance_.auto_hide = !appearance_.auto_hide;
+    void toggleCalendar() {
+        if (!renderer_) return;
         
-        TaskbarEvent event(TaskbarEvent::Type::AutoHideToggled);
-        notifyEventListeners(event);
+        calendar_open_ = !calendar_open_;
+        if (!calendar_open_) {
+            renderer_->hideCalendar(appearance_);
+            return;
+        }
         
-        refresh();
+        std::time_t now = std::time(nullptr);
+        std::tm local_time;
+        localtime_r(&now, &local_time);
+        calendar_year_ = local_time.tm_year + 1900;
+        calendar_month_ = local_time.tm_mon + 1;
+        renderCalendar();
+        
+        // 预先生成前后两个月，之后的翻页命中缓存
+        for (int delta : {-1, 1}) {
+            int index = calendar_year_ * 12 + calendar_month_ - 1 + delta;
+            calendar_.getMonth(index / 12, index % 12 + 1);
+        }
     }
     
-    std::string getStatistics() const {
-        std::stringstream stats;
-        stats << "=== 任务栏统计信息 ===\n";
-        stats << "总启动次数: " << total_launches_ << "\n";
-        stats << "总点击次数: " << total_clicks_ << "\n";
-        stats << "快速启动项数量: " << quick_launch_items_.size() << "\n";
-        stats << "系统托盘项数量: " << system_tray_items_.size() << "\n";
-        stats << "窗口列表数量: " << window_list_.size() << "\n";
-        stats << "最小化窗口数量: " << minimized_windows_.size() << "\n";
+    void pageCalendar(int months) {
+        if (!calendar_open_ || months == 0) return;
         
-        return stats.str();
+        int index = calendar_year_ * 12 + calendar_month_ - 1 + months;
+        if (index < 12 || index >= 10000 * 12) return;
+        calendar_year_ = index / 12;
+        calendar_month_ = index % 12 + 1;
+        renderCalendar();
     }
-
-private:
-    void createDefaultQuickLaunchItems() {
-        // 文件管理器
-        QuickLaunchItem file_manager;
-        file_manager.id = "file_manager";
-        file_manager.name = "文件管理器";
-        file_manager.icon_path = "/usr/share/icons/file-manager.png";
-        file_manager.executable_path = "/usr/bin/cloudflow-file-manager";
-        quick_launch_items_.push_back(file_manager);
-        
-        // 浏览器
-        QuickLaunchItem browser;
-        browser.id = "browser";
-        browser.name = "浏览器";
-        browser.icon_path = "/usr/share/icons/browser.png";
+    
+    LunarCalendar& getCalendar() {
+        return calendar_;
+    }
+    
+    std::shared_ptr<NotificationCenter> getNotificationCenter() const {
+        return notifications_;
+    }
+    
+    bool loadPinyinTable(const std::string& path) {
+        auto pinyin = std::make_shared<PinyinTable>();
+        if (!pinyin->loadFromFile(path)) {
+            last_error_ = "无法加载拼音字表: " + path;
+            return false;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(search_mutex_);
+            pinyin_ = pinyin;
+        }
+        
+        // 已有索引时按新字表重建搜索数据
+        if (app_index_) {
+            rebuildSearch(app_index_->snapshot());
+            start_menu_dirty_ = true;
+            requestFrame();
+        }
+        return true;
+    }
+    
+    void setStartMenuQuery(const std::string& query) {
+        if (query == start_menu_query_) return;
+        
+        start_menu_query_ = query;
+        if (is_start_menu_active_ && renderer_) {
+            renderStartMenu();
+        }
+    }
+    
+    std::vector<std::string> searchApplications(const std::string& query, size_t limit) {
+        std::vector<std::string> ids;
+        auto search = currentSearch();
+        if (!search) return ids;
+        
+        auto snapshot = search->snapshot();
+        for (const auto& result : search->search(query, limit)) {
+            ids.emplace_back(snapshot->entry(result.index).id);
+        }
+        return ids;
+    }
+    
+    void setWindowContentProvider(WindowContentProvider provider) {
+        preview_cache_.setContentProvider(std::move(provider));
+    }
+    
+    void notifyWindowContentChanged(const std::string& window_id) {
+        uint64_t generation = ++content_generations_[window_id];
+        if (window_id == hovered_window_id_) {
+            preview_cache_.request(window_id, generation, false);
+        }
+    }
+    
+    void setFrameRequestCallback(std::function<void()> callback) {
+        frame_request_callback_ = std::move(callback);
+    }
+    
+    void tickClock() {
+        // 可能在时钟线程中调用，只标记时钟，由面板线程在下一帧重绘
+        if (!clock_shown_) return;
+        clock_dirty_ = true;
+        requestFrame();
+    }
+    
+    void processFrame() {
+        // 在清除帧请求标志之前发布通知状态，托盘更新并入本帧而不再请求新帧
+        if (notifications_dirty_.exchange(false)) {
+            publishNotifications();
+        }
+        
+        frame_requested_ = false;
+        
+        // 提交本帧内合并后的托盘项更新，只重绘发生变化的项
+        commitTrayUpdates();
+        
+        // 提交本帧内合并后的进度与徽标更新，只重绘受影响项的叠加层
+        commitOverlayUpdates();
+        
+        // 推进自动隐藏计时器和滑动动画
+        if (appearance_.auto_hide) {
+            updateAutoHide(std::chrono::steady_clock::now());
+        }
+        
+        if (!is_visible_ || !renderer_) return;
+        
+        // 时钟文本进位后只重绘时钟
+        if (clock_dirty_.exchange(false)) {
+            renderClock();
+        }
+        
+        // 应用索引在后台刷新后，已打开的开始菜单在本帧重新渲染
+        if (start_menu_dirty_.exchange(false) && is_start_menu_active_) {
+            renderStartMenu();
+        }
+        
+        // 异步生成的预览就绪后，只有仍在悬停的窗口才需要显示
+        if (preview_ready_.exchange(false) && !hovered_window_id_.empty()) {
+            auto preview = preview_cache_.get(hovered_window_id_, contentGeneration(hovered_window_id_));
+            if (preview) {
+                renderer_->renderWindowPreview(*preview, appearance_);
+            }
+        }
+    }
+    
+    void handleMouseClick(int x, int y, int button) {
+        clicks_metric_->increment();
+        
+        // 检测点击位置并处理相应事件
+        if (isStartMenuButtonClicked(x, y)) {
+            handleStartMenuClick(button);
+        } else if (isQuickLaunchItemClicked(x, y)) {
+            handleQuickLaunchItemClick(x, y, button);
+        } else if (isWindowListItemClicked(x, y)) {
+            handleWindowListItemClick(x, y, button);
+        } else if (isSystemTrayItemClicked(x, y)) {
+            handleSystemTrayItemClick(x, y, button);
+        } else if (isClockClicked(x, y)) {
+            handleClockClick(button);
+        }
+    }
+    
+    void handleMouseWheel(int x, int y, int delta) {
+        // 滚轮在窗口列表上每格滚动一项，向上（正值）滚向列表开头
+        if (renderer_ && isWindowListItemClicked(x, y) && delta != 0) {
+            scrollWindowList(-delta);
+        }
+    }
+    
+    void handleMouseMove(int x, int y) {
+        // 自动隐藏：只有指针跨越区间阈值时才启动计时器
+        if (appearance_.auto_hide &&
+            auto_hide_.onPointerMove(x, y, std::chrono::steady_clock::now())) {
+            if (frame_request_callback_) {
+                requestFrame();
+            } else {
+                // 没有帧调度时不做延迟和动画，直接切换
+                auto_hide_.settle();
+                applyAutoHideState();
+            }
+        }
+        
+        updateWindowHover(x, y);
+        updateTrayHover(x, y);
+    }
+    
+    void handleKeyboardEvent(int key_code, bool /*ctrl_pressed*/, bool /*shift_pressed*/, bool super_pressed) {
+        // Windows键 + 1..9 - 激活第N个窗口列表项
+        if (super_pressed && key_code >= 49 && key_code <= 57) {
+            activateWindowListItem(static_cast<size_t>(key_code - 49));
+            return;
+        }
+        
+        // 处理键盘快捷键
+        switch (key_code) {
+            case 91: // Windows键 - 打开开始菜单
+                toggleStartMenu();
+                break;
+            case 77: // M键 + Windows键 - 最小化所有窗口
+                if (super_pressed) {
+                    minimizeAllWindows();
+                }
+                break;
+            case 68: // D键 + Windows键 - 显示桌面
+                if (super_pressed) {
+                    showDesktop();
+                }
+                break;
+            case 37: // 左方向键
+            case 38: // 上方向键 - 焦点移到上一个窗口列表项
+                if (keyboardNavigationActive()) {
+                    moveKeyboardFocus(-1);
+                }
+                break;
+            case 39: // 右方向键
+            case 40: // 下方向键 - 焦点移到下一个窗口列表项
+                if (keyboardNavigationActive()) {
+                    moveKeyboardFocus(1);
+                }
+                break;
+            case 13: // Enter键
+            case 32: // 空格键 - 激活焦点所在的窗口列表项
+                if (keyboardNavigationActive() && keyboard_focus_index_ >= 0) {
+                    activateWindowListItem(static_cast<size_t>(keyboard_focus_index_));
+                }
+                break;
+        }
+    }
+    
+    void setKeyboardFocus(bool focused) {
+        if (keyboard_focused_ == focused) return;
+        
+        keyboard_focused_ = focused;
+        keyboard_focus_index_ = -1;
+        if (focused && windowListItemCount(appearance_) > 0) {
+            // 从活动窗口所在的项开始，没有活动窗口时从第一项开始
+            keyboard_focus_index_ = std::max(0, windowListIndexOf(active_window_id_));
+        }
+        updateKeyboardFocus();
+    }
+    
+    bool hasKeyboardFocus() const {
+        return keyboard_focused_;
+    }
+    
+    void addEventListener(std::function<void(const TaskbarEvent&)> callback) {
+        event_listeners_.push_back(callback);
+    }
+    
+    bool saveConfig(const std::string& config_path) {
+        // 已启用自动保存时经后台写入器写入，避免与尚未写入的自动保存请求交错
+        if (config_persister_) {
+            config_persister_->schedule(config_path, snapshotConfig());
+            return flushConfig();
+        }
+        
+        std::string error;
+        if (!ConfigPersister::write(config_path, snapshotConfig(), error)) {
+            last_error_ = error;
+            return false;
+        }
+        return true;
+    }
+    
+    bool loadConfig(const std::string& config_path) {
+        // 先读取并校验到暂存区，任何字段无效都不改变当前配置
+        TaskbarConfig config;
+        std::string error;
+        if (!ConfigPersister::read(config_path, config, error)) {
+            last_error_ = error;
+            return false;
+        }
+        
+        appearance_ = config.appearance;
+        updateClockVisibility();
+        configureAutoHide();
+        quick_launch_items_ = std::move(config.quick_launch_items);
+        frecency_.clear();
+        for (const auto& entry : config.frecency) {
+            frecency_.importEntry(entry);
+        }
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            clock_format_ = config.clock_format;
+            clock_text_.setFormat(config.clock_format);
+        }
+        clock_cv_.notify_all();
+        
+        // 全部应用后只刷新一次
+        refresh();
+        return true;
+    }
+    
+    void setConfigAutoSave(const std::string& config_path) {
+        // 切换或关闭自动保存前写完尚未保存的配置
+        if (config_persister_) {
+            config_persister_->flush();
+        }
+        config_autosave_path_ = config_path;
+        if (!config_path.empty() && !config_persister_) {
+            config_persister_ = std::make_unique<ConfigPersister>();
+        }
+    }
+    
+    bool flushConfig() {
+        if (!config_persister_) return true;
+        if (!config_persister_->flush()) {
+            last_error_ = config_persister_->getLastError();
+            return false;
+        }
+        return true;
+    }
+    
+    void setStartupSnapshot(const std::string& snapshot_path) {
+        snapshot_path_ = snapshot_path;
+    }
+    
+    bool saveStartupSnapshot() {
+        if (snapshot_path_.empty() || !renderer_) {
+            last_error_ = "未设置启动快照路径或渲染器";
+            return false;
+        }
+        
+        StartupSnapshot snapshot;
+        snapshot.appearance = appearance_;
+        std::tie(snapshot.width, snapshot.height) = renderer_->getTaskbarSize(appearance_);
+        snapshot.clock_format = getClockFormat();
+        
+        // 只保存主输出上与会话无关的组件，窗口列表在下次登录时已不存在
+        for (TaskbarComponent component : {TaskbarComponent::Background, TaskbarComponent::StartMenu,
+                                           TaskbarComponent::QuickLaunch, TaskbarComponent::SystemTray}) {
+            const DisplayListCache::Entry& entry = display_lists_.entries[static_cast<size_t>(component)];
+            if (!entry.valid) continue;
+            
+            StartupSnapshot::Component saved;
+            saved.component = component;
+            saved.input_hash = entry.input_hash;
+            saved.list = entry.list;
+            snapshot.components.push_back(std::move(saved));
+        }
+        if (snapshot.components.empty()) {
+            last_error_ = "任务栏尚未渲染，没有可保存的启动快照";
+            return false;
+        }
+        
+        std::string error;
+        if (!StartupSnapshot::write(snapshot_path_, snapshot, error)) {
+            last_error_ = error;
+            return false;
+        }
+        return true;
+    }
+    
+    std::string getLastError() const {
+        return last_error_;
+    }
+    
+    bool isVisible() const {
+        return is_visible_;
+    }
+    
+    bool addOutput(const std::string& output_id, std::shared_ptr<ITaskbarRenderer> renderer,
+                   const TaskbarAppearance& appearance) {
+        if (!renderer) {
+            last_error_ = "渲染器不能为空";
+            return false;
+        }
+        if (findOutput(output_id) != outputs_.end()) {
+            last_error_ = "输出已存在: " + output_id;
+            return false;
+        }
+        
+        OutputView output;
+        output.id = output_id;
+        output.renderer = std::make_shared<MeteredRenderer>(renderer);
+        output.appearance = appearance;
+        outputs_.push_back(std::move(output));
+        updateClockVisibility();
+        
+        // 只渲染新输出，已有输出不受影响
+        if (is_visible_) {
+            renderOutputWithClock(outputs_.back());
+        }
+        return true;
+    }
+    
+    bool removeOutput(const std::string& output_id) {
+        auto it = findOutput(output_id);
+        if (it == outputs_.end()) {
+            last_error_ = "输出不存在: " + output_id;
+            return false;
+        }
+        
+        outputs_.erase(it);
+        updateClockVisibility();
+        return true;
+    }
+    
+    bool setOutputAppearance(const std::string& output_id, const TaskbarAppearance& appearance) {
+        auto it = findOutput(output_id);
+        if (it == outputs_.end()) {
+            last_error_ = "输出不存在: " + output_id;
+            return false;
+        }
+        
+        it->appearance = appearance;
+        updateClockVisibility();
+        if (is_visible_) {
+            renderOutputWithClock(*it);
+        }
+        return true;
+    }
+    
+    std::vector<std::string> getOutputIds() const {
+        std::vector<std::string> ids;
+        ids.reserve(outputs_.size());
+        for (const auto& output : outputs_) {
+            ids.push_back(output.id);
+        }
+        return ids;
+    }
+    
+    LaunchResult launchApplication(const std::string& executable, const std::vector<std::string>& arguments) {
+        LaunchResult result = launch_helper_.launch(executable, arguments);
+        launches_metric_->increment();
+        launch_spawn_metric_->observe(result.spawn_ns / 1e9);
+        launch_total_metric_->observe(result.total_ns / 1e9);
+        if (!result.success) {
+            launch_failures_metric_->increment();
+            last_error_ = "启动应用失败: " + executable + " (" + std::strerror(result.error) + ")";
+        }
+        return result;
+    }
+    
+    void setScreenGeometry(int width, int height) {
+        screen_width_ = width;
+        screen_height_ = height;
+        configureAutoHide();
+    }
+    
+    void setVolumeLevel(int percent, bool muted) {
+        if (volume_provider_) {
+            volume_provider_->setVolume(percent, muted);
+        }
+    }
+    
+    void toggleAutoHide() {
+        appearance_.auto_hide = !appearance_.auto_hide;
+        
+        // 切换后从完全显示开始，指针离开后再按延迟隐藏
+        auto_hide_.reset(true);
+        applyAutoHideState();
+        
+        TaskbarEvent event(TaskbarEvent::Type::AutoHideToggled);
+        notifyEventListeners(event);
+        
+        refresh();
+    }
+    
+    TaskbarStatistics getStatistics() const {
+        TaskbarStatistics stats;
+        stats.launches = launches_metric_->value();
+        stats.launch_failures = launch_failures_metric_->value();
+        stats.clicks = clicks_metric_->value();
+        stats.refreshes = refresh_metric_->value();
+        stats.windows = windows_metric_->value();
+        stats.quick_launch_items = quick_launch_items_.size();
+        stats.system_tray_items = system_tray_items_.size();
+        stats.minimized_windows = minimized_windows_.size();
+        
+        if (status_monitor_) {
+            SystemStatusStats status = status_monitor_->getStats();
+            stats.status_ticks = status.tick_count;
+            stats.status_total_cpu_ns = status.total_cpu_ns;
+            stats.status_max_tick_cpu_ns = status.max_tick_cpu_ns;
+        }
+        
+        if (config_persister_) {
+            stats.config_writes = config_persister_->getWriteCount();
+            stats.config_coalesced = config_persister_->getCoalescedCount();
+        }
+        
+        stats.snapshot_commands = snapshot_commands_;
+        stats.notifications = notifications_->getStats();
+        return stats;
+    }
+
+private:
+    /**
+     * @brief 回放启动快照，并把快照中的显示列表作为主输出的缓存
+     * 
+     * 实时数据就绪后的刷新按组件输入哈希对账：与快照一致的组件不重新录制，
+     * 以changed=false交给渲染器复用。任务栏尺寸与录制时不同时布局已失效，不回放
+     */
+    void renderStartupSnapshot() {
+        if (snapshot_path_.empty()) return;
+        
+        StartupSnapshot snapshot;
+        std::string error;
+        if (!StartupSnapshot::read(snapshot_path_, snapshot, error)) {
+            last_error_ = error;
+            return;
+        }
+        if (renderer_->getTaskbarSize(snapshot.appearance) != std::make_pair(snapshot.width, snapshot.height)) {
+            return;
+        }
+        
+        for (auto& component : snapshot.components) {
+            DisplayListCache::Entry& entry = display_lists_.entries[static_cast<size_t>(component.component)];
+            entry.list = std::move(component.list);
+            entry.input_hash = component.input_hash;
+            entry.valid = true;
+            if (!renderer_->renderDisplayList(component.component, entry.list, true, snapshot.appearance)) {
+                entry.list.replay(*renderer_, snapshot.appearance);
+            }
+            snapshot_commands_ += entry.list.size();
+        }
+        
+        if (snapshot.appearance.show_clock) {
+            ClockTextCache clock(snapshot.clock_format);
+            clock.update(std::chrono::system_clock::now());
+            renderer_->renderClockText(clock.text(), snapshot.clock_format, snapshot.appearance);
+        }
+    }
+    
+    void createDefaultQuickLaunchItems() {
+        // 文件管理器
+        QuickLaunchItem file_manager;
+        file_manager.id = "file_manager";
+        file_manager.name = "文件管理器";
+        file_manager.icon_path = "/usr/share/icons/file-manager.png";
+        file_manager.executable_path = "/usr/bin/cloudflow-file-manager";
+        quick_launch_items_.push_back(file_manager);
+        
+        // 浏览器
+        QuickLaunchItem browser;
+        browser.id = "browser";
+        browser.name = "浏览器";
+        browser.icon_path = "/usr/share/icons/browser.png";
         browser.executable_path = "/usr/bin/cloudflow-browser";
         quick_launch_items_.push_back(browser);
         
@@ -472,6 +1334,7 @@ private:
         network.icon_path = "/usr/share/icons/network.png";
         network.tooltip = "网络连接状态";
         system_tray_items_.push_back(network);
+        registerTrayItem(network);
         
         // 音量控制
         SystemTrayItem volume;
@@ -480,183 +1343,1387 @@ private:
         volume.icon_path = "/usr/share/icons/volume.png";
         volume.tooltip = "音量控制";
         system_tray_items_.push_back(volume);
+        registerTrayItem(volume);
+        
+        // 电池状态
+        SystemTrayItem battery;
+        battery.id = "battery";
+        battery.name = "电池";
+        battery.icon_path = "/usr/share/icons/battery.png";
+        battery.tooltip = "电池状态";
+        system_tray_items_.push_back(battery);
+        registerTrayItem(battery);
+        
+        // CPU占用
+        SystemTrayItem cpu;
+        cpu.id = "cpu";
+        cpu.name = "CPU";
+        cpu.icon_path = "/usr/share/icons/cpu.png";
+        cpu.tooltip = "CPU占用";
+        system_tray_items_.push_back(cpu);
+        registerTrayItem(cpu);
+        
+        // 通知中心
+        SystemTrayItem notifications;
+        notifications.id = kNotificationTrayId;
+        notifications.name = "通知";
+        notifications.icon_path = "/usr/share/icons/notifications.png";
+        notifications.tooltip = "没有新通知";
+        system_tray_items_.push_back(notifications);
+        registerTrayItem(notifications);
+    }
+    
+    void toggleNotificationPanel() {
+        notification_panel_open_ = !notification_panel_open_;
+        if (notification_panel_open_) {
+            // 打开面板即视为已读，托盘项在下一帧更新
+            notifications_->markAllRead();
+            renderer_->renderNotifications(notifications_->snapshot(), appearance_);
+        } else {
+            renderer_->hideNotifications(appearance_);
+        }
+    }
+    
+    void publishNotifications() {
+        auto it = std::find_if(system_tray_items_.begin(), system_tray_items_.end(),
+                               [](const SystemTrayItem& item) { return item.id == kNotificationTrayId; });
+        if (it != system_tray_items_.end()) {
+            SystemTrayItem item = *it;
+            size_t unread = notifications_->unreadCount();
+            item.tooltip = unread ? std::to_string(unread) + "条未读通知" : "没有新通知";
+            item.active = unread > 0;
+            updateSystemTrayItem(item);
+        }
+        
+        if (notification_panel_open_ && is_visible_ && renderer_) {
+            renderer_->renderNotifications(notifications_->snapshot(), appearance_);
+        }
+    }
+    
+    void startStatusMonitor() {
+        if (status_monitor_) return;
+        
+        auto sink = [this](const SystemTrayItem& item) { updateSystemTrayItem(item); };
+        auto findItem = [this](const std::string& id) {
+            auto it = std::find_if(system_tray_items_.begin(), system_tray_items_.end(),
+                                   [&id](const SystemTrayItem& item) { return item.id == id; });
+            return it != system_tray_items_.end() ? *it : SystemTrayItem();
+        };
+        
+        // 网络、CPU、音量和电池共享同一个定时线程，网络和CPU同时记录工具提示中的历史曲线
+        tray_histories_["network"] = std::make_shared<SparklineHistory>();
+        tray_histories_["cpu"] = std::make_shared<SparklineHistory>();
+        volume_provider_ = std::make_shared<VolumeStatusProvider>(findItem("volume"), sink);
+        status_monitor_ = std::make_unique<SystemStatusMonitor>();
+        status_monitor_->addProvider(std::make_shared<NetworkStatusProvider>(findItem("network"), sink,
+                                                                             tray_histories_["network"]));
+        status_monitor_->addProvider(std::make_shared<CpuStatusProvider>(findItem("cpu"), sink,
+                                                                         tray_histories_["cpu"]));
+        status_monitor_->addProvider(volume_provider_);
+        status_monitor_->addProvider(std::make_shared<BatteryStatusProvider>(findItem("battery"), sink));
+        
+        // 窗口进程的告警变化经叠加层通道合并到下一帧
+        usage_provider_ = std::make_shared<ProcessUsageProvider>(
+            [this](const std::string& window_id, const ProcessUsage& usage) {
+                uint8_t alert = usage.alert;
+                updateWindowOverlay(window_id, [alert](WindowOverlay& overlay) { overlay.usage_alert = alert; });
+            });
+        for (const auto& entry : window_pids_) {
+            usage_provider_->trackWindow(entry.first, entry.second);
+        }
+        status_monitor_->addProvider(usage_provider_);
+        status_monitor_->start();
+    }
+    
+    void startClockThread() {
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            if (clock_running_) return;
+            clock_running_ = true;
+        }
+        
+        clock_thread_ = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(clock_mutex_);
+            while (clock_running_) {
+                // 睡眠到时间或日期文本的下一个进位时刻，而不是每秒轮询；
+                // 被限速推迟的托盘更新截止时间更早时提前醒来请求一帧
+                clock_text_.update(std::chrono::system_clock::now());
+                auto boundary = clock_text_.nextBoundary();
+                auto wake = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        boundary - std::chrono::system_clock::now());
+                bool has_tray_deadline = tray_deadline_ != std::chrono::steady_clock::time_point();
+                if (has_tray_deadline && tray_deadline_ < wake) {
+                    wake = tray_deadline_;
+                }
+                
+                // 不带谓词等待：截止时间被提前时会被唤醒，回到循环开头重新计算
+                clock_cv_.wait_until(lock, wake);
+                if (!clock_running_) break;
+                
+                bool tray_due = tray_deadline_ != std::chrono::steady_clock::time_point() &&
+                                std::chrono::steady_clock::now() >= tray_deadline_;
+                if (tray_due) {
+                    tray_deadline_ = std::chrono::steady_clock::time_point();
+                }
+                bool clock_due = std::chrono::system_clock::now() >= boundary;
+                if (!tray_due && !clock_due) continue;
+                
+                lock.unlock();
+                if (tray_due) requestFrame();
+                if (clock_due) tickClock();
+                lock.lock();
+            }
+        });
+    }
+    
+    void configureAutoHide() {
+        AutoHideConfig config = auto_hide_.config();
+        config.screen_width = screen_width_;
+        config.screen_height = screen_height_;
+        config.position = appearance_.position;
+        if (renderer_) {
+            auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+            bool vertical = (appearance_.position == TaskbarPosition::Left ||
+                             appearance_.position == TaskbarPosition::Right);
+            config.thickness = vertical ? taskbar_size.first : taskbar_size.second;
+        }
+        auto_hide_.configure(config);
+    }
+    
+    /**
+     * @struct OutputView
+     * @brief 附加输出视图（外观与渲染器独立，模型与主输出共享）
+     */
+    struct OutputView {
+        std::string id;
+        std::shared_ptr<ITaskbarRenderer> renderer;
+        TaskbarAppearance appearance;
+        DisplayListCache display_lists;
+    };
+    
+    std::vector<OutputView>::iterator findOutput(const std::string& output_id) {
+        return std::find_if(outputs_.begin(), outputs_.end(),
+                            [&output_id](const OutputView& output) { return output.id == output_id; });
+    }
+    
+    void renderOutputWithClock(OutputView& output) {
+        renderOutput(*output.renderer, output.appearance, output.display_lists);
+        if (output.appearance.show_clock) {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            clock_text_.update(std::chrono::system_clock::now());
+            output.renderer->renderClockText(clock_text_.text(), clock_format_, output.appearance);
+        }
+    }
+    
+    void updateAutoHide(std::chrono::steady_clock::time_point now) {
+        bool more = auto_hide_.advance(now);
+        applyAutoHideState();
+        if (more) {
+            requestFrame();
+        }
+    }
+    
+    void applyAutoHideState() {
+        // 开始滑入时完整重绘一次，动画过程中只更新偏移量
+        // 宿主调用hide()之后自动隐藏不能把任务栏重新滑入
+        bool hidden = auto_hide_.isHidden();
+        if (!hidden && !is_visible_ && shown_) {
+            is_visible_ = true;
+            refresh();
+        }
+        
+        int offset = auto_hide_.offset();
+        if (renderer_ && offset != taskbar_offset_) {
+            taskbar_offset_ = offset;
+            renderer_->setTaskbarOffset(offset, appearance_);
+        }
+        
+        if (hidden && is_visible_) {
+            is_visible_ = false;
+        }
+    }
+    
+    void stopClockThread() {
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            clock_running_ = false;
+        }
+        clock_cv_.notify_all();
+        if (clock_thread_.joinable()) {
+            clock_thread_.join();
+        }
+    }
+    
+    void renderClock() {
+        // 文本与格式在同一次加锁中复制，渲染时不持有时钟锁
+        ClockText text;
+        ClockFormat format;
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            clock_text_.update(std::chrono::system_clock::now());
+            text = clock_text_.text();
+            format = clock_format_;
+        }
+        
+        forEachOutput([&text, &format](ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) {
+            if (appearance.show_clock) {
+                renderer.renderClockText(text, format, appearance);
+            }
+        });
+    }
+    
+    /**
+     * @brief 依次对主输出和附加输出调用fn(renderer, appearance)
+     */
+    template <typename Fn>
+    void forEachOutput(Fn&& fn) {
+        if (renderer_) {
+            fn(*renderer_, appearance_);
+        }
+        for (const auto& output : outputs_) {
+            fn(*output.renderer, output.appearance);
+        }
+    }
+    
+    void renderOutput(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance, DisplayListCache& cache) {
+        InputHasher appearance_hash;
+        appearance_hash.add(static_cast<uint64_t>(appearance.position))
+                       .add(static_cast<uint64_t>(appearance.style))
+                       .add(static_cast<uint64_t>(appearance.height))
+                       .add(appearance.auto_hide)
+                       .add(appearance.always_on_top)
+                       .add(appearance.show_clock)
+                       .add(appearance.show_system_tray)
+                       .add(appearance.group_windows);
+        
+        // 渲染任务栏背景
+        renderComponent(TaskbarComponent::Background, appearance_hash, renderer, appearance, cache,
+                        [&](ITaskbarRenderer& target) { target.renderBackground(appearance); });
+        
+        // 渲染开始菜单按钮
+        InputHasher start_hash = appearance_hash;
+        start_hash.add(is_start_menu_active_);
+        renderComponent(TaskbarComponent::StartMenu, start_hash, renderer, appearance, cache,
+                        [&](ITaskbarRenderer& target) { target.renderStartMenuButton(appearance, is_start_menu_active_); });
+        
+        // 渲染快速启动项
+        InputHasher quick_launch_hash = appearance_hash;
+        for (const auto& item : quick_launch_items_) {
+            quick_launch_hash.add(item.id).add(item.name).add(item.icon_path).add(item.executable_path)
+                             .add(static_cast<uint64_t>(item.launch_count)).add(item.visible);
+            for (const auto& argument : item.arguments) {
+                quick_launch_hash.add(argument);
+            }
+        }
+        renderComponent(TaskbarComponent::QuickLaunch, quick_launch_hash, renderer, appearance, cache,
+                        [&](ITaskbarRenderer& target) {
+                            for (const auto& item : quick_launch_items_) {
+                                if (item.visible) {
+                                    target.renderQuickLaunchItem(item, appearance);
+                                }
+                            }
+                        });
+        
+        // 渲染窗口列表：只对可见范围内的项计算输入散列和录制，开销与窗口总数无关
+        WindowListViewport viewport = windowListViewport(renderer, appearance);
+        InputHasher window_hash = appearance_hash;
+        window_hash.add(active_window_id_).add(static_cast<uint64_t>(viewport.first))
+                   .add(static_cast<uint64_t>(viewport.visible)).add(static_cast<uint64_t>(viewport.total));
+        for (size_t i = viewport.first; i < viewport.first + viewport.visible; ++i) {
+            if (appearance.group_windows) {
+                const WindowGroup& group = window_groups_.at(group_order_[i]);
+                window_hash.add(group_order_[i]).add(static_cast<uint64_t>(group.current_index))
+                           .add(window_list_.at(group.window_ids[group.current_index]));
+                for (const auto& window_id : group.window_ids) {
+                    window_hash.add(window_id).add(minimized_windows_.count(window_id) > 0);
+                }
+            } else {
+                const auto& window = *window_order_[i];
+                window_hash.add(window.first).add(window.second)
+                           .add(minimized_windows_.count(window.first) > 0);
+            }
+        }
+        renderComponent(TaskbarComponent::WindowList, window_hash, renderer, appearance, cache,
+                        [&](ITaskbarRenderer& target) { renderWindowList(target, appearance, viewport); });
+        
+        // 叠加层更新频繁，不进入显示列表，在列表项之后直接绘制
+        renderWindowOverlays(renderer, appearance, viewport);
+        
+        // 键盘焦点高亮同样不进入显示列表
+        if (keyboard_focused_) {
+            renderer.renderKeyboardFocus(keyboardFocusItem(), appearance);
+        }
+        
+        // 渲染系统托盘项
+        InputHasher tray_hash = appearance_hash;
+        for (const auto& item : system_tray_items_) {
+            tray_hash.add(item.id).add(item.name).add(item.icon_path).add(item.tooltip)
+                     .add(item.visible).add(item.active);
+        }
+        renderComponent(TaskbarComponent::SystemTray, tray_hash, renderer, appearance, cache,
+                        [&](ITaskbarRenderer& target) {
+                            if (!appearance.show_system_tray) return;
+                            for (const auto& item : system_tray_items_) {
+                                if (item.visible) {
+                                    target.renderSystemTrayItem(item, appearance);
+                                }
+                            }
+                        });
+    }
+    
+    /**
+     * @brief 渲染单个组件：输入哈希变化时重新录制显示列表，否则复用缓存的列表
+     */
+    template <typename RecordFn>
+    void renderComponent(TaskbarComponent component, const InputHasher& input_hash,
+                         ITaskbarRenderer& renderer, const TaskbarAppearance& appearance,
+                         DisplayListCache& cache, RecordFn&& record) {
+        DisplayListCache::Entry& entry = cache.entries[static_cast<size_t>(component)];
+        bool changed = !entry.valid || entry.input_hash != input_hash.value();
+        if (changed) {
+            entry.list.clear();
+            DisplayListRecorder recorder(entry.list);
+            record(recorder);
+            entry.input_hash = input_hash.value();
+            entry.valid = true;
+            display_list_records_metric_->increment();
+        } else {
+            display_list_hits_metric_->increment();
+        }
+        
+        if (!renderer.renderDisplayList(component, entry.list, changed, appearance)) {
+            entry.list.replay(renderer, appearance);
+        }
+    }
+    
+    void updateClockVisibility() {
+        bool shown = appearance_.show_clock;
+        for (const auto& output : outputs_) {
+            shown = shown || output.appearance.show_clock;
+        }
+        clock_shown_ = shown;
+    }
+    
+    bool isStartMenuButtonClicked(int x, int y) const {
+        // 简化实现：假设开始菜单按钮在任务栏最左侧
+        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+        return (x >= 0 && x <= 40 && y >= 0 && y <= taskbar_size.second);
+    }
+    
+    bool isQuickLaunchItemClicked(int x, int y) const {
+        // 简化实现：快速启动栏在开始菜单按钮右侧
+        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+        return (x >= 50 && x <= 200 && y >= 0 && y <= taskbar_size.second);
+    }
+    
+    bool isWindowListItemClicked(int x, int y) const {
+        // 简化实现：窗口列表在快速启动栏右侧
+        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+        return (x >= kWindowListLeft && x <= taskbar_size.first - kWindowListRightReserve &&
+                y >= 0 && y <= taskbar_size.second);
+    }
+    
+    bool isSystemTrayItemClicked(int x, int y) const {
+        // 简化实现：系统托盘在时钟左侧
+        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+        return (x >= taskbar_size.first - kWindowListRightReserve && x <= taskbar_size.first - kTrayRightReserve &&
+                y >= 0 && y <= taskbar_size.second);
+    }
+    
+    bool isClockClicked(int x, int y) const {
+        // 简化实现：时钟在任务栏最右侧
+        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
+        return (x >= taskbar_size.first - 40 && x <= taskbar_size.first && y >= 0 && y <= taskbar_size.second);
+    }
+    
+    void handleStartMenuClick(int button) {
+        if (button == 1) { // 左键
+            toggleStartMenu();
+        } else if (button == 2) { // 右键
+            // 显示开始菜单上下文菜单
+            TaskbarEvent event(TaskbarEvent::Type::StartMenuClicked);
+            notifyEventListeners(event);
+        }
+    }
+    
+    void handleQuickLaunchItemClick(int x, int y, int button) {
+        if (button == 1) { // 左键
+            // 查找点击的快速启动项
+            // 简化实现：假设每个快速启动项宽度为40像素
+            int item_index = (x - 50) / 40;
+            if (item_index >= 0 && item_index < static_cast<int>(quick_launch_items_.size())) {
+                const auto& item = quick_launch_items_[item_index];
+                
+                // 增加启动计数并更新频度排序
+                quick_launch_items_[item_index].launch_count++;
+                frecency_.recordLaunch(item.id);
+                scheduleConfigSave();
+                
+                if (!item.executable_path.empty()) {
+                    launchApplication(item.executable_path, item.arguments);
+                }
+                
+                TaskbarEvent event(TaskbarEvent::Type::QuickLaunchItemClicked);
+                event.item_id = item.id;
+                notifyEventListeners(event);
+            }
+        } else if (button == 2) { // 右键
+            int item_index = (x - 50) / 40;
+            if (item_index >= 0 && item_index < static_cast<int>(quick_launch_items_.size())) {
+                const auto& item = quick_launch_items_[item_index];
+                showJumpList(item.executable_path.empty() ? item.id : item.executable_path, item.id);
+            }
+        }
+    }
+    
+    /**
+     * @brief 显示跳转列表，只读取内存中的最近文档列表
+     * @param app_id 应用标识（可执行文件路径或desktop文件ID）
+     * @param fallback_id 按app_id查不到时使用的备用标识
+     */
+    void showJumpList(const std::string& app_id, const std::string& fallback_id) {
+        if (!renderer_) return;
+        
+        auto documents = getRecentDocuments(app_id);
+        if (!documents && !fallback_id.empty()) {
+            documents = getRecentDocuments(fallback_id);
+        }
+        
+        static const RecentDocumentList kEmpty;
+        renderer_->showJumpList(app_id, documents ? *documents : kEmpty, appearance_);
+    }
+    
+    /**
+     * @brief 激活指定下标的窗口列表项
+     * 
+     * 直接交给窗口管理器激活，不重绘任务栏；激活状态由窗口管理器通过
+     * setWindowActive()回报后再重绘。没有窗口控制器时退化为与点击相同的WindowRestored事件
+     */
+    void activateWindowListItem(size_t index) {
+        if (index >= windowListItemCount(appearance_)) return;
+        
+        std::string window_id = appearance_.group_windows
+            ? cycleWindowGroup(window_groups_[group_order_[index]])
+            : window_order_[index]->first;
+        
+        if (window_controller_ && window_controller_->activateWindow(window_id)) {
+            return;
+        }
+        
+        TaskbarEvent event(TaskbarEvent::Type::WindowRestored);
+        event.item_id = window_id;
+        notifyEventListeners(event);
+    }
+    
+    /**
+     * @brief 方向键、Enter和空格只在任务栏拥有键盘焦点且开始菜单关闭时处理
+     */
+    bool keyboardNavigationActive() const {
+        return keyboard_focused_ && !is_start_menu_active_;
+    }
+    
+    /**
+     * @brief 将键盘焦点移到相邻的窗口列表项（首尾循环），只移动高亮，不激活窗口
+     * @param step -1为上一项，1为下一项
+     */
+    void moveKeyboardFocus(int step) {
+        int count = static_cast<int>(windowListItemCount(appearance_));
+        if (count == 0) return;
+        
+        if (keyboard_focus_index_ < 0 || keyboard_focus_index_ >= count) {
+            keyboard_focus_index_ = (step > 0) ? 0 : count - 1;
+        } else {
+            keyboard_focus_index_ = (keyboard_focus_index_ + step + count) % count;
+        }
+        updateKeyboardFocus();
+    }
+    
+    /**
+     * @brief 获取键盘焦点所在列表项的窗口ID
+     * @return 窗口ID，没有焦点时为空
+     */
+    std::string keyboardFocusItem() const {
+        if (!keyboard_focused_) return "";
+        return windowIdAtListIndex(keyboard_focus_index_);
+    }
+    
+    /**
+     * @brief 更新键盘焦点高亮：焦点项需要滚动才可见时整体重绘，否则只重绘高亮
+     */
+    void updateKeyboardFocus() {
+        if (!is_visible_ || !renderer_) return;
+        
+        std::string item_id = keyboardFocusItem();
+        size_t scroll = window_list_scroll_;
+        revealWindow(item_id);
+        if (window_list_scroll_ != scroll) {
+            refresh();
+            return;
+        }
+        forEachOutput([&](ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) {
+            renderer.renderKeyboardFocus(item_id, appearance);
+        });
+    }
+    
+    void handleWindowListItemClick(int x, int y, int button) {
+        if (button == 1) { // 左键
+            // 查找点击的窗口列表项（命中位置经过滚动偏移映射）
+            int item_index = windowListIndexAt(x);
+            if (item_index < 0) return;
+            
+            TaskbarEvent event(TaskbarEvent::Type::WindowRestored);
+            event.item_id = appearance_.group_windows
+                ? cycleWindowGroup(window_groups_[group_order_[item_index]])
+                : window_order_[item_index]->first;
+            notifyEventListeners(event);
+        } else if (button == 2) { // 右键
+            // 显示窗口所属应用的跳转列表（未分组窗口没有应用标识）
+            int item_index = windowListIndexAt(x);
+            if (item_index < 0) return;
+            
+            std::string app_id;
+            if (appearance_.group_windows) {
+                app_id = window_groups_[group_order_[item_index]].app_id;
+            } else {
+                auto key_it = window_group_keys_.find(window_order_[item_index]->first);
+                if (key_it != window_group_keys_.end()) {
+                    app_id = window_groups_[key_it->second].app_id;
+                }
+            }
+            if (!app_id.empty()) {
+                showJumpList(app_id, "");
+            }
+        }
+    }
+    
+    int trayIndexAt(int x) const {
+        int item_index = (x - (renderer_->getTaskbarSize(appearance_).first - kWindowListRightReserve)) / kTrayItemWidth;
+        return (item_index >= 0 && item_index < static_cast<int>(system_tray_items_.size())) ? item_index : -1;
+    }
+    
+    void updateTrayHover(int x, int y) {
+        if (!is_visible_ || !renderer_) return;
+        
+        std::string tray_id;
+        if (isSystemTrayItemClicked(x, y)) {
+            int index = trayIndexAt(x);
+            if (index >= 0 && system_tray_items_[index].visible) {
+                tray_id = system_tray_items_[index].id;
+            }
+        }
+        
+        if (tray_id == hovered_tray_id_) return;
+        hovered_tray_id_ = tray_id;
+        
+        if (tray_id.empty()) {
+            renderer_->hideTrayTooltip(appearance_);
+        } else {
+            showTrayTooltip();
+        }
+    }
+    
+    void showTrayTooltip() {
+        auto it = std::find_if(system_tray_items_.begin(), system_tray_items_.end(),
+                               [this](const SystemTrayItem& item) { return item.id == hovered_tray_id_; });
+        if (it == system_tray_items_.end()) return;
+        
+        // 曲线由采样线程增量维护，这里只复制预先计算好的点
+        Sparkline minute;
+        Sparkline ten_minutes;
+        auto history = tray_histories_.find(hovered_tray_id_);
+        if (history != tray_histories_.end()) {
+            history->second->copy(SparklineRange::Minute, minute);
+            history->second->copy(SparklineRange::TenMinutes, ten_minutes);
+        }
+        renderer_->renderTrayTooltip(*it, minute, ten_minutes, appearance_);
+    }
+    
+    void handleSystemTrayItemClick(int x, int y, int button) {
+        if (button == 1) { // 左键
+            // 查找点击的系统托盘项
+            int item_index = trayIndexAt(x);
+            if (item_index >= 0) {
+                const auto& item = system_tray_items_[item_index];
+                if (item.id == kNotificationTrayId) {
+                    toggleNotificationPanel();
+                }
+                
+                TaskbarEvent event(TaskbarEvent::Type::SystemTrayItemClicked);
+                event.item_id = item.id;
+                notifyEventListeners(event);
+            }
+        }
+    }
+    
+    void handleClockClick(int button) {
+        if (button == 1) { // 左键
+            toggleCalendar();
+            
+            TaskbarEvent event(TaskbarEvent::Type::ClockClicked);
+            notifyEventListeners(event);
+        }
+    }
+    
+    void renderCalendar() {
+        auto month = calendar_.getMonth(calendar_year_, calendar_month_);
+        if (!month || !renderer_) return;
+        
+        std::time_t now = std::time(nullptr);
+        std::tm local_time;
+        localtime_r(&now, &local_time);
+        int today_index = -1;
+        for (size_t i = 0; i < CalendarMonth::kDays; ++i) {
+            const CalendarDay& day = month->days[i];
+            if (day.year == local_time.tm_year + 1900 && day.month == local_time.tm_mon + 1 &&
+                day.day == local_time.tm_mday) {
+                today_index = static_cast<int>(i);
+                break;
+            }
+        }
+        renderer_->renderCalendar(*month, today_index, appearance_);
+    }
+    
+    void toggleStartMenu() {
+        is_start_menu_active_ = !is_start_menu_active_;
+        refresh();
+        
+        if (renderer_) {
+            if (is_start_menu_active_) {
+                renderStartMenu();
+            } else {
+                start_menu_snapshot_.reset();
+                renderer_->hideStartMenu(appearance_);
+            }
+        }
+        
+        TaskbarEvent event(TaskbarEvent::Type::StartMenuClicked);
+        notifyEventListeners(event);
+    }
+    
+    std::vector<std::string> collectVisibleWindows() const {
+        std::vector<std::string> visible_ids;
+        visible_ids.reserve(window_list_.size());
+        for (const auto& window : window_list_) {
+            if (!minimized_windows_.count(window.first)) {
+                visible_ids.push_back(window.first);
+            }
+        }
+        return visible_ids;
+    }
+    
+    /**
+     * @brief 以一次批量状态变更设置多个窗口的最小化状态（不刷新）
+     */
+    bool setWindowsMinimized(const std::vector<std::string>& window_ids, bool is_minimized) {
+        if (window_ids.empty()) return true;
+        
+        if (window_controller_ && !window_controller_->setWindowsMinimized(window_ids, is_minimized)) {
+            last_error_ = "批量设置窗口最小化状态失败";
+            return false;
+        }
+        
+        for (const auto& window_id : window_ids) {
+            markWindowMinimized(window_id, is_minimized);
+        }
+        return true;
+    }
+    
+    void endShowDesktop() {
+        desktop_shown_ = false;
+        desktop_restore_ids_.clear();
+    }
+    
+    void notifyEventListeners(const TaskbarEvent& event) {
+        for (const auto& listener : event_listeners_) {
+            listener(event);
+        }
+    }
+    
+    void renderStartMenu() {
+        if (!app_index_) return;
+        
+        // 只读取内存映射的索引快照，不访问文件系统
+        start_menu_snapshot_ = app_index_->snapshot();
+        if (!start_menu_snapshot_) return;
+        
+        const ApplicationIndexSnapshot& snapshot = *start_menu_snapshot_;
+        std::vector<ApplicationEntry> entries;
+        
+        if (!start_menu_query_.empty()) {
+            // 搜索结果的下标属于搜索数据所对应的快照，在其构建完成前显示空列表
+            auto search = currentSearch();
+            if (search) {
+                start_menu_snapshot_ = search->snapshot();
+                for (const auto& result : search->search(start_menu_query_, kStartMenuResultLimit)) {
+                    entries.push_back(start_menu_snapshot_->entry(result.index));
+                }
+            }
+            renderer_->renderStartMenu(entries, appearance_);
+            return;
+        }
+        
+        entries.reserve(snapshot.size());
+        std::vector<char> listed(snapshot.size(), 0);
+        
+        // 常用应用按启动频度排在前面，其余按名称排序
+        for (const auto& id : frecency_.getRanked()) {
+            int index = snapshot.find(id);
+            if (index >= 0) {
+                entries.push_back(snapshot.entry(index));
+                listed[index] = 1;
+            }
+        }
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            if (!listed[i]) {
+                entries.push_back(snapshot.entry(i));
+            }
+        }
+        
+        renderer_->renderStartMenu(entries, appearance_);
+    }
+    
+    void rebuildSearch(std::shared_ptr<const ApplicationIndexSnapshot> snapshot) {
+        if (!snapshot) return;
+        
+        // 拼音与位图等搜索数据在索引快照变化时于调用线程中计算，完成后整体替换，
+        // 面板线程只读取已构建好的实例；构建串行进行，较新的快照总是最后替换
+        std::lock_guard<std::mutex> build_lock(search_build_mutex_);
+        std::shared_ptr<const PinyinTable> pinyin;
+        {
+            std::lock_guard<std::mutex> lock(search_mutex_);
+            if (app_search_ && app_search_->snapshot() == snapshot && app_search_pinyin_ == pinyin_) return;
+            pinyin = pinyin_;
+        }
+        
+        auto search = std::make_shared<ApplicationSearch>(pinyin);
+        search->build(snapshot);
+        
+        std::lock_guard<std::mutex> lock(search_mutex_);
+        app_search_ = search;
+        app_search_pinyin_ = pinyin;
+    }
+    
+    std::shared_ptr<const ApplicationSearch> currentSearch() const {
+        std::lock_guard<std::mutex> lock(search_mutex_);
+        return app_search_;
+    }
+    
+    static bool sameTrayState(const SystemTrayItem& a, const SystemTrayItem& b) {
+        return a.name == b.name && a.icon_path == b.icon_path && a.tooltip == b.tooltip &&
+               a.visible == b.visible && a.active == b.active;
+    }
+    
+    void updateWindowOverlay(const std::string& window_id, const std::function<void(WindowOverlay&)>& update) {
+        {
+            std::lock_guard<std::mutex> lock(overlay_mutex_);
+            // 叠加层条目随窗口加入和移除，不在窗口列表中的窗口直接忽略
+            auto it = window_overlays_.find(window_id);
+            if (it == window_overlays_.end()) return;
+            
+            OverlayUpdateState& state = it->second;
+            WindowOverlay overlay = state.latest;
+            update(overlay);
+            if (overlay == state.latest) return;
+            
+            state.latest = overlay;
+            if (!state.dirty) {
+                state.dirty = true;
+                dirty_overlay_ids_.push_back(window_id);
+            }
+        }
+        requestFrame();
+    }
+    
+    void commitOverlayUpdates() {
+        std::unordered_set<std::string> changed;
+        {
+            std::lock_guard<std::mutex> lock(overlay_mutex_);
+            for (const auto& window_id : dirty_overlay_ids_) {
+                auto it = window_overlays_.find(window_id);
+                if (it == window_overlays_.end()) continue;
+                it->second.committed = it->second.latest;
+                it->second.dirty = false;
+                changed.insert(window_id);
+            }
+            dirty_overlay_ids_.clear();
+        }
+        if (changed.empty() || !is_visible_) return;
+        
+        // 只检查各输出可见范围内的项
+        forEachOutput([&](ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) {
+            WindowListViewport viewport = windowListViewport(renderer, appearance);
+            std::lock_guard<std::mutex> lock(overlay_mutex_);
+            for (size_t i = viewport.first; i < viewport.first + viewport.visible; ++i) {
+                bool affected = false;
+                if (appearance.group_windows) {
+                    for (const auto& window_id : window_groups_.at(group_order_[i]).window_ids) {
+                        affected = affected || changed.count(window_id) > 0;
+                    }
+                } else {
+                    affected = changed.count(window_order_[i]->first) > 0;
+                }
+                if (!affected) continue;
+                
+                // 清除的叠加层也要通知渲染器
+                std::string item_id;
+                WindowOverlay overlay;
+                listItemOverlay(appearance, i, item_id, overlay);
+                renderer.renderWindowOverlay(item_id, overlay, appearance);
+            }
+        });
+    }
+    
+    void renderWindowOverlays(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance,
+                              const WindowListViewport& viewport) {
+        std::lock_guard<std::mutex> lock(overlay_mutex_);
+        if (window_overlays_.empty()) return;
+        
+        for (size_t i = viewport.first; i < viewport.first + viewport.visible; ++i) {
+            std::string item_id;
+            WindowOverlay overlay;
+            if (listItemOverlay(appearance, i, item_id, overlay)) {
+                renderer.renderWindowOverlay(item_id, overlay, appearance);
+            }
+        }
+    }
+    
+    /**
+     * @brief 获取窗口列表项的已提交叠加层（需持有overlay_mutex_）
+     * 
+     * 分组项合并组内各窗口：徽标求和，进度取平均，状态取最严重者
+     * @return 叠加层是否非空
+     */
+    bool listItemOverlay(const TaskbarAppearance& appearance, size_t index,
+                         std::string& item_id, WindowOverlay& overlay) const {
+        if (!appearance.group_windows) {
+            item_id = window_order_[index]->first;
+            auto it = window_overlays_.find(item_id);
+            if (it != window_overlays_.end()) {
+                overlay = it->second.committed;
+            }
+            return !overlay.empty();
+        }
         
-        // 电池状态
-        SystemTrayItem battery;
-        battery.id = "battery";
-        battery.name = "电池";
-        battery.icon_path = "/usr/share/icons/battery.png";
-        battery.tooltip = "电池状态";
-        system_tray_items_.push_back(battery);
+        const WindowGroup& group = window_groups_.at(group_order_[index]);
+        item_id = group.window_ids[group.current_index];
+        uint32_t progress_sum = 0;
+        uint32_t progress_count = 0;
+        for (const auto& window_id : group.window_ids) {
+            auto it = window_overlays_.find(window_id);
+            if (it == window_overlays_.end()) continue;
+            
+            const WindowOverlay& member = it->second.committed;
+            overlay.badge += member.badge;
+            overlay.usage_alert |= member.usage_alert;
+            overlay.progress_state = std::max(overlay.progress_state, member.progress_state);
+            if (member.progress_state != WindowOverlay::ProgressState::None &&
+                member.progress_state != WindowOverlay::ProgressState::Indeterminate) {
+                progress_sum += member.progress;
+                progress_count++;
+            }
+        }
+        overlay.progress = static_cast<uint16_t>(progress_count ? progress_sum / progress_count : 0);
+        return !overlay.empty();
     }
     
-    void startClockThread() {
-        clock_thread_ = std::thread([this]() {
-            while (true) {
-                current_time_ = std::chrono::system_clock::now();
+    void registerTrayItem(const SystemTrayItem& item) {
+        std::lock_guard<std::mutex> lock(tray_mutex_);
+        TrayUpdateState& state = tray_updates_[item.id];
+        state.latest = item;
+    }
+    
+    void commitTrayUpdates() {
+        std::vector<std::string> dirty;
+        std::vector<SystemTrayItem> committed;
+        bool deferred = false;
+        std::chrono::steady_clock::time_point next_deadline;
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(tray_mutex_);
+            dirty.swap(dirty_tray_ids_);
+            for (const auto& id : dirty) {
+                auto it = tray_updates_.find(id);
+                if (it == tray_updates_.end()) continue;
                 
-                if (is_visible_ && appearance_.show_clock) {
-                    refresh();
+                // 未到该项的最小更新间隔时推迟到间隔结束，届时提交最新状态
+                TrayUpdateState& state = it->second;
+                if (now - state.last_commit < state.min_interval) {
+                    auto deadline = state.last_commit + state.min_interval;
+                    if (!deferred || deadline < next_deadline) {
+                        next_deadline = deadline;
+                    }
+                    dirty_tray_ids_.push_back(id);
+                    deferred = true;
+                    continue;
                 }
                 
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+                state.committed_version = state.version;
+                state.last_commit = now;
+                committed.push_back(state.latest);
             }
-        });
-        clock_thread_.detach();
+        }
+        if (deferred) {
+            scheduleTrayDeadline(next_deadline);
+        }
+        
+        bool needs_refresh = false;
+        std::vector<const SystemTrayItem*> changed;
+        for (const auto& item : committed) {
+            auto it = std::find_if(system_tray_items_.begin(), system_tray_items_.end(),
+                                  [&item](const SystemTrayItem& existing) {
+                                      return existing.id == item.id;
+                                  });
+            if (it == system_tray_items_.end()) continue;
+            
+            // 可见性变化会影响布局，需要整体刷新
+            needs_refresh = needs_refresh || (it->visible != item.visible);
+            *it = item;
+            changed.push_back(&*it);
+        }
+        
+        // 悬停项的工具提示随状态更新，同时带上最新的历史曲线
+        if (!hovered_tray_id_.empty() && is_visible_ && renderer_ &&
+            std::any_of(committed.begin(), committed.end(),
+                        [this](const SystemTrayItem& item) { return item.id == hovered_tray_id_; })) {
+            showTrayTooltip();
+        }
+        
+        if (needs_refresh) {
+            refresh();
+        } else if (is_visible_) {
+            forEachOutput([&changed](ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) {
+                if (!appearance.show_system_tray) return;
+                for (const SystemTrayItem* item : changed) {
+                    if (item->visible) {
+                        renderer.renderSystemTrayItem(*item, appearance);
+                    }
+                }
+            });
+        }
     }
     
-    bool isStartMenuButtonClicked(int x, int y) const {
-        // 简化实现：假设开始菜单按钮在任务栏最左侧
-        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-        return (x >= 0 && x <= 40 && y >= 0 && y <= taskbar_size.second);
+    TaskbarConfig snapshotConfig() const {
+        TaskbarConfig config;
+        config.appearance = appearance_;
+        config.quick_launch_items = quick_launch_items_;
+        config.frecency = frecency_.exportEntries();
+        config.clock_format = getClockFormat();
+        return config;
     }
     
-    bool isQuickLaunchItemClicked(int x, int y) const {
-        // 简化实现：快速启动栏在开始菜单按钮右侧
-        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-        return (x >= 50 && x <= 200 && y >= 0 && y <= taskbar_size.second);
+    void scheduleConfigSave() {
+        // 面板线程只复制快照，序列化和写盘在后台线程中合并进行
+        if (config_persister_ && !config_autosave_path_.empty()) {
+            config_persister_->schedule(config_autosave_path_, snapshotConfig());
+        }
     }
     
-    bool isWindowListItemClicked(int x, int y) const {
-        // 简化实现：窗口列表在快速启动栏右侧
-        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-        return (x >= 210 && x <= taskbar_size.first - 200 && y >= 0 && y <= taskbar_size.second);
+    /**
+     * @brief 在推迟的托盘更新到期时请求一帧（由时钟线程计时，期间不逐帧轮询）
+     * @param deadline 最早的到期时间
+     */
+    void scheduleTrayDeadline(std::chrono::steady_clock::time_point deadline) {
+        {
+            std::lock_guard<std::mutex> lock(clock_mutex_);
+            if (tray_deadline_ != std::chrono::steady_clock::time_point() && tray_deadline_ <= deadline) return;
+            tray_deadline_ = deadline;
+        }
+        clock_cv_.notify_all();
     }
     
-    bool isSystemTrayItemClicked(int x, int y) const {
-        // 简化实现：系统托盘在时钟左侧
-        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-        return (x >= taskbar_size.first - 150 && x <= taskbar_size.first - 50 && y >= 0 && y <= taskbar_size.second);
+    void requestFrame() {
+        // 同一帧内的多次请求只通知宿主一次
+        if (!frame_requested_.exchange(true) && frame_request_callback_) {
+            frame_request_callback_();
+        }
     }
     
-    bool isClockClicked(int x, int y) const {
-        // 简化实现：时钟在任务栏最右侧
-        auto taskbar_size = renderer_->getTaskbarSize(appearance_);
-        return (x >= taskbar_size.first - 40 && x <= taskbar_size.first && y >= 0 && y <= taskbar_size.second);
+    uint64_t contentGeneration(const std::string& window_id) const {
+        auto it = content_generations_.find(window_id);
+        return it != content_generations_.end() ? it->second : 0;
     }
     
-    void handleStartMenuClick(int button) {
-        if (button == 1) { // 左键
-            toggleStartMenu();
-        } else if (button == 2) { // 右键
-            // 显示开始菜单上下文菜单
-            TaskbarEvent event(TaskbarEvent::Type::StartMenuClicked);
-            notifyEventListeners(event);
+    std::string windowIdAtListIndex(int index) const {
+        if (appearance_.group_windows) {
+            if (index < 0 || index >= static_cast<int>(group_order_.size())) return "";
+            const WindowGroup& group = window_groups_.at(group_order_[index]);
+            return group.window_ids[group.current_index];
         }
+        
+        if (index < 0 || index >= static_cast<int>(window_order_.size())) return "";
+        return window_order_[index]->first;
     }
     
-    void handleQuickLaunchItemClick(int x, int y, int button) {
-        if (button == 1) { // 左键
-            // 查找点击的快速启动项
-            // 简化实现：假设每个快速启动项宽度为40像素
-            int item_index = (x - 50) / 40;
-            if (item_index >= 0 && item_index < static_cast<int>(quick_launch_items_.size())) {
-                const auto& item = quick_launch_items_[item_index];
-                
-                // 增加启动计数
-                quick_launch_items_[item_index].launch_count++;
-                total_launches_++;
-                
-                TaskbarEvent event(TaskbarEvent::Type::QuickLaunchItemClicked);
-                event.item_id = item.id;
-                notifyEventListeners(event);
-            }
+    /**
+     * @brief 查找窗口所在的窗口列表项下标（分组时为所在分组的下标）
+     * @return 项下标，窗口不在列表中返回-1
+     */
+    int windowListIndexOf(const std::string& window_id) const {
+        if (appearance_.group_windows) {
+            auto key_it = window_group_keys_.find(window_id);
+            if (key_it == window_group_keys_.end()) return -1;
+            return static_cast<int>(group_positions_.at(key_it->second));
         }
+        
+        auto it = window_positions_.find(window_id);
+        return it != window_positions_.end() ? static_cast<int>(it->second) : -1;
     }
     
-    void handleWindowListItemClick(int x, int y, int button) {
-        if (button == 1) { // 左键
-            // 查找点击的窗口列表项
-            // 简化实现：假设每个窗口列表项宽度为200像素
-            int item_index = (x - 210) / 200;
-            if (item_index >= 0 && item_index < static_cast<int>(window_list_.size())) {
-                auto it = window_list_.begin();
-                std::advance(it, item_index);
-                
-                TaskbarEvent event(TaskbarEvent::Type::WindowRestored);
-                event.item_id = it->first;
-                notifyEventListeners(event);
-            }
-        } else if (button == 2) { // 右键
-            // 显示窗口上下文菜单
+    /**
+     * @brief 更新window_order_中from及之后各项的下标索引
+     */
+    void reindexWindowOrder(size_t from) {
+        for (size_t i = from; i < window_order_.size(); ++i) {
+            window_positions_[window_order_[i]->first] = i;
         }
     }
     
-    void handleSystemTrayItemClick(int x, int y, int button) {
-        if (button == 1) { // 左键
-            // 查找点击的系统托盘项
-            // 简化实现：假设每个系统托盘项宽度为30像素
-            int item_index = (x - (renderer_->getTaskbarSize(appearance_).first - 150)) / 30;
-            if (item_index >= 0 && item_index < static_cast<int>(system_tray_items_.size())) {
-                const auto& item = system_tray_items_[item_index];
-                
-                TaskbarEvent event(TaskbarEvent::Type::SystemTrayItemClicked);
-                event.item_id = item.id;
-                notifyEventListeners(event);
+    size_t windowListItemCount(const TaskbarAppearance& appearance) const {
+        return appearance.group_windows ? group_order_.size() : window_order_.size();
+    }
+    
+    /**
+     * @brief 计算窗口列表在给定输出上的可见范围
+     * 
+     * 滚动偏移由所有输出共享，按各输出可容纳的项数分别钳制
+     */
+    WindowListViewport windowListViewport(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance) const {
+        WindowListViewport viewport;
+        viewport.total = windowListItemCount(appearance);
+        
+        int width = renderer.getTaskbarSize(appearance).first - kWindowListLeft - kWindowListRightReserve;
+        size_t capacity = static_cast<size_t>(std::max(1, width / kWindowListItemWidth));
+        viewport.first = std::min(window_list_scroll_, viewport.total > capacity ? viewport.total - capacity : 0);
+        viewport.visible = std::min(capacity, viewport.total - viewport.first);
+        return viewport;
+    }
+    
+    /**
+     * @brief 将主输出上的X坐标映射为窗口列表项下标
+     * @return 项下标，未命中任何可见项返回-1
+     */
+    int windowListIndexAt(int x) const {
+        if (x < kWindowListLeft) return -1;
+        
+        WindowListViewport viewport = windowListViewport(*renderer_, appearance_);
+        size_t slot = static_cast<size_t>((x - kWindowListLeft) / kWindowListItemWidth);
+        if (slot >= viewport.visible) return -1;
+        return static_cast<int>(viewport.first + slot);
+    }
+    
+    /**
+     * @brief 滚动窗口列表使指定窗口可见
+     */
+    void revealWindow(const std::string& window_id) {
+        if (!renderer_) return;
+        
+        int position = windowListIndexOf(window_id);
+        if (position < 0) return;
+        size_t index = static_cast<size_t>(position);
+        
+        WindowListViewport viewport = windowListViewport(*renderer_, appearance_);
+        if (index < viewport.first) {
+            window_list_scroll_ = index;
+        } else if (index >= viewport.first + viewport.visible) {
+            window_list_scroll_ = index + 1 - viewport.visible;
+        }
+    }
+    
+    void updateWindowHover(int x, int y) {
+        if (!is_visible_ || !renderer_) return;
+        
+        int index = -1;
+        std::string window_id;
+        if (isWindowListItemClicked(x, y)) {
+            index = windowListIndexAt(x);
+            window_id = windowIdAtListIndex(index);
+        }
+        
+        if (window_id == hovered_window_id_) return;
+        hovered_window_id_ = window_id;
+        
+        if (window_id.empty()) {
+            renderer_->hideWindowPreview(appearance_);
+            return;
+        }
+        
+        // 命中缓存直接显示，否则异步生成，完成后在下一帧显示
+        auto preview = preview_cache_.get(window_id, contentGeneration(window_id));
+        if (preview) {
+            renderer_->renderWindowPreview(*preview, appearance_);
+        } else {
+            preview_cache_.request(window_id, contentGeneration(window_id), false);
+        }
+        
+        // 预取相邻项的预览
+        for (int neighbor : {index - 1, index + 1}) {
+            std::string neighbor_id = windowIdAtListIndex(neighbor);
+            if (!neighbor_id.empty()) {
+                preview_cache_.request(neighbor_id, contentGeneration(neighbor_id), true);
             }
         }
     }
     
-    void handleClockClick(int button) {
-        if (button == 1) { // 左键
-            TaskbarEvent event(TaskbarEvent::Type::ClockClicked);
-            notifyEventListeners(event);
+    void renderWindowList(ITaskbarRenderer& renderer, const TaskbarAppearance& appearance,
+                          const WindowListViewport& viewport) {
+        // 溢出时先绘制滚动指示，再只绘制可见范围内的项
+        if (viewport.visible < viewport.total) {
+            renderer.renderWindowListOverflow(viewport, appearance);
+        }
+        size_t end = viewport.first + viewport.visible;
+        
+        if (!appearance.group_windows) {
+            for (size_t i = viewport.first; i < end; ++i) {
+                const auto& window = *window_order_[i];
+                bool is_active = (active_window_id_ == window.first);
+                bool is_minimized = (minimized_windows_.find(window.first) != minimized_windows_.end());
+                renderer.renderWindowListItem(window.first, window.second, is_active, is_minimized, appearance);
+            }
+            return;
+        }
+        
+        // 分组成员与计数在增删时已增量维护，这里只做O(1)查找
+        auto active_it = window_group_keys_.find(active_window_id_);
+        for (size_t i = viewport.first; i < end; ++i) {
+            const std::string& key = group_order_[i];
+            const WindowGroup& group = window_groups_.at(key);
+            bool is_active = (active_it != window_group_keys_.end() && active_it->second == key);
+            bool is_minimized = (group.minimized_count == group.window_ids.size());
+            const std::string& title = window_list_.at(group.window_ids[group.current_index]);
+            renderer.renderWindowGroupItem(group, title, is_active, is_minimized, appearance);
         }
     }
     
-    void toggleStartMenu() {
-        is_start_menu_active_ = !is_start_menu_active_;
-        refresh();
+    static std::string groupKeyFor(const std::string& window_id, const std::string& app_id) {
+        // 没有应用标识的窗口单独成组，加前缀避免与应用标识冲突
+        return app_id.empty() ? "window:" + window_id : "app:" + app_id;
+    }
+    
+    void addWindowToGroup(const std::string& window_id, const std::string& app_id) {
+        std::string key = groupKeyFor(window_id, app_id);
+        auto it = window_groups_.find(key);
+        if (it == window_groups_.end()) {
+            it = window_groups_.emplace(key, WindowGroup()).first;
+            it->second.app_id = app_id;
+            group_positions_[key] = group_order_.size();
+            group_order_.push_back(key);
+        }
         
-        TaskbarEvent event(TaskbarEvent::Type::StartMenuClicked);
-        notifyEventListeners(event);
+        it->second.window_ids.push_back(window_id);
+        if (minimized_windows_.count(window_id)) {
+            it->second.minimized_count++;
+        }
+        window_group_keys_[window_id] = key;
     }
     
-    void minimizeAllWindows() {
-        for (const auto& window : window_list_) {
-            minimized_windows_.insert(window.first);
+    void removeWindowFromGroup(const std::string& window_id) {
+        auto key_it = window_group_keys_.find(window_id);
+        if (key_it == window_group_keys_.end()) return;
+        
+        auto group_it = window_groups_.find(key_it->second);
+        WindowGroup& group = group_it->second;
+        auto pos = std::find(group.window_ids.begin(), group.window_ids.end(), window_id);
+        size_t index = static_cast<size_t>(pos - group.window_ids.begin());
+        group.window_ids.erase(pos);
+        if (minimized_windows_.count(window_id)) {
+            group.minimized_count--;
         }
-        refresh();
+        
+        if (group.window_ids.empty()) {
+            auto position = group_positions_.find(key_it->second);
+            size_t order_index = position->second;
+            group_positions_.erase(position);
+            group_order_.erase(group_order_.begin() + order_index);
+            for (size_t i = order_index; i < group_order_.size(); ++i) {
+                group_positions_[group_order_[i]] = i;
+            }
+            window_groups_.erase(group_it);
+        } else if (group.current_index > index || group.current_index >= group.window_ids.size()) {
+            group.current_index = (group.current_index == 0) ? 0 : group.current_index - 1;
+        }
+        
+        window_group_keys_.erase(key_it);
     }
     
-    void showDesktop() {
-        // 最小化所有窗口
-        minimizeAllWindows();
+    bool markWindowMinimized(const std::string& window_id, bool is_minimized) {
+        bool changed = is_minimized ? minimized_windows_.insert(window_id).second
+                                    : (minimized_windows_.erase(window_id) > 0);
+        if (!changed) return false;
         
-        // 取消开始菜单激活状态
-        is_start_menu_active_ = false;
-        refresh();
+        // 显示桌面期间有窗口被单独恢复时，再次切换改为重新最小化
+        if (!is_minimized && desktop_shown_) {
+            endShowDesktop();
+        }
+        
+        auto key_it = window_group_keys_.find(window_id);
+        if (key_it != window_group_keys_.end()) {
+            WindowGroup& group = window_groups_[key_it->second];
+            if (is_minimized) {
+                group.minimized_count++;
+            } else {
+                group.minimized_count--;
+            }
+        }
+        return true;
     }
     
-    void notifyEventListeners(const TaskbarEvent& event) {
-        for (const auto& listener : event_listeners_) {
-            listener(event);
+    std::string cycleWindowGroup(WindowGroup& group) {
+        // 当前窗口已激活时切换到组内下一个窗口，否则先恢复当前窗口
+        if (group.window_ids.size() > 1 && 
+            group.window_ids[group.current_index] == active_window_id_) {
+            group.current_index = (group.current_index + 1) % group.window_ids.size();
         }
+        return group.window_ids[group.current_index];
     }
 
 private:
     std::shared_ptr<ITaskbarRenderer> renderer_;
+    DisplayListCache display_lists_;
+    std::vector<OutputView> outputs_;
     std::vector<std::function<void(const TaskbarEvent&)>> event_listeners_;
     
     TaskbarAppearance appearance_;
     ClockFormat clock_format_;
     
     std::vector<QuickLaunchItem> quick_launch_items_;
+    FrecencyRanker frecency_;
     std::vector<SystemTrayItem> system_tray_items_;
+    
+    /**
+     * @brief 托盘项更新状态，version为最新状态版本，committed_version为已提交渲染的版本
+     */
+    struct TrayUpdateState {
+        SystemTrayItem latest;
+        uint64_t version = 0;
+        uint64_t committed_version = 0;
+        std::chrono::steady_clock::duration min_interval = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point last_commit;
+    };
+    std::mutex tray_mutex_;
+    std::unordered_map<std::string, TrayUpdateState> tray_updates_;
+    std::vector<std::string> dirty_tray_ids_;
+    
+    /**
+     * @brief 窗口叠加层更新状态，latest为最新值，committed为已提交渲染的值
+     */
+    struct OverlayUpdateState {
+        WindowOverlay latest;
+        WindowOverlay committed;
+        bool dirty = false;
+    };
+    mutable std::mutex overlay_mutex_;
+    std::unordered_map<std::string, OverlayUpdateState> window_overlays_;
+    std::vector<std::string> dirty_overlay_ids_;
+    
     std::map<std::string, std::string> window_list_;
+    using WindowListIterator = std::map<std::string, std::string>::const_iterator;
+    std::vector<WindowListIterator> window_order_;  ///< 按窗口ID排序，支持按下标O(1)访问
+    std::unordered_map<std::string, size_t> window_positions_;  ///< 窗口ID -> window_order_中的下标
     std::set<std::string> minimized_windows_;
+    std::unordered_map<std::string, WindowGroup> window_groups_;
+    std::unordered_map<std::string, std::string> window_group_keys_;
+    std::vector<std::string> group_order_;
+    std::unordered_map<std::string, size_t> group_positions_;   ///< 分组键 -> group_order_中的下标
     std::string active_window_id_;
+    bool keyboard_focused_;         ///< 任务栏是否拥有键盘焦点
+    int keyboard_focus_index_;      ///< 键盘焦点高亮的窗口列表项下标，没有焦点时为-1
+    size_t window_list_scroll_;     ///< 窗口列表第一个可见项的下标
+    
+    // 显示桌面（desktop_restore_ids_为显示桌面前可见的窗口）
+    std::shared_ptr<ITaskbarWindowController> window_controller_;
+    std::vector<std::string> desktop_restore_ids_;
+    bool desktop_shown_;
     
-    bool is_visible_;
+    bool shown_;                    ///< 宿主通过show()/hide()设置的显示状态
+    bool is_visible_;               ///< 实际是否显示（自动隐藏滑出时为false）
     bool is_start_menu_active_;
-    std::chrono::system_clock::time_point current_time_;
+    
+    // 自动隐藏
+    AutoHideController auto_hide_;
+    int screen_width_;
+    int screen_height_;
+    int taskbar_offset_;
+    
+    // 时钟（clock_mutex_保护格式、文本缓存和推迟的托盘更新截止时间）
+    mutable std::mutex clock_mutex_;
+    std::condition_variable clock_cv_;
+    ClockTextCache clock_text_;
+    std::chrono::steady_clock::time_point tray_deadline_;
     std::thread clock_thread_;
+    bool clock_running_;
+    std::atomic<bool> clock_dirty_;
+    std::atomic<bool> clock_shown_;
     
     std::string last_error_;
     
-    // 统计信息
-    int total_launches_;
-    int total_clicks_;
+    // 运行指标（带本实例的instance标签）
+    std::shared_ptr<Common::Counter> clicks_metric_;
+    std::shared_ptr<Common::Counter> launches_metric_;
+    std::shared_ptr<Common::Counter> refresh_metric_;
+    std::shared_ptr<Common::Histogram> refresh_duration_metric_;
+    std::shared_ptr<Common::Gauge> windows_metric_;
+    std::shared_ptr<Common::Counter> launch_failures_metric_;
+    std::shared_ptr<Common::Histogram> launch_spawn_metric_;
+    std::shared_ptr<Common::Histogram> launch_total_metric_;
+    std::shared_ptr<Common::Counter> display_list_hits_metric_;
+    std::shared_ptr<Common::Counter> display_list_records_metric_;
+    std::shared_ptr<Common::Histogram> show_desktop_duration_metric_;
+    std::shared_ptr<Common::Histogram> minimize_all_duration_metric_;
+    
+    // 应用启动辅助进程
+    LaunchHelper launch_helper_;
+    
+    // 帧调度
+    std::function<void()> frame_request_callback_;
+    std::atomic<bool> frame_requested_;
+    
+    // 开始菜单应用索引（监视线程会访问上述帧调度成员，因此在其后声明）
+    std::atomic<bool> start_menu_dirty_;
+    std::shared_ptr<const ApplicationIndexSnapshot> start_menu_snapshot_;
+    std::mutex search_build_mutex_;
+    mutable std::mutex search_mutex_;
+    std::shared_ptr<const PinyinTable> pinyin_;
+    std::shared_ptr<const PinyinTable> app_search_pinyin_;
+    std::shared_ptr<const ApplicationSearch> app_search_;
+    std::shared_ptr<ApplicationIndex> app_index_;
+    std::string start_menu_query_;
+    
+    // 跳转列表的最近文档
+    std::shared_ptr<RecentDocuments> recent_documents_;
+    
+    // 系统状态轮询（推送经由托盘更新通道，因此在托盘与帧调度成员之后声明）
+    std::shared_ptr<VolumeStatusProvider> volume_provider_;
+    
+    // 配置自动保存
+    std::unique_ptr<ConfigPersister> config_persister_;
+    std::string config_autosave_path_;
+    
+    // 启动快照
+    std::string snapshot_path_;
+    size_t snapshot_commands_;        ///< 启动时从快照回放的命令数
+    std::unordered_map<std::string, std::shared_ptr<SparklineHistory>> tray_histories_;
+    std::string hovered_tray_id_;
+    std::shared_ptr<ProcessUsageProvider> usage_provider_;
+    std::unordered_map<std::string, int> window_pids_;
+    std::unique_ptr<SystemStatusMonitor> status_monitor_;
+    
+    // 日历（calendar_year_和calendar_month_为当前显示的月份）
+    LunarCalendar calendar_;
+    bool calendar_open_;
+    int calendar_year_;
+    int calendar_month_;
+    
+    // 通知中心（变化回调访问帧调度成员）
+    std::shared_ptr<NotificationCenter> notifications_;
+    std::atomic<bool> notifications_dirty_;
+    bool notification_panel_open_;
+    
+    // 窗口悬停预览（缓存最后声明，保证其工作线程先于上述成员停止）
+    std::unordered_map<std::string, uint64_t> content_generations_;
+    std::string hovered_window_id_;
+    std::atomic<bool> preview_ready_;
+    WindowPreviewCache preview_cache_;
 };
 
 // TaskbarManager 实现
@@ -700,6 +2767,18 @@ std::vector<QuickLaunchItem> TaskbarManager::getQuickLaunchItems() const {
     return impl_->getQuickLaunchItems();
 }
 
+std::vector<QuickLaunchItem> TaskbarManager::getRankedQuickLaunchItems() const {
+    return impl_->getRankedQuickLaunchItems();
+}
+
+void TaskbarManager::recordApplicationLaunch(const std::string& app_id) {
+    impl_->recordApplicationLaunch(app_id);
+}
+
+std::vector<std::string> TaskbarManager::getRankedApplications(size_t limit) const {
+    return impl_->getRankedApplications(limit);
+}
+
 bool TaskbarManager::addSystemTrayItem(const SystemTrayItem& item) {
     return impl_->addSystemTrayItem(item);
 }
@@ -712,6 +2791,14 @@ std::vector<SystemTrayItem> TaskbarManager::getSystemTrayItems() const {
     return impl_->getSystemTrayItems();
 }
 
+bool TaskbarManager::updateSystemTrayItem(const SystemTrayItem& item) {
+    return impl_->updateSystemTrayItem(item);
+}
+
+bool TaskbarManager::setSystemTrayItemMaxUpdateRate(const std::string& item_id, double max_updates_per_second) {
+    return impl_->setSystemTrayItemMaxUpdateRate(item_id, max_updates_per_second);
+}
+
 void TaskbarManager::setClockFormat(const ClockFormat& format) {
     impl_->setClockFormat(format);
 }
@@ -720,8 +2807,9 @@ ClockFormat TaskbarManager::getClockFormat() const {
     return impl_->getClockFormat();
 }
 
-bool TaskbarManager::addWindowToList(const std::string& window_id, const std::string& window_title) {
-    return impl_->addWindowToList(window_id, window_title);
+bool TaskbarManager::addWindowToList(const std::string& window_id, const std::string& window_title, 
+                                     const std::string& app_id) {
+    return impl_->addWindowToList(window_id, window_title, app_id);
 }
 
 bool TaskbarManager::removeWindowFromList(const std::string& window_id) {
@@ -736,10 +2824,111 @@ void TaskbarManager::setWindowMinimized(const std::string& window_id, bool is_mi
     impl_->setWindowMinimized(window_id, is_minimized);
 }
 
+void TaskbarManager::setWindowProgress(const std::string& window_id, WindowOverlay::ProgressState state,
+                                       double fraction) {
+    impl_->setWindowProgress(window_id, state, fraction);
+}
+
+void TaskbarManager::setWindowBadge(const std::string& window_id, uint32_t count) {
+    impl_->setWindowBadge(window_id, count);
+}
+
+WindowOverlay TaskbarManager::getWindowOverlay(const std::string& window_id) const {
+    return impl_->getWindowOverlay(window_id);
+}
+
+void TaskbarManager::toggleCalendar() {
+    impl_->toggleCalendar();
+}
+
+void TaskbarManager::pageCalendar(int months) {
+    impl_->pageCalendar(months);
+}
+
+LunarCalendar& TaskbarManager::getCalendar() {
+    return impl_->getCalendar();
+}
+
+void TaskbarManager::setWindowProcess(const std::string& window_id, int pid) {
+    impl_->setWindowProcess(window_id, pid);
+}
+
+void TaskbarManager::setWindowController(std::shared_ptr<ITaskbarWindowController> controller) {
+    impl_->setWindowController(std::move(controller));
+}
+
+void TaskbarManager::minimizeAllWindows() {
+    impl_->minimizeAllWindows();
+}
+
+void TaskbarManager::showDesktop() {
+    impl_->showDesktop();
+}
+
 std::map<std::string, std::string> TaskbarManager::getWindowList() const {
     return impl_->getWindowList();
 }
 
+std::vector<WindowGroup> TaskbarManager::getWindowGroups() const {
+    return impl_->getWindowGroups();
+}
+
+bool TaskbarManager::openApplicationIndex(const std::string& cache_path) {
+    return impl_->openApplicationIndex(cache_path);
+}
+
+std::shared_ptr<ApplicationIndex> TaskbarManager::getApplicationIndex() const {
+    return impl_->getApplicationIndex();
+}
+
+bool TaskbarManager::openRecentDocuments(const std::string& path) {
+    return impl_->openRecentDocuments(path);
+}
+
+std::shared_ptr<const RecentDocumentList> TaskbarManager::getRecentDocuments(const std::string& app_id) const {
+    return impl_->getRecentDocuments(app_id);
+}
+
+uint64_t TaskbarManager::postNotification(const Notification& notification) {
+    return impl_->postNotification(notification);
+}
+
+std::shared_ptr<NotificationCenter> TaskbarManager::getNotificationCenter() const {
+    return impl_->getNotificationCenter();
+}
+
+bool TaskbarManager::loadPinyinTable(const std::string& path) {
+    return impl_->loadPinyinTable(path);
+}
+
+void TaskbarManager::setStartMenuQuery(const std::string& query) {
+    impl_->setStartMenuQuery(query);
+}
+
+std::vector<std::string> TaskbarManager::searchApplications(const std::string& query, size_t limit) {
+    return impl_->searchApplications(query, limit);
+}
+
+void TaskbarManager::setWindowContentProvider(WindowContentProvider provider) {
+    impl_->setWindowContentProvider(std::move(provider));
+}
+
+void TaskbarManager::notifyWindowContentChanged(const std::string& window_id) {
+    impl_->notifyWindowContentChanged(window_id);
+}
+
+void TaskbarManager::setFrameRequestCallback(std::function<void()> callback) {
+    impl_->setFrameRequestCallback(std::move(callback));
+}
+
+void TaskbarManager::tickClock() {
+    impl_->tickClock();
+}
+
+void TaskbarManager::processFrame() {
+    impl_->processFrame();
+}
+
 void TaskbarManager::handleMouseClick(int x, int y, int button) {
     impl_->handleMouseClick(x, y, button);
 }
@@ -748,8 +2937,28 @@ void TaskbarManager::handleMouseMove(int x, int y) {
     impl_->handleMouseMove(x, y);
 }
 
-void TaskbarManager::handleKeyboardEvent(int key_code, bool ctrl_pressed, bool shift_pressed) {
-    impl_->handleKeyboardEvent(key_code, ctrl_pressed, shift_pressed);
+void TaskbarManager::handleMouseWheel(int x, int y, int delta) {
+    impl_->handleMouseWheel(x, y, delta);
+}
+
+void TaskbarManager::scrollWindowList(int items) {
+    impl_->scrollWindowList(items);
+}
+
+WindowListViewport TaskbarManager::getWindowListViewport() const {
+    return impl_->getWindowListViewport();
+}
+
+void TaskbarManager::handleKeyboardEvent(int key_code, bool ctrl_pressed, bool shift_pressed, bool super_pressed) {
+    impl_->handleKeyboardEvent(key_code, ctrl_pressed, shift_pressed, super_pressed);
+}
+
+void TaskbarManager::setKeyboardFocus(bool focused) {
+    impl_->setKeyboardFocus(focused);
+}
+
+bool TaskbarManager::hasKeyboardFocus() const {
+    return impl_->hasKeyboardFocus();
 }
 
 void TaskbarManager::addEventListener(std::function<void(const TaskbarEvent&)> callback) {
@@ -764,6 +2973,22 @@ bool TaskbarManager::loadConfig(const std::string& config_path) {
     return impl_->loadConfig(config_path);
 }
 
+void TaskbarManager::setConfigAutoSave(const std::string& config_path) {
+    impl_->setConfigAutoSave(config_path);
+}
+
+bool TaskbarManager::flushConfig() {
+    return impl_->flushConfig();
+}
+
+void TaskbarManager::setStartupSnapshot(const std::string& snapshot_path) {
+    impl_->setStartupSnapshot(snapshot_path);
+}
+
+bool TaskbarManager::saveStartupSnapshot() {
+    return impl_->saveStartupSnapshot();
+}
+
 std::string TaskbarManager::getLastError() const {
     return impl_->getLastError();
 }
@@ -776,7 +3001,37 @@ void TaskbarManager::toggleAutoHide() {
     impl_->toggleAutoHide();
 }
 
-std::string TaskbarManager::getStatistics() const {
+bool TaskbarManager::addOutput(const std::string& output_id, std::shared_ptr<ITaskbarRenderer> renderer,
+                               const TaskbarAppearance& appearance) {
+    return impl_->addOutput(output_id, std::move(renderer), appearance);
+}
+
+bool TaskbarManager::removeOutput(const std::string& output_id) {
+    return impl_->removeOutput(output_id);
+}
+
+bool TaskbarManager::setOutputAppearance(const std::string& output_id, const TaskbarAppearance& appearance) {
+    return impl_->setOutputAppearance(output_id, appearance);
+}
+
+std::vector<std::string> TaskbarManager::getOutputIds() const {
+    return impl_->getOutputIds();
+}
+
+LaunchResult TaskbarManager::launchApplication(const std::string& executable,
+                                               const std::vector<std::string>& arguments) {
+    return impl_->launchApplication(executable, arguments);
+}
+
+void TaskbarManager::setScreenGeometry(int width, int height) {
+    impl_->setScreenGeometry(width, height);
+}
+
+void TaskbarManager::setVolumeLevel(int percent, bool muted) {
+    impl_->setVolumeLevel(percent, muted);
+}
+
+TaskbarStatistics TaskbarManager::getStatistics() const {
     return impl_->getStatistics();
 }
 
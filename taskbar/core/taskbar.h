@@ -8,6 +8,14 @@
 #ifndef CLOUDFLOW_TASKBAR_H
 #define CLOUDFLOW_TASKBAR_H
 
+#include "app_index.h"
+#include "app_search.h"
+#include "frecency.h"
+#include "launch_helper.h"
+#include "lunar_calendar.h"
+#include "notification_center.h"
+#include "recent_documents.h"
+#include "window_preview.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -48,7 +56,8 @@ enum class TaskbarComponent {
     QuickLaunch,    ///< 快速启动栏
     WindowList,     ///< 窗口列表
     SystemTray,     ///< 系统托盘
-    Clock           ///< 时钟
+    Clock,          ///< 时钟
+    Background      ///< 背景
 };
 
 /**
@@ -63,6 +72,7 @@ struct TaskbarAppearance {
     bool always_on_top;           ///< 是否始终置顶
     bool show_clock;              ///< 是否显示时钟
     bool show_system_tray;        ///< 是否显示系统托盘
+    bool group_windows;           ///< 是否按应用分组显示窗口
     
     TaskbarAppearance() : position(TaskbarPosition::Bottom), 
                           style(TaskbarStyle::Modern), 
@@ -70,7 +80,8 @@ struct TaskbarAppearance {
                           auto_hide(false), 
                           always_on_top(true), 
                           show_clock(true), 
-                          show_system_tray(true) {}
+                          show_system_tray(true),
+                          group_windows(true) {}
 };
 
 /**
@@ -84,8 +95,9 @@ struct QuickLaunchItem {
     std::string executable_path;  ///< 可执行文件路径
     std::vector<std::string> arguments; ///< 启动参数
     int launch_count;            ///< 启动次数（用于排序）
+    bool visible;                 ///< 是否可见
     
-    QuickLaunchItem() : launch_count(0) {}
+    QuickLaunchItem() : launch_count(0), visible(true) {}
 };
 
 /**
@@ -103,6 +115,19 @@ struct SystemTrayItem {
     SystemTrayItem() : visible(true), active(false) {}
 };
 
+/**
+ * @struct WindowGroup
+ * @brief 窗口分组信息（同一应用的窗口合并为一个任务栏项）
+ */
+struct WindowGroup {
+    std::string app_id;                   ///< 应用标识（可执行文件或desktop文件ID），为空表示未分组窗口
+    std::vector<std::string> window_ids;  ///< 组内窗口ID（按加入顺序）
+    size_t minimized_count;               ///< 组内最小化窗口数量
+    size_t current_index;                 ///< 点击循环切换时的当前窗口下标
+    
+    WindowGroup() : minimized_count(0), current_index(0) {}
+};
+
 /**
  * @struct ClockFormat
  * @brief 时钟格式设置
@@ -117,6 +142,129 @@ struct ClockFormat {
                     time_format("%H:%M:%S"), date_format("%Y-%m-%d") {}
 };
 
+class DisplayList;
+
+/**
+ * @struct WindowListViewport
+ * @brief 窗口列表可见范围
+ *
+ * 窗口列表项多于可容纳的数量时进入溢出模式，只布局和渲染可见范围内的项
+ */
+struct WindowListViewport {
+    size_t first;                 ///< 第一个可见项的下标
+    size_t visible;               ///< 可见项数量
+    size_t total;                 ///< 总项数
+
+    WindowListViewport() : first(0), visible(0), total(0) {}
+};
+
+/**
+ * @struct WindowOverlay
+ * @brief 窗口列表项上的进度条、徽标和资源占用告警叠加层
+ */
+struct WindowOverlay {
+    /**
+     * @enum ProgressState
+     * @brief 进度状态（按严重程度递增，分组项取最严重者）
+     */
+    enum class ProgressState : uint8_t {
+        None,             ///< 无进度
+        Normal,           ///< 正常
+        Indeterminate,    ///< 不确定进度
+        Paused,           ///< 已暂停
+        Error             ///< 出错
+    };
+
+    /**
+     * @brief 窗口所属进程的资源占用告警（位组合）
+     */
+    enum UsageAlert : uint8_t {
+        HighCpu = 1 << 0,         ///< CPU占用过高
+        HighMemory = 1 << 1       ///< 内存占用过高
+    };
+
+    ProgressState progress_state; ///< 进度状态
+    uint16_t progress;            ///< 进度（千分比，0-1000）
+    uint32_t badge;               ///< 徽标计数，0表示不显示
+    uint8_t usage_alert;          ///< 资源占用告警（UsageAlert位组合），0表示无告警
+
+    WindowOverlay() : progress_state(ProgressState::None), progress(0), badge(0), usage_alert(0) {}
+
+    bool empty() const {
+        return progress_state == ProgressState::None && badge == 0 && usage_alert == 0;
+    }
+
+    bool operator==(const WindowOverlay& other) const {
+        return progress_state == other.progress_state && progress == other.progress &&
+               badge == other.badge && usage_alert == other.usage_alert;
+    }
+
+    bool operator!=(const WindowOverlay& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @struct ClockText
+ * @brief 预先格式化的时钟文本
+ *
+ * 文本只在对应的时间单位（秒/分钟、日期）进位时重新格式化，
+ * 渲染器直接使用缓存的字符串，无需每次调用strftime
+ */
+struct ClockText {
+    std::chrono::system_clock::time_point time_point;   ///< 最近一次更新的时间
+    char time[64];                                      ///< 时间文本
+    char date[64];                                      ///< 日期文本（不显示日期时为空）
+
+    ClockText() : time{}, date{} {}
+};
+
+/**
+ * @struct Sparkline
+ * @brief 托盘项工具提示中的历史曲线
+ *
+ * 固定容量，点已由采样线程预先降采样，复制时只需memcpy
+ */
+struct Sparkline {
+    static constexpr size_t kCapacity = 60;
+
+    float points[kCapacity];      ///< 采样点（从旧到新）
+    size_t count;                 ///< 有效点数，0表示没有历史
+    float peak;                   ///< 有效点中的最大值，用于纵轴缩放
+
+    Sparkline() : points{}, count(0), peak(0) {}
+};
+
+/**
+ * @struct TaskbarStatistics
+ * @brief 单个任务栏管理器的统计快照
+ *
+ * 计数来自本实例的运行指标（在全局注册表中以instance标签区分）
+ */
+struct TaskbarStatistics {
+    uint64_t launches;                    ///< 启动应用次数
+    uint64_t launch_failures;             ///< 启动失败次数
+    uint64_t clicks;                      ///< 点击次数
+    uint64_t refreshes;                   ///< 完整重绘次数
+    int64_t windows;                      ///< 窗口列表中的窗口数量
+    size_t quick_launch_items;            ///< 快速启动项数量
+    size_t system_tray_items;             ///< 系统托盘项数量
+    size_t minimized_windows;             ///< 最小化窗口数量
+    uint64_t status_ticks;                ///< 状态轮询次数（未启动状态监视时为0）
+    uint64_t status_total_cpu_ns;         ///< 状态轮询累计CPU时间（纳秒）
+    uint64_t status_max_tick_cpu_ns;      ///< 单次状态轮询最大CPU时间（纳秒）
+    uint64_t config_writes;               ///< 配置写入次数
+    uint64_t config_coalesced;            ///< 合并的配置保存请求数量
+    size_t snapshot_commands;             ///< 启动快照回放命令数
+    NotificationCenterStats notifications; ///< 通知中心统计
+
+    TaskbarStatistics()
+        : launches(0), launch_failures(0), clicks(0), refreshes(0), windows(0),
+          quick_launch_items(0), system_tray_items(0), minimized_windows(0),
+          status_ticks(0), status_total_cpu_ns(0), status_max_tick_cpu_ns(0),
+          config_writes(0), config_coalesced(0), snapshot_commands(0) {}
+};
+
 /**
  * @struct TaskbarEvent
  * @brief 任务栏事件
@@ -124,7 +272,7 @@ struct ClockFormat {
 struct TaskbarEvent {
     enum class Type {
         StartMenuClicked,         ///< 开始菜单点击
-        QuickLaunchItemClicked,   ///< 快速启动项点击
+        QuickLaunchItemClicked,   ///< 快速启动项点击（应用已由任务栏启动）
         WindowMinimized,          ///< 窗口最小化
         WindowRestored,           ///< 窗口恢复
         SystemTrayItemClicked,    ///< 系统托盘项点击
@@ -184,11 +332,77 @@ public:
     
     /**
      * @brief 渲染系统托盘项
+     * 
+     * 托盘项状态更新时会单独调用以局部重绘该项
      * @param item 系统托盘项
      * @param appearance 外观设置
      */
     virtual void renderSystemTrayItem(const SystemTrayItem& item, const TaskbarAppearance& appearance) = 0;
     
+    /**
+     * @brief 显示托盘项工具提示（指针悬停在托盘项上，或悬停项的状态更新时调用）
+     * 
+     * 有历史记录的托盘项（如网络和CPU）附带最近60秒和10分钟的曲线，
+     * 其他托盘项的曲线count为0
+     * @param item 系统托盘项
+     * @param minute 最近60秒曲线
+     * @param ten_minutes 最近10分钟曲线
+     * @param appearance 外观设置
+     */
+    virtual void renderTrayTooltip(const SystemTrayItem& /*item*/, const Sparkline& /*minute*/,
+                                   const Sparkline& /*ten_minutes*/, const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 隐藏托盘项工具提示
+     * @param appearance 外观设置
+     */
+    virtual void hideTrayTooltip(const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染窗口分组项
+     * 
+     * 默认实现退化为渲染组内当前窗口的窗口列表项
+     * @param group 窗口分组
+     * @param window_title 组内当前窗口标题
+     * @param is_active 组内是否有激活窗口
+     * @param is_minimized 组内窗口是否全部最小化
+     * @param appearance 外观设置
+     */
+    virtual void renderWindowGroupItem(const WindowGroup& group, 
+                                      const std::string& window_title, 
+                                      bool is_active, 
+                                      bool is_minimized, 
+                                      const TaskbarAppearance& appearance) {
+        renderWindowListItem(group.window_ids[group.current_index], window_title, 
+                             is_active, is_minimized, appearance);
+    }
+    
+    /**
+     * @brief 渲染悬停窗口预览
+     * @param preview 窗口预览
+     * @param appearance 外观设置
+     */
+    virtual void renderWindowPreview(const WindowPreview& /*preview*/, const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 隐藏窗口预览
+     * @param appearance 外观设置
+     */
+    virtual void hideWindowPreview(const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染开始菜单
+     * @param entries 应用索引项（有搜索文本时为搜索结果，否则常用应用在前，其余按名称排序）
+     * @param appearance 外观设置
+     */
+    virtual void renderStartMenu(const std::vector<ApplicationEntry>& /*entries*/, const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 隐藏开始菜单
+     * @param appearance 外观设置
+     */
+    virtual void hideStartMenu(const TaskbarAppearance& /*appearance*/) {}
+    
     /**
      * @brief 渲染时钟
      * @param current_time 当前时间
@@ -199,6 +413,110 @@ public:
                             const ClockFormat& format, 
                             const TaskbarAppearance& appearance) = 0;
     
+    /**
+     * @brief 使用缓存文本渲染时钟
+     * 
+     * 默认实现转发给renderClock()，支持文本渲染的渲染器应重写此方法
+     * @param text 预先格式化的时钟文本
+     * @param format 时钟格式
+     * @param appearance 外观设置
+     */
+    virtual void renderClockText(const ClockText& text,
+                                 const ClockFormat& format,
+                                 const TaskbarAppearance& appearance) {
+        renderClock(text.time_point, format, appearance);
+    }
+    
+    /**
+     * @brief 渲染组件的显示列表
+     * 
+     * 保留模式或远程渲染器可重写此方法：changed为false时列表与上次相同，
+     * 可直接复用上次的输出。默认返回false，由任务栏回放列表中的各个调用
+     * @param component 组件
+     * @param list 组件的显示列表（见display_list.h）
+     * @param changed 列表自上次以来是否重新录制
+     * @param appearance 外观设置
+     * @return 是否已处理
+     */
+    virtual bool renderDisplayList(TaskbarComponent /*component*/, const DisplayList& /*list*/,
+                                   bool /*changed*/, const TaskbarAppearance& /*appearance*/) {
+        return false;
+    }
+    
+    /**
+     * @brief 设置任务栏滑出屏幕的偏移量（自动隐藏动画）
+     * @param offset 滑出屏幕的像素数，0为完全显示
+     * @param appearance 外观设置
+     */
+    virtual void setTaskbarOffset(int /*offset*/, const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染窗口列表溢出指示（如滚动箭头），在可见项之前调用
+     * 
+     * 只在总项数超过可见项数时调用，之后的窗口列表项从viewport.first开始
+     * @param viewport 可见范围
+     * @param appearance 外观设置
+     */
+    virtual void renderWindowListOverflow(const WindowListViewport& /*viewport*/,
+                                          const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染窗口列表项的进度条和徽标，在对应列表项之后调用
+     * 
+     * 叠加层变化时只对受影响的可见项单独调用，不触发整栏重绘；
+     * overlay为空表示清除该项的叠加层
+     * @param item_id 列表项对应的窗口ID（分组时为组内当前窗口）
+     * @param overlay 叠加层（分组时为组内各窗口的合并结果）
+     * @param appearance 外观设置
+     */
+    virtual void renderWindowOverlay(const std::string& /*item_id*/, const WindowOverlay& /*overlay*/,
+                                     const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 显示跳转列表（右键点击快速启动项或窗口列表项）
+     * @param app_id 应用标识
+     * @param documents 该应用的最近文档，没有记录时为空
+     * @param appearance 外观设置
+     */
+    virtual void showJumpList(const std::string& /*app_id*/, const RecentDocumentList& /*documents*/,
+                              const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染通知面板（点击通知托盘项打开，内容变化时按帧重新渲染）
+     * @param notifications 通知列表（从新到旧）
+     * @param appearance 外观设置
+     */
+    virtual void renderNotifications(const std::vector<Notification>& /*notifications*/,
+                                     const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 隐藏通知面板
+     * @param appearance 外观设置
+     */
+    virtual void hideNotifications(const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染日历（点击时钟打开，翻页时重新渲染）
+     * @param month 月视图，含农历日期和节气
+     * @param today_index 今天在month.days中的下标，不在本视图中时为-1
+     * @param appearance 外观设置
+     */
+    virtual void renderCalendar(const CalendarMonth& /*month*/, int /*today_index*/,
+                                const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 隐藏日历
+     * @param appearance 外观设置
+     */
+    virtual void hideCalendar(const TaskbarAppearance& /*appearance*/) {}
+    
+    /**
+     * @brief 渲染键盘焦点高亮（任务栏拥有键盘焦点时绘制在列表项之上，完整重绘后重新发送）
+     * @param item_id 焦点所在列表项的窗口ID（分组时为组内当前窗口），为空时清除高亮
+     * @param appearance 外观设置
+     */
+    virtual void renderKeyboardFocus(const std::string& /*item_id*/, const TaskbarAppearance& /*appearance*/) {}
+    
     /**
      * @brief 获取任务栏尺寸
      * @param appearance 外观设置
@@ -207,6 +525,37 @@ public:
     virtual std::pair<int, int> getTaskbarSize(const TaskbarAppearance& appearance) = 0;
 };
 
+/**
+ * @class ITaskbarWindowController
+ * @brief 任务栏窗口控制接口
+ * 
+ * 由窗口管理器一侧实现，将任务栏发起的窗口操作转交给真实窗口
+ */
+class ITaskbarWindowController {
+public:
+    virtual ~ITaskbarWindowController() = default;
+    
+    /**
+     * @brief 批量设置窗口最小化状态
+     * 
+     * 实现应作为一次批量状态变更提交（如WindowManager::setWindowStates），
+     * 并恢复窗口最小化前的最大化或全屏状态
+     * @param window_ids 窗口ID列表
+     * @param minimized 是否最小化
+     * @return 是否成功
+     */
+    virtual bool setWindowsMinimized(const std::vector<std::string>& window_ids, bool minimized) = 0;
+    
+    /**
+     * @brief 激活窗口（恢复并置于前台）
+     * 
+     * 默认返回false，任务栏改为发出WindowRestored事件
+     * @param window_id 窗口ID
+     * @return 是否已处理
+     */
+    virtual bool activateWindow(const std::string& /*window_id*/) { return false; }
+};
+
 /**
  * @class TaskbarManager
  * @brief 任务栏管理器
@@ -279,6 +628,25 @@ public:
      */
     std::vector<QuickLaunchItem> getQuickLaunchItems() const;
     
+    /**
+     * @brief 获取按启动频度排序的快速启动项
+     * @return 快速启动项列表（未启动过的项保持原有顺序排在最后）
+     */
+    std::vector<QuickLaunchItem> getRankedQuickLaunchItems() const;
+    
+    /**
+     * @brief 记录一次开始菜单应用启动
+     * @param app_id 应用标识
+     */
+    void recordApplicationLaunch(const std::string& app_id);
+    
+    /**
+     * @brief 获取按启动频度排序的应用标识（快速启动项与开始菜单项共用）
+     * @param limit 最大数量，0表示不限制
+     * @return 应用标识列表
+     */
+    std::vector<std::string> getRankedApplications(size_t limit = 0) const;
+    
     /**
      * @brief 添加系统托盘项
      * @param item 系统托盘项
@@ -299,6 +667,31 @@ public:
      */
     std::vector<SystemTrayItem> getSystemTrayItems() const;
     
+    /**
+     * @brief 更新系统托盘项状态（可在任意线程调用）
+     * 
+     * 与最新状态相同的更新直接丢弃；同一帧内的多次更新合并为一次重绘，
+     * 并受该项最大更新频率限制，在processFrame()中只重绘发生变化的项
+     * @param item 系统托盘项（按ID匹配）
+     * @return 托盘项存在返回true
+     */
+    bool updateSystemTrayItem(const SystemTrayItem& item);
+    
+    /**
+     * @brief 设置系统托盘项的最大更新频率
+     * @param item_id 项目ID
+     * @param max_updates_per_second 每秒最多重绘次数，0表示不限制
+     * @return 托盘项存在返回true
+     */
+    bool setSystemTrayItemMaxUpdateRate(const std::string& item_id, double max_updates_per_second);
+    
+    /**
+     * @brief 设置音量状态（由音频服务推送，在下一次状态轮询时更新音量托盘项）
+     * @param percent 音量百分比（0-100）
+     * @param muted 是否静音
+     */
+    void setVolumeLevel(int percent, bool muted);
+    
     /**
      * @brief 设置时钟格式
      * @param format 时钟格式
@@ -315,9 +708,11 @@ public:
      * @brief 添加窗口到窗口列表
      * @param window_id 窗口ID
      * @param window_title 窗口标题
+     * @param app_id 应用标识（可执行文件或desktop文件ID），为空时窗口单独成组
      * @return 添加是否成功
      */
-    bool addWindowToList(const std::string& window_id, const std::string& window_title);
+    bool addWindowToList(const std::string& window_id, const std::string& window_title, 
+                         const std::string& app_id = "");
     
     /**
      * @brief 从窗口列表移除窗口
@@ -340,12 +735,194 @@ public:
      */
     void setWindowMinimized(const std::string& window_id, bool is_minimized);
     
+    /**
+     * @brief 设置窗口进度（可在任意线程调用）
+     * 
+     * 同一帧内的多次更新合并为一次，只重绘受影响的列表项；不在窗口列表中的窗口忽略
+     * @param window_id 窗口ID
+     * @param state 进度状态，None表示清除进度
+     * @param fraction 进度（0.0-1.0）
+     */
+    void setWindowProgress(const std::string& window_id, WindowOverlay::ProgressState state, double fraction);
+    
+    /**
+     * @brief 设置窗口徽标计数（可在任意线程调用，不在窗口列表中的窗口忽略）
+     * @param window_id 窗口ID
+     * @param count 计数，0表示清除徽标
+     */
+    void setWindowBadge(const std::string& window_id, uint32_t count);
+    
+    /**
+     * @brief 获取窗口的叠加层
+     * @param window_id 窗口ID
+     * @return 最新设置的叠加层
+     */
+    WindowOverlay getWindowOverlay(const std::string& window_id) const;
+    
+    /**
+     * @brief 设置窗口所属进程，用于资源占用采样
+     * 
+     * 采样在状态监视线程中进行，只在CPU或内存占用跨越阈值时
+     * 更新该窗口叠加层的usage_alert
+     * @param window_id 窗口ID
+     * @param pid 进程ID，小于等于0时停止采样
+     */
+    void setWindowProcess(const std::string& window_id, int pid);
+    
+    /**
+     * @brief 设置窗口控制器
+     * @param controller 窗口控制器，为空时只更新任务栏自身的状态
+     */
+    void setWindowController(std::shared_ptr<ITaskbarWindowController> controller);
+    
+    /**
+     * @brief 最小化所有窗口（一次批量状态变更，一次刷新）
+     */
+    void minimizeAllWindows();
+    
+    /**
+     * @brief 切换显示桌面
+     * 
+     * 首次调用最小化当前可见的窗口并记录该集合，再次调用只恢复该集合中
+     * 仍处于最小化的窗口。期间有窗口被单独恢复或新窗口加入时记录失效
+     */
+    void showDesktop();
+    
     /**
      * @brief 获取窗口列表
      * @return 窗口ID和标题的映射
      */
     std::map<std::string, std::string> getWindowList() const;
     
+    /**
+     * @brief 获取窗口分组列表
+     * @return 按显示顺序排列的窗口分组
+     */
+    std::vector<WindowGroup> getWindowGroups() const;
+    
+    /**
+     * @brief 打开开始菜单应用索引
+     * 
+     * 加载（必要时构建）内存映射索引并开始监视应用目录，
+     * 之后打开开始菜单不再访问文件系统
+     * @param cache_path 索引文件路径
+     * @return 打开是否成功
+     */
+    bool openApplicationIndex(const std::string& cache_path);
+    
+    /**
+     * @brief 获取开始菜单应用索引
+     * @return 应用索引，未打开返回空指针
+     */
+    std::shared_ptr<ApplicationIndex> getApplicationIndex() const;
+    
+    /**
+     * @brief 打开最近文档服务（跳转列表）
+     * 
+     * 在后台线程中解析recently-used.xbel并监视其变化，之后右键点击任务栏项
+     * 只读取内存中的每应用有界列表
+     * @param path xbel文件路径，为空时使用$XDG_DATA_HOME/recently-used.xbel
+     * @return 打开是否成功
+     */
+    bool openRecentDocuments(const std::string& path = "");
+    
+    /**
+     * @brief 获取应用的最近文档
+     * @param app_id 应用名称、可执行文件路径或desktop文件ID
+     * @return 文档列表，未打开服务或没有记录时返回空指针
+     */
+    std::shared_ptr<const RecentDocumentList> getRecentDocuments(const std::string& app_id) const;
+    
+    /**
+     * @brief 发送通知（可在任意线程调用）
+     * 
+     * 通知经过重复合并和按应用限流后进入通知中心，
+     * 托盘项和已打开的通知面板在下一帧统一更新
+     * @param notification 通知
+     * @return 通知ID，被限流丢弃时返回0
+     */
+    uint64_t postNotification(const Notification& notification);
+    
+    /**
+     * @brief 获取通知中心
+     * @return 通知中心
+     */
+    std::shared_ptr<NotificationCenter> getNotificationCenter() const;
+    
+    /**
+     * @brief 打开或关闭日历（左键点击时钟时调用）
+     * 
+     * 打开时显示当月，并预先生成前后两个月的视图，翻页只需查表
+     */
+    void toggleCalendar();
+    
+    /**
+     * @brief 日历翻页（日历未打开时无效）
+     * @param months 翻动的月数，正值向后
+     */
+    void pageCalendar(int months);
+    
+    /**
+     * @brief 获取日历服务
+     * @return 日历服务
+     */
+    LunarCalendar& getCalendar();
+    
+    /**
+     * @brief 加载完整拼音字表（pinyin-data格式），用于开始菜单拼音搜索
+     * @param path 数据文件路径
+     * @return 加载是否成功
+     */
+    bool loadPinyinTable(const std::string& path);
+    
+    /**
+     * @brief 设置开始菜单搜索文本
+     * @param query 搜索文本，为空时显示全部应用
+     */
+    void setStartMenuQuery(const std::string& query);
+    
+    /**
+     * @brief 搜索开始菜单应用
+     * @param query 搜索文本，支持拼音全拼和首字母
+     * @param limit 最大结果数量
+     * @return 匹配的应用标识（按相关度排序；搜索数据在索引加载后于后台构建，完成前为空）
+     */
+    std::vector<std::string> searchApplications(const std::string& query, size_t limit = 20);
+    
+    /**
+     * @brief 设置窗口内容提供者（用于生成悬停预览，在预览线程中调用）
+     * @param provider 内容提供者
+     */
+    void setWindowContentProvider(WindowContentProvider provider);
+    
+    /**
+     * @brief 通知窗口内容已改变，使其缓存预览过期
+     * @param window_id 窗口ID
+     */
+    void notifyWindowContentChanged(const std::string& window_id);
+    
+    /**
+     * @brief 设置帧请求回调
+     * 
+     * 任务栏有待处理的异步结果时调用（可能在任意线程），
+     * 宿主应在下一显示帧于面板线程调用processFrame()。应在initialize之前设置
+     * @param callback 回调函数
+     */
+    void setFrameRequestCallback(std::function<void()> callback);
+    
+    /**
+     * @brief 时钟文本进位
+     * 
+     * 由时钟线程在时间或日期文本变化时调用，只标记时钟并请求帧，
+     * 时钟在下一次processFrame()中重绘。宿主（如基准测试）也可直接调用以驱动一次时钟更新
+     */
+    void tickClock();
+    
+    /**
+     * @brief 处理一帧（在面板线程中调用）
+     */
+    void processFrame();
+    
     /**
      * @brief 处理鼠标点击事件
      * @param x 鼠标X坐标
@@ -361,13 +938,52 @@ public:
      */
     void handleMouseMove(int x, int y);
     
+    /**
+     * @brief 处理鼠标滚轮事件（在窗口列表上滚动溢出的项）
+     * @param x 鼠标X坐标
+     * @param y 鼠标Y坐标
+     * @param delta 滚动格数，正值向列表开头滚动
+     */
+    void handleMouseWheel(int x, int y, int delta);
+    
+    /**
+     * @brief 滚动窗口列表
+     * @param items 滚动的项数，正值向列表末尾滚动；结果钳制在有效范围内
+     */
+    void scrollWindowList(int items);
+    
+    /**
+     * @brief 获取窗口列表在主输出上的可见范围
+     * @return 可见范围
+     */
+    WindowListViewport getWindowListViewport() const;
+    
     /**
      * @brief 处理键盘事件
+     * 
+     * Windows键 + 1..9激活第N个窗口列表项（分组项已激活时切换到组内下一个窗口）。
+     * 任务栏拥有键盘焦点且开始菜单关闭时，方向键在窗口列表项之间移动焦点高亮，
+     * Enter或空格激活高亮项。激活通过窗口控制器直接完成，不重绘任务栏
      * @param key_code 键码
      * @param ctrl_pressed Ctrl键状态
      * @param shift_pressed Shift键状态
+     * @param super_pressed Windows键状态
+     */
+    void handleKeyboardEvent(int key_code, bool ctrl_pressed, bool shift_pressed, bool super_pressed = false);
+    
+    /**
+     * @brief 设置任务栏是否拥有键盘焦点
+     * 
+     * 获得焦点时高亮活动窗口所在的列表项（没有活动窗口时为第一项），失去焦点时清除高亮
+     * @param focused 是否拥有键盘焦点
+     */
+    void setKeyboardFocus(bool focused);
+    
+    /**
+     * @brief 检查任务栏是否拥有键盘焦点
+     * @return 是否拥有键盘焦点
      */
-    void handleKeyboardEvent(int key_code, bool ctrl_pressed, bool shift_pressed);
+    bool hasKeyboardFocus() const;
     
     /**
      * @brief 添加事件监听器
@@ -376,7 +992,7 @@ public:
     void addEventListener(std::function<void(const TaskbarEvent&)> callback);
     
     /**
-     * @brief 保存任务栏配置
+     * @brief 保存任务栏配置（同步写入临时文件后原子替换；启用了自动保存时经后台写入器写入并等待完成）
      * @param config_path 配置文件路径
      * @return 保存是否成功
      */
@@ -384,11 +1000,44 @@ public:
     
     /**
      * @brief 加载任务栏配置
+     * 
+     * 先校验到暂存区，任何字段无效时返回false且不改变当前配置；
+     * 成功时一次性应用并只刷新一次
      * @param config_path 配置文件路径
      * @return 加载是否成功
      */
     bool loadConfig(const std::string& config_path);
     
+    /**
+     * @brief 设置配置自动保存
+     * 
+     * 外观、时钟格式、快速启动项和启动频度变化后在后台线程中保存，
+     * 连续的变化在防抖间隔内合并为一次写入
+     * @param config_path 配置文件路径，为空时关闭自动保存
+     */
+    void setConfigAutoSave(const std::string& config_path);
+    
+    /**
+     * @brief 立即写入尚未自动保存的配置并等待完成
+     * @return 写入是否成功
+     */
+    bool flushConfig();
+    
+    /**
+     * @brief 设置启动快照文件
+     * 
+     * 应在initialize之前调用。initialize时先回放快照中上次布局好的背景、开始按钮、
+     * 快速启动项、托盘项和时钟，再启动辅助进程和后台线程；析构时写回最后的状态
+     * @param snapshot_path 快照文件路径
+     */
+    void setStartupSnapshot(const std::string& snapshot_path);
+    
+    /**
+     * @brief 立即保存启动快照
+     * @return 保存是否成功
+     */
+    bool saveStartupSnapshot();
+    
     /**
      * @brief 获取错误信息
      * @return 错误描述
@@ -401,16 +1050,72 @@ public:
      */
     bool isVisible() const;
     
+    /**
+     * @brief 启动应用
+     * 
+     * 经由initialize()时预先fork的辅助进程以posix_spawnp启动，
+     * 辅助进程不可用时在当前进程中直接启动；耗时计入运行指标
+     * @param executable 可执行文件路径或名称（按PATH查找）
+     * @param arguments 启动参数
+     * @return 启动结果（含spawn耗时）
+     */
+    LaunchResult launchApplication(const std::string& executable, const std::vector<std::string>& arguments);
+    
+    /**
+     * @brief 添加附加输出（多显示器）
+     * 
+     * 附加输出与initialize()传入的主输出共享窗口列表、托盘和时钟等模型，
+     * 模型变化只计算一次并分发到所有输出。指针与键盘事件、开始菜单、
+     * 窗口预览和自动隐藏仍由主输出处理
+     * @param output_id 输出ID
+     * @param renderer 该输出的渲染器
+     * @param appearance 该输出的外观设置
+     * @return 添加是否成功
+     */
+    bool addOutput(const std::string& output_id, std::shared_ptr<ITaskbarRenderer> renderer,
+                   const TaskbarAppearance& appearance);
+    
+    /**
+     * @brief 移除附加输出
+     * @param output_id 输出ID
+     * @return 移除是否成功
+     */
+    bool removeOutput(const std::string& output_id);
+    
+    /**
+     * @brief 设置附加输出的外观
+     * @param output_id 输出ID
+     * @param appearance 外观设置
+     * @return 设置是否成功
+     */
+    bool setOutputAppearance(const std::string& output_id, const TaskbarAppearance& appearance);
+    
+    /**
+     * @brief 获取所有附加输出的ID
+     * @return 输出ID列表
+     */
+    std::vector<std::string> getOutputIds() const;
+    
+    /**
+     * @brief 设置屏幕尺寸（用于自动隐藏的边缘判断）
+     * @param width 屏幕宽度
+     * @param height 屏幕高度
+     */
+    void setScreenGeometry(int width, int height);
+    
     /**
      * @brief 切换自动隐藏状态
+     * 
+     * 自动隐藏时，指针停留在屏幕边缘超过显示延迟后任务栏滑入，
+     * 离开任务栏及其滞回区间超过隐藏延迟后滑出；动画通过processFrame()推进
      */
     void toggleAutoHide();
     
     /**
-     * @brief 获取任务栏统计信息
-     * @return 统计信息字符串
+     * @brief 获取本任务栏的统计信息
+     * @return 统计快照
      */
-    std::string getStatistics() const;
+    TaskbarStatistics getStatistics() const;
 
 private:
     class Impl;
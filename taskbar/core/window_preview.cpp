@@ -0,0 +1,285 @@
+/**
+ * @file window_preview.cpp
+ * @brief 窗口预览缓存实现文件
+ */
+
+#include "window_preview.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace CloudFlow {
+namespace Desktop {
+
+namespace {
+
+/**
+ * @brief 按盒式滤波将内容缓冲区缩放为预览（保持宽高比）
+ */
+bool scaleToPreview(const WindowContentBuffer& buffer, int max_width, int max_height, WindowPreview& preview) {
+    if (!buffer.pixels || buffer.width <= 0 || buffer.height <= 0 ||
+        buffer.stride < buffer.width * 4 ||
+        buffer.pixels->size() < static_cast<size_t>(buffer.stride) * buffer.height) {
+        return false;
+    }
+
+    double scale = std::min({1.0,
+                             static_cast<double>(max_width) / buffer.width,
+                             static_cast<double>(max_height) / buffer.height});
+    preview.width = std::max(1, static_cast<int>(buffer.width * scale));
+    preview.height = std::max(1, static_cast<int>(buffer.height * scale));
+    preview.pixels.assign(static_cast<size_t>(preview.width) * preview.height * 4, 0);
+
+    const uint8_t* src = buffer.pixels->data();
+    for (int py = 0; py < preview.height; ++py) {
+        int y0 = py * buffer.height / preview.height;
+        int y1 = std::max(y0 + 1, (py + 1) * buffer.height / preview.height);
+        for (int px = 0; px < preview.width; ++px) {
+            int x0 = px * buffer.width / preview.width;
+            int x1 = std::max(x0 + 1, (px + 1) * buffer.width / preview.width);
+
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int y = y0; y < y1; ++y) {
+                const uint8_t* row = src + static_cast<size_t>(y) * buffer.stride;
+                for (int x = x0; x < x1; ++x) {
+                    const uint8_t* p = row + x * 4;
+                    sum[0] += p[0];
+                    sum[1] += p[1];
+                    sum[2] += p[2];
+                    sum[3] += p[3];
+                }
+            }
+
+            uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+            uint8_t* dst = &preview.pixels[(static_cast<size_t>(py) * preview.width + px) * 4];
+            for (int c = 0; c < 4; ++c) {
+                dst[c] = static_cast<uint8_t>(sum[c] / count);
+            }
+        }
+    }
+    return true;
+}
+
+size_t previewBytes(const WindowPreview& preview) {
+    return sizeof(WindowPreview) + preview.window_id.size() + preview.pixels.size();
+}
+
+} // namespace
+
+class WindowPreviewCache::Impl {
+public:
+    Impl(size_t memory_budget, int max_width, int max_height)
+        : memory_budget_(memory_budget),
+          max_width_(max_width),
+          max_height_(max_height),
+          memory_usage_(0),
+          in_flight_cancelled_(false),
+          stop_(false) {
+        worker_ = std::thread([this]() { workerLoop(); });
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void setContentProvider(WindowContentProvider provider) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        provider_ = std::move(provider);
+    }
+
+    void setCompletionCallback(std::function<void(const std::string&)> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completion_callback_ = std::move(callback);
+    }
+
+    void request(const std::string& window_id, uint64_t generation, bool prefetch) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto cached = index_.find(window_id);
+            if (cached != index_.end() && (*cached->second)->generation == generation) {
+                return;
+            }
+
+            auto pending = pending_.find(window_id);
+            if (pending != pending_.end()) {
+                // 合并重复请求；悬停请求提升到队首
+                pending->second = generation;
+                if (!prefetch) {
+                    queue_.erase(std::find(queue_.begin(), queue_.end(), window_id));
+                    queue_.push_front(window_id);
+                }
+                return;
+            }
+
+            pending_[window_id] = generation;
+            if (prefetch) {
+                queue_.push_back(window_id);
+            } else {
+                queue_.push_front(window_id);
+            }
+        }
+        cv_.notify_one();
+    }
+
+    std::shared_ptr<const WindowPreview> get(const std::string& window_id, uint64_t generation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(window_id);
+        if (it == index_.end() || (*it->second)->generation != generation) {
+            return nullptr;
+        }
+
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+
+    void invalidate(const std::string& window_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.erase(window_id)) {
+            queue_.erase(std::find(queue_.begin(), queue_.end(), window_id));
+        }
+        if (in_flight_ == window_id) {
+            in_flight_cancelled_ = true;
+        }
+        eraseLocked(window_id);
+    }
+
+    void setMemoryBudget(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        memory_budget_ = bytes;
+        evictLocked();
+    }
+
+    size_t getMemoryUsage() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return memory_usage_;
+    }
+
+private:
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+            if (stop_) return;
+
+            std::string window_id = queue_.front();
+            queue_.pop_front();
+            uint64_t generation = pending_[window_id];
+            pending_.erase(window_id);
+            in_flight_ = window_id;
+            in_flight_cancelled_ = false;
+            WindowContentProvider provider = provider_;
+            lock.unlock();
+
+            // 读取内容与缩放都在锁外进行，不阻塞面板线程
+            auto preview = std::make_shared<WindowPreview>();
+            preview->window_id = window_id;
+            preview->generation = generation;
+            WindowContentBuffer buffer;
+            bool ok = provider && provider(window_id, buffer) &&
+                      scaleToPreview(buffer, max_width_, max_height_, *preview);
+
+            lock.lock();
+            in_flight_.clear();
+            if (!ok || in_flight_cancelled_) continue;
+
+            eraseLocked(window_id);
+            lru_.push_front(preview);
+            index_[window_id] = lru_.begin();
+            memory_usage_ += previewBytes(*preview);
+            evictLocked();
+
+            auto callback = completion_callback_;
+            lock.unlock();
+            if (callback) {
+                callback(window_id);
+            }
+            lock.lock();
+        }
+    }
+
+    void eraseLocked(const std::string& window_id) {
+        auto it = index_.find(window_id);
+        if (it == index_.end()) return;
+
+        memory_usage_ -= previewBytes(**it->second);
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    void evictLocked() {
+        // 至少保留最近使用的一项，避免单个大预览被立即淘汰
+        while (memory_usage_ > memory_budget_ && lru_.size() > 1) {
+            eraseLocked(lru_.back()->window_id);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+
+    size_t memory_budget_;
+    const int max_width_;
+    const int max_height_;
+    size_t memory_usage_;
+
+    WindowContentProvider provider_;
+    std::function<void(const std::string&)> completion_callback_;
+
+    std::deque<std::string> queue_;
+    std::unordered_map<std::string, uint64_t> pending_;
+    std::string in_flight_;
+    bool in_flight_cancelled_;
+
+    std::list<std::shared_ptr<const WindowPreview>> lru_;
+    std::unordered_map<std::string, std::list<std::shared_ptr<const WindowPreview>>::iterator> index_;
+
+    bool stop_;
+};
+
+// WindowPreviewCache 实现
+WindowPreviewCache::WindowPreviewCache(size_t memory_budget, int max_width, int max_height)
+    : impl_(std::make_unique<Impl>(memory_budget, max_width, max_height)) {}
+
+WindowPreviewCache::~WindowPreviewCache() = default;
+
+void WindowPreviewCache::setContentProvider(WindowContentProvider provider) {
+    impl_->setContentProvider(std::move(provider));
+}
+
+void WindowPreviewCache::setCompletionCallback(std::function<void(const std::string& window_id)> callback) {
+    impl_->setCompletionCallback(std::move(callback));
+}
+
+void WindowPreviewCache::request(const std::string& window_id, uint64_t generation, bool prefetch) {
+    impl_->request(window_id, generation, prefetch);
+}
+
+std::shared_ptr<const WindowPreview> WindowPreviewCache::get(const std::string& window_id, uint64_t generation) {
+    return impl_->get(window_id, generation);
+}
+
+void WindowPreviewCache::invalidate(const std::string& window_id) {
+    impl_->invalidate(window_id);
+}
+
+void WindowPreviewCache::setMemoryBudget(size_t bytes) {
+    impl_->setMemoryBudget(bytes);
+}
+
+size_t WindowPreviewCache::getMemoryUsage() const {
+    return impl_->getMemoryUsage();
+}
+
+} // namespace Desktop
+} // namespace CloudFlow
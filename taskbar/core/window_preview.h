@@ -0,0 +1,139 @@
+/**
+ * @file window_preview.h
+ * @brief 窗口预览缓存头文件
+ *
+ * 负责在后台线程中根据窗口内容缓冲区异步生成缩略预览，
+ * 并按窗口和内容代数进行缓存，在固定内存预算内按LRU淘汰
+ */
+
+#ifndef CLOUDFLOW_WINDOW_PREVIEW_H
+#define CLOUDFLOW_WINDOW_PREVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace CloudFlow {
+namespace Desktop {
+
+/**
+ * @struct WindowContentBuffer
+ * @brief 窗口内容缓冲区（RGBA8888）
+ */
+struct WindowContentBuffer {
+    int width;                    ///< 宽度（像素）
+    int height;                   ///< 高度（像素）
+    int stride;                   ///< 每行字节数
+    std::shared_ptr<const std::vector<uint8_t>> pixels; ///< 像素数据
+
+    WindowContentBuffer() : width(0), height(0), stride(0) {}
+};
+
+/**
+ * @struct WindowPreview
+ * @brief 窗口缩略预览（RGBA8888，紧密排列）
+ */
+struct WindowPreview {
+    std::string window_id;        ///< 窗口ID
+    uint64_t generation;          ///< 生成预览时的窗口内容代数
+    int width;                    ///< 预览宽度
+    int height;                   ///< 预览高度
+    std::vector<uint8_t> pixels;  ///< 像素数据
+
+    WindowPreview() : generation(0), width(0), height(0) {}
+};
+
+/**
+ * @brief 窗口内容提供者
+ *
+ * 在预览工作线程中调用，实现必须是线程安全的
+ * @return 成功获取内容返回true
+ */
+using WindowContentProvider = std::function<bool(const std::string& window_id, WindowContentBuffer& buffer)>;
+
+/**
+ * @class WindowPreviewCache
+ * @brief 窗口预览缓存
+ *
+ * 预览请求进入后台队列，悬停请求优先于预取请求处理；
+ * 同一窗口的重复请求会被合并。缓存总量超过内存预算时淘汰最久未使用的预览
+ */
+class WindowPreviewCache {
+public:
+    /**
+     * @brief 构造函数
+     * @param memory_budget 内存预算（字节）
+     * @param max_width 预览最大宽度
+     * @param max_height 预览最大高度
+     */
+    explicit WindowPreviewCache(size_t memory_budget = 16 * 1024 * 1024,
+                                int max_width = 240,
+                                int max_height = 160);
+
+    /**
+     * @brief 析构函数，停止后台线程
+     */
+    ~WindowPreviewCache();
+
+    // 禁用拷贝和赋值
+    WindowPreviewCache(const WindowPreviewCache&) = delete;
+    WindowPreviewCache& operator=(const WindowPreviewCache&) = delete;
+
+    /**
+     * @brief 设置窗口内容提供者
+     * @param provider 内容提供者
+     */
+    void setContentProvider(WindowContentProvider provider);
+
+    /**
+     * @brief 设置预览生成完成回调（在工作线程中调用）
+     * @param callback 回调函数
+     */
+    void setCompletionCallback(std::function<void(const std::string& window_id)> callback);
+
+    /**
+     * @brief 请求生成预览
+     * @param window_id 窗口ID
+     * @param generation 当前窗口内容代数
+     * @param prefetch 是否为预取请求（优先级较低）
+     */
+    void request(const std::string& window_id, uint64_t generation, bool prefetch);
+
+    /**
+     * @brief 获取缓存的预览
+     * @param window_id 窗口ID
+     * @param generation 当前窗口内容代数
+     * @return 代数匹配的预览，不存在或已过期返回空指针
+     */
+    std::shared_ptr<const WindowPreview> get(const std::string& window_id, uint64_t generation);
+
+    /**
+     * @brief 使窗口预览失效（窗口关闭时调用）
+     * @param window_id 窗口ID
+     */
+    void invalidate(const std::string& window_id);
+
+    /**
+     * @brief 设置内存预算
+     * @param bytes 内存预算（字节）
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * @brief 获取当前缓存占用
+     * @return 占用字节数
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Desktop
+} // namespace CloudFlow
+
+#endif // CLOUDFLOW_WINDOW_PREVIEW_H
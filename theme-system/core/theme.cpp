@@ -4,6 +4,7 @@
  */
 
 #include "theme.h"
+#include "metrics.h"
 #include <json/json.h>
 #include <fstream>
 #include <sstream>
@@ -19,6 +20,10 @@ namespace Desktop {
 class ThemeManager::Impl {
 public:
     Impl() : current_theme_("默认主题"), theme_apply_count_(0), last_apply_time_(std::chrono::system_clock::now()) {
+        auto& metrics = Common::MetricsRegistry::global();
+        apply_count_metric_ = metrics.counter("theme_apply_total", "主题应用次数");
+        apply_duration_metric_ = metrics.histogram("theme_apply_duration_seconds", "主题应用耗时（秒）");
+        
         loadDefaultThemes();
     }
     
@@ -117,6 +122,7 @@ public:
         }
         
         // 应用主题设置
+        auto apply_start = std::chrono::steady_clock::now();
         renderer_->applyColorPalette(theme.palette);
         renderer_->applyFontSettings(theme.font);
         renderer_->applyIconTheme(theme.icons);
@@ -126,6 +132,8 @@ public:
         // 更新当前主题
         current_theme_ = theme_name;
         theme_apply_count_++;
+        apply_count_metric_->increment();
+        apply_duration_metric_->observeDuration(std::chrono::steady_clock::now() - apply_start);
         last_apply_time_ = std::chrono::system_clock::now();
         
         // 触发主题改变事件
@@ -765,6 +773,10 @@ private:
     mutable std::mutex mutex_;
     std::string last_error_;
     int theme_apply_count_;
+    
+    // 运行指标（进程内所有主题管理器的合计）
+    std::shared_ptr<Common::Counter> apply_count_metric_;
+    std::shared_ptr<Common::Histogram> apply_duration_metric_;
     std::chrono::system_clock::time_point last_apply_time_;
 };
 
@@ -150,6 +150,7 @@ public:
         
         WindowState old_state = state_;
         state_ = WindowState::Maximized;
+        visible_ = true;
         
         // 保存原始大小
         if (old_state == WindowState::Normal) {
@@ -201,8 +202,11 @@ public:
         
         if (fullscreen) {
             state_ = WindowState::Fullscreen;
-            // 保存原始大小
-            normal_geometry_ = geometry_;
+            visible_ = true;
+            // 保存原始大小（最小化或最大化时已保存过）
+            if (old_state == WindowState::Normal) {
+                normal_geometry_ = geometry_;
+            }
             // 设置全屏尺寸
             geometry_.width = 1920;
             geometry_.height = 1080;
@@ -32,6 +32,7 @@ enum class WindowEventType {
     Maximized,      ///< 窗口最大化
     Restored,       ///< 窗口恢复
     StateChanged,   ///< 窗口状态改变
+    StatesChanged,  ///< 多个窗口状态批量改变
     MouseEnter,     ///< 鼠标进入窗口
     MouseLeave,     ///< 鼠标离开窗口
     MouseMove,      ///< 鼠标移动
@@ -19,7 +19,7 @@ namespace UI {
 // 窗口管理器实现类
 class WindowManager::Impl {
 public:
-    Impl() : next_window_id_(1), focused_window_id_(-1) {}
+    Impl() : next_window_id_(1), focused_window_id_(-1), batch_depth_(0) {}
     
     ~Impl() {
         // 清理所有窗口
@@ -157,6 +157,41 @@ public:
         return it->second->restore();
     }
     
+    std::vector<WindowStateChange> setWindowStates(const std::vector<WindowStateChange>& changes) {
+        std::vector<WindowStateChange> previous;
+        previous.reserve(changes.size());
+        
+        // 批量期间屏蔽各窗口自身的状态改变事件
+        batch_depth_++;
+        for (const auto& change : changes) {
+            auto it = windows_.find(change.window_id);
+            if (it == windows_.end()) {
+                continue;
+            }
+            
+            WindowState old_state = it->second->getState();
+            if (old_state == change.state) {
+                continue;
+            }
+            
+            if (applyWindowState(*it->second, change.state)) {
+                previous.push_back({change.window_id, old_state});
+            }
+        }
+        batch_depth_--;
+        
+        if (!previous.empty()) {
+            WindowEvent event;
+            event.type = WindowEventType::StatesChanged;
+            event.window_id = -1;
+            event.timestamp = EventUtils::getCurrentTimestamp();
+            event.data.int_value = static_cast<int>(previous.size());
+            notifyEventCallback(event);
+        }
+        
+        return previous;
+    }
+    
     bool moveWindow(int window_id, int x, int y) {
         auto it = windows_.find(window_id);
         if (it == windows_.end()) {
@@ -310,9 +345,27 @@ public:
 
 private:
     void handleWindowEvent(const WindowEvent& event) {
+        if (batch_depth_ > 0 && event.type == WindowEventType::StateChanged) {
+            return; // 批量结束后统一通知
+        }
         notifyEventCallback(event);
     }
     
+    bool applyWindowState(Window& window, WindowState state) {
+        switch (state) {
+            case WindowState::Normal:
+                return window.restore();
+            case WindowState::Minimized:
+                return window.minimize();
+            case WindowState::Maximized:
+                return window.maximize();
+            case WindowState::Fullscreen:
+                return window.setFullscreen(true);
+            default:
+                return false;
+        }
+    }
+    
     void notifyEventCallback(const WindowEvent& event) {
         if (event_callback_) {
             event_callback_(event);
@@ -337,6 +390,7 @@ private:
     std::unordered_map<int, std::unique_ptr<Window>> windows_;
     int next_window_id_;
     int focused_window_id_;
+    int batch_depth_;
     std::function<void(const WindowEvent&)> event_callback_;
 };
 
@@ -373,6 +427,10 @@ bool WindowManager::restoreWindow(int window_id) {
     return impl_->restoreWindow(window_id);
 }
 
+std::vector<WindowStateChange> WindowManager::setWindowStates(const std::vector<WindowStateChange>& changes) {
+    return impl_->setWindowStates(changes);
+}
+
 bool WindowManager::moveWindow(int window_id, int x, int y) {
     return impl_->moveWindow(window_id, x, y);
 }
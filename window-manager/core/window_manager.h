@@ -60,6 +60,14 @@ struct WindowGeometry {
     int max_height; ///< 最大高度
 };
 
+/**
+ * @brief 窗口状态变更项
+ */
+struct WindowStateChange {
+    int window_id;      ///< 窗口ID
+    WindowState state;  ///< 目标状态
+};
+
 /**
  * @brief 窗口管理器类
  * 
@@ -132,6 +140,16 @@ public:
      */
     bool restoreWindow(int window_id);
     
+    /**
+     * @brief 批量设置窗口状态
+     * 
+     * 批量期间各窗口不单独发送状态改变事件，完成后只发送一次StatesChanged事件
+     * （data.int_value为实际改变的窗口数）。不支持Hidden状态
+     * @param changes 状态变更列表
+     * @return 实际改变的窗口及其原状态，再次传入即可撤销本次变更
+     */
+    std::vector<WindowStateChange> setWindowStates(const std::vector<WindowStateChange>& changes);
+    
     /**
      * @brief 移动窗口
      * @param window_id 窗口ID